@@ -4,9 +4,11 @@
 #include <csignal>
 #include <iostream>
 #include <chrono>
-#include <yaml-cpp/yaml.h>
+#include <sstream>
 #include "vssdag/can/can_source.h"
+#include "vssdag/mapping_loader.h"
 #include "vssdag/signal_processor.h"
+#include "vssdag/pipeline.h"
 #include "vssdag/vss_formatter.h"
 
 std::atomic<bool> g_running(true);
@@ -19,8 +21,9 @@ void signal_handler(int signal) {
 }
 
 void print_usage(const char* program_name) {
-    std::cout << "Usage: " << program_name << " <dbc_file> <mapping_yaml_file> <can_interface>\n";
+    std::cout << "Usage: " << program_name << " <dbc_file> <mapping_file> <can_interface>\n";
     std::cout << "Example: " << program_name << " vehicle.dbc mappings.yaml can0\n";
+    std::cout << "The mapping file may also be an artifact produced by vssdag-compile.\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -36,7 +39,7 @@ int main(int argc, char* argv[]) {
     }
     
     const std::string dbc_file = argv[1];
-    const std::string yaml_file = argv[2];
+    const std::string mapping_file = argv[2];
     const std::string can_interface = argv[3];
     
     // Set up signal handler
@@ -45,114 +48,64 @@ int main(int argc, char* argv[]) {
     
     LOG(INFO) << "Starting CAN to VSS DAG converter";
     LOG(INFO) << "DBC file: " << dbc_file;
-    LOG(INFO) << "Mapping file: " << yaml_file;
+    LOG(INFO) << "Mapping file: " << mapping_file;
     LOG(INFO) << "CAN interface: " << can_interface;
     
-    // Parse YAML directly for DAG
-    YAML::Node root = YAML::LoadFile(yaml_file);
-    if (!root["mappings"]) {
-        LOG(ERROR) << "No 'mappings' section found in YAML file";
+    // Mapping file: YAML, or an artifact produced by vssdag-compile
+    MappingConfig config;
+    bool compiled = is_compiled_mapping_file(mapping_file);
+    if (compiled ? !load_compiled_mappings(mapping_file, config)
+                 : !load_mapping_file(mapping_file, config)) {
+        LOG(ERROR) << "Failed to load mapping file";
         return 1;
     }
     
-    std::unordered_map<std::string, SignalMapping> dag_mappings;
-    
-    const YAML::Node& yaml_mappings = root["mappings"];
-    for (const auto& mapping_node : yaml_mappings) {
-        if (!mapping_node["signal"]) {
-            continue;
-        }
-        
-        std::string signal_name = mapping_node["signal"].as<std::string>();
-        
-        SignalMapping mapping;
-        
-        // Parse source information if present
-        if (mapping_node["source"]) {
-            const auto& source_node = mapping_node["source"];
-            mapping.source.type = source_node["type"].as<std::string>();
-            mapping.source.name = source_node["name"].as<std::string>();
-        }
-        // Parse datatype - no default, must be specified
-        if (mapping_node["datatype"]) {
-            std::string datatype_str = mapping_node["datatype"].as<std::string>();
-            auto datatype_opt = value_type_from_string(datatype_str);
-            if (datatype_opt.has_value()) {
-                mapping.datatype = *datatype_opt;
-            } else {
-                LOG(WARNING) << "Unknown datatype '" << datatype_str << "' for signal " << signal_name;
-                mapping.datatype = ValueType::UNSPECIFIED;
-            }
-        } else {
-            LOG(WARNING) << "No datatype specified for signal " << signal_name << ", using UNSPECIFIED";
-            mapping.datatype = ValueType::UNSPECIFIED;
-        }
-        mapping.interval_ms = mapping_node["interval_ms"].as<int>(0);
-
-        // Check if this is a struct type
-        if (mapping.datatype == ValueType::STRUCT) {
-            mapping.is_struct = true;
-            if (mapping_node["struct_type"]) {
-                mapping.struct_type = mapping_node["struct_type"].as<std::string>();
-            }
-        }
-        
-        // DAG support
-        if (mapping_node["depends_on"]) {
-            for (const auto& dep : mapping_node["depends_on"]) {
-                mapping.depends_on.push_back(dep.as<std::string>());
-            }
-        }
-        
-        // Parse transform (simplified for now)
-        if (mapping_node["transform"]) {
-            const YAML::Node& transform = mapping_node["transform"];
-            if (transform["code"]) {
-                mapping.transform = CodeTransform{transform["code"].as<std::string>()};
-            } else if (transform["math"]) {
-                // Keep backward compatibility
-                mapping.transform = CodeTransform{transform["math"].as<std::string>()};
-            } else if (transform["mapping"]) {
-                ValueMapping value_map;
-                for (const auto& item : transform["mapping"]) {
-                    std::string from = item["from"].as<std::string>();
-                    std::string to = item["to"].as<std::string>();
-                    value_map.mappings[from] = to;
-                }
-                mapping.transform = value_map;
-            } else {
-                mapping.transform = DirectMapping{};
-            }
-        } else {
-            mapping.transform = DirectMapping{};
-        }
-        
-        // Parse update trigger
-        if (mapping_node["update_trigger"]) {
-            std::string trigger = mapping_node["update_trigger"].as<std::string>();
-            if (trigger == "periodic") {
-                mapping.update_trigger = UpdateTrigger::PERIODIC;
-            } else if (trigger == "both") {
-                mapping.update_trigger = UpdateTrigger::BOTH;
-            } else {
-                mapping.update_trigger = UpdateTrigger::ON_DEPENDENCY;
-            }
-        }
-        
-        // Store mapping
-        dag_mappings[signal_name] = mapping;
-    }
+    // Create CAN signal source (keeps only the DBC signal names it needs)
+    auto can_source = std::make_unique<vssdag::CANSignalSource>(
+        can_interface, dbc_file, config.mappings);
     
-    // Initialize DAG processor
+    // Initialize DAG processor; it takes over the mapping set. A compiled
+    // artifact's plan supplies the DAG order, Lua bytecode and decode plan.
     SignalProcessorDAG processor;
-    if (!processor.initialize(dag_mappings)) {
+    bool initialized = false;
+    if (config.plan) {
+        can_source->set_decode_plan(*config.plan);
+        initialized = processor.initialize(std::move(config.mappings), *config.plan);
+    } else {
+        initialized = processor.initialize(std::move(config.mappings));
+    }
+    if (!initialized) {
         LOG(ERROR) << "Failed to initialize DAG processor";
         return 1;
     }
+    auto footprint = processor.memory_footprint();
+    LOG(INFO) << "Memory footprint: " << footprint.total() / 1024 << " KiB (mappings "
+              << footprint.mappings / 1024 << ", DAG " << footprint.dag / 1024 << ", Lua "
+              << footprint.lua / 1024 << ", runtime " << footprint.runtime / 1024 << ")";
+    processor.set_execution_budget(config.execution_budget);
+    processor.set_batch_deadline(config.batch_deadline);
+    for (const auto& group : config.resample_groups) {
+        if (!processor.add_resample_group(group)) {
+            return 1;
+        }
+    }
+    processor.set_resample_handler([](const ResampleGroup& group,
+                                      std::chrono::steady_clock::time_point,
+                                      const std::vector<double>& row) {
+        if (VLOG_IS_ON(1)) {
+            std::ostringstream line;
+            for (size_t i = 0; i < row.size(); ++i) {
+                line << (i ? ", " : "") << group.columns[i].signal << "=" << row[i];
+            }
+            VLOG(1) << "Resampled " << group.name << ": " << line.str();
+        }
+    });
     
-    // Create CAN signal source
-    auto can_source = std::make_unique<vssdag::CANSignalSource>(
-        can_interface, dbc_file, dag_mappings);
+    // Optional staged pipeline: decode, evaluate and output on separate threads
+    bool use_pipeline = config.pipeline.has_value();
+    if (use_pipeline) {
+        can_source->enable_poll_decode(config.pipeline_frame_capacity);
+    }
     
     if (!can_source->initialize()) {
         LOG(ERROR) << "Failed to initialize CAN signal source";
@@ -165,8 +118,24 @@ int main(int argc, char* argv[]) {
         LOG(INFO) << "  - " << signal;
     }
     
+    if (use_pipeline) {
+        const PipelineConfig& pipeline_config = *config.pipeline;
+        Pipeline pipeline(*can_source, processor, &VSSFormatter::log_vss_signal, pipeline_config);
+        pipeline.start();
+        while (g_running) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        pipeline.stop();
+        
+        auto stats = pipeline.stats();
+        LOG(INFO) << "Pipeline processed " << stats.updates << " updates in " << stats.batches
+                  << " batches, " << stats.outputs << " outputs (" << stats.outputs_dropped
+                  << " dropped), " << can_source->dropped_frames() << " CAN frames dropped";
+        can_source->stop();
+        return 0;
+    }
+    
     // Main processing loop - poll signal sources
-    auto last_periodic_check = std::chrono::steady_clock::now();
     const auto processing_interval = std::chrono::milliseconds(10);  // Process every 10ms
     
     while (g_running) {
@@ -185,13 +154,12 @@ int main(int argc, char* argv[]) {
             }
         }
         
-        // Check for periodic processing
+        // Run periodic nodes and scheduled wakeups (e.g. delayed()) when due
         auto now = std::chrono::steady_clock::now();
-        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - last_periodic_check).count();
+        auto next_wakeup = processor.next_wakeup();
         
-        if (elapsed_ms >= 50) {  // Check every 50ms
-            VLOG(3) << "Periodic check triggered";
+        if (signal_updates.empty() && next_wakeup && *next_wakeup <= now) {
+            VLOG(3) << "Scheduled wakeup triggered";
             // Process with empty signals to trigger periodic updates
             auto vss_signals = processor.process_signal_updates({});
             
@@ -202,8 +170,6 @@ int main(int argc, char* argv[]) {
             for (const auto& vss : vss_signals) {
                 VSSFormatter::log_vss_signal(vss);
             }
-            
-            last_periodic_check = now;
         }
         
         // Sleep for remainder of interval if we finished early
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace vssdag {
+
+// Append-only encoder for the binary artifact formats (native byte order;
+// artifacts are meant for the machine class they were written on)
+class BinaryWriter {
+public:
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void put(const std::string& text) {
+        put<uint32_t>(static_cast<uint32_t>(text.size()));
+        buffer_.append(text);
+    }
+
+    void put(const std::vector<double>& values) {
+        put<uint32_t>(static_cast<uint32_t>(values.size()));
+        for (double v : values) {
+            put<double>(v);
+        }
+    }
+
+    const std::string& data() const { return buffer_; }
+
+private:
+    std::string buffer_;
+};
+
+// Bounds-checked decoder; any overrun leaves ok() false
+class BinaryReader {
+public:
+    BinaryReader(const char* data, size_t size) : pos_(data), end_(data + size) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (static_cast<size_t>(end_ - pos_) < sizeof(T)) {
+            ok_ = false;
+            pos_ = end_;
+            return value;
+        }
+        std::memcpy(&value, pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    std::string get_string() {
+        auto size = get<uint32_t>();
+        if (static_cast<size_t>(end_ - pos_) < size) {
+            ok_ = false;
+            pos_ = end_;
+            return {};
+        }
+        std::string text(pos_, size);
+        pos_ += size;
+        return text;
+    }
+
+    std::vector<double> get_doubles() {
+        auto count = get<uint32_t>();
+        if (remaining() / sizeof(double) < count) {
+            fail();
+            return {};
+        }
+        std::vector<double> values(count);
+        for (double& v : values) {
+            v = get<double>();
+        }
+        return values;
+    }
+
+    // Element count, capped by the bytes left so corrupt input cannot over-allocate
+    size_t get_count() { return std::min<size_t>(get<uint32_t>(), remaining()); }
+
+    bool ok() const { return ok_; }
+    size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+    // Mark the input malformed, e.g. on a tag the caller does not know
+    void fail() {
+        ok_ = false;
+        pos_ = end_;
+    }
+
+private:
+    const char* pos_;
+    const char* end_;
+    bool ok_ = true;
+};
+
+} // namespace vssdag
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <thread>
 #include <atomic>
@@ -10,7 +11,9 @@
 #include "vssdag/signal_source.h"
 #include "vssdag/can/can_reader.h"
 #include "vssdag/can/dbc_parser.h"
+#include "vssdag/compiled_plan.h"
 #include "vssdag/mapping_types.h"
+#include "vssdag/spsc_ring.h"
 
 namespace vssdag {
 
@@ -19,45 +22,75 @@ public:
     CANSignalSource(const std::string& interface_name, 
                     const std::string& dbc_file_path,
                     const std::unordered_map<std::string, SignalMapping>& mappings);
+    // Read frames through reader instead of a SocketCANReader
+    CANSignalSource(const std::string& interface_name,
+                    const std::string& dbc_file_path,
+                    const std::unordered_map<std::string, SignalMapping>& mappings,
+                    std::unique_ptr<CANReader> reader);
     ~CANSignalSource() override;
     
     bool initialize() override;
     
     std::vector<SignalUpdate> poll() override;
+    void poll_into(std::vector<SignalUpdate>& updates) override;
     
     std::vector<std::string> get_exported_signals() const override;
     
     // Stop the reader thread
     void stop();
+
+    // Decode on the thread calling poll() instead of the reader thread (call
+    // before initialize()). The reader then only filters frames by ID and
+    // queues them in a bounded ring, so it keeps up with the socket even when
+    // decoding or evaluation is slow; frames are dropped when the ring is full.
+    void enable_poll_decode(size_t frame_capacity = 4096);
+
+    // Take the CAN IDs to monitor from a compiled plan's decode plan instead
+    // of looking every DBC signal up in the DBC (call before initialize())
+    void set_decode_plan(const CompiledPlan& plan) { decode_plan_ = plan.decode_plan; }
+
+    // Frames dropped because the poll-decode ring was full
+    uint64_t dropped_frames() const { return dropped_frames_.load(std::memory_order_relaxed); }
     
 private:
     std::string interface_name_;
     std::string dbc_file_path_;
     
-    std::unique_ptr<SocketCANReader> can_reader_;
+    std::unique_ptr<CANReader> can_reader_;
     std::unique_ptr<DBCParser> dbc_parser_;
     
     // Lock-free queue for signal updates
     moodycamel::ConcurrentQueue<SignalUpdate> signal_queue_;
     
-    // Mappings from YAML
-    std::unordered_map<std::string, SignalMapping> mappings_;
-    
     // DBC signal names we need (extracted from mappings where source.type == "dbc")
-    std::vector<std::string> dbc_signal_names_;
+    std::vector<Symbol> dbc_signal_names_;
     
-    // Map from DBC signal name to our signal name
-    std::unordered_map<std::string, std::string> dbc_to_signal_name_;
+    // Map from DBC signal name to our (interned) signal name. Keys view the
+    // interned DBC names, so decoded string_view names are looked up directly.
+    std::unordered_map<std::string_view, Symbol> dbc_to_signal_name_;
     
-    // CAN message IDs we need to process (derived from dbc_signal_names via DBC)
+    // CAN message IDs we need to process (derived from dbc_signal_names via
+    // the decode plan or the DBC)
     std::unordered_set<uint32_t> required_can_ids_;
+    std::unordered_map<uint32_t, std::vector<std::string>> decode_plan_;
     
     // Reader thread
     std::unique_ptr<std::thread> reader_thread_;
     std::atomic<bool> running_{false};
     
+    // Raw frames awaiting decode in poll() (poll-decode mode only)
+    std::unique_ptr<SpscRing<CANFrame>> frame_ring_;
+    CANFrame ring_frame_{};  // poll_into() pop target; its buffer goes back to the ring
+    std::atomic<uint64_t> dropped_frames_{0};
+    std::vector<SignalUpdate> reader_updates_;  // Reader thread scratch buffer
+    std::vector<DBCSignalUpdate> dbc_updates_;  // decode_frame() scratch buffer (one thread at a time)
+    
     // Callback for CAN frames
     void handle_can_frame(const CANFrame& frame);
+
+    // Decode the signals we export from a frame
+    void decode_frame(const CANFrame& frame, std::chrono::steady_clock::time_point timestamp,
+                      std::vector<SignalUpdate>& updates);
 };
 
 } // namespace vssdag
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -25,21 +26,25 @@ public:
     
     // Decode message and return as vector of signal updates
     std::vector<DBCSignalUpdate> decode_message_as_updates(uint32_t can_id, const uint8_t* data, size_t length) const;
+
+    // Same, appending to updates (reuse it to decode without allocating)
+    void decode_message_as_updates(uint32_t can_id, const uint8_t* data, size_t length,
+                                   std::vector<DBCSignalUpdate>& updates) const;
     
     bool has_message(uint32_t can_id) const;
     std::vector<std::string> get_signal_names(uint32_t can_id) const;
     
     // Get enum mappings for a signal (returns empty map if no enums defined)
-    EnumMap get_signal_enums(const std::string& signal_name) const;
+    EnumMap get_signal_enums(std::string_view signal_name) const;
     
     // Get all signals with their enum mappings
     std::unordered_map<std::string, EnumMap> get_all_signal_enums() const;
     
     // Get the CAN message ID that contains a specific signal
-    std::optional<uint32_t> get_message_id_for_signal(const std::string& signal_name) const;
+    std::optional<uint32_t> get_message_id_for_signal(std::string_view signal_name) const;
     
     // Convert an enum value to its string representation (returns empty optional if not found)
-    std::optional<std::string> get_enum_string(const std::string& signal_name, int64_t value) const;
+    std::optional<std::string> get_enum_string(std::string_view signal_name, int64_t value) const;
 
 private:
     std::string dbc_file_;
@@ -58,6 +63,7 @@ private:
         bool can_use_na_pattern;        // Is NA pattern outside valid range?
         double min_physical;            // Min valid physical value from DBC
         double max_physical;            // Max valid physical value from DBC
+        uint32_t message_id;            // Containing message, extended flag stripped
         
         // Quick inline status check
         vss::types::SignalQuality check_status(uint64_t raw_value, double physical_value) const {
@@ -77,8 +83,9 @@ private:
         }
     };
     
-    // Single cache for all signal information
-    std::unordered_map<std::string, SignalInfo> signal_info_;
+    // Single cache for all signal information, keyed by views of the signal
+    // names owned by network_ so lookups by string_view need no allocation
+    std::unordered_map<std::string_view, SignalInfo> signal_info_;
 };
 
 } // namespace vssdag
\ No newline at end of file
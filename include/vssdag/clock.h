@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+namespace vssdag {
+
+// Time source used by the processing engine.
+//
+// Everything that measures intervals (periodic triggers, output throttling,
+// Lua helpers such as rate_limit() or delayed()) and everything that stamps
+// outputs goes through this interface, so replays can run on simulated time.
+class IClock {
+public:
+    virtual ~IClock() = default;
+
+    // Monotonic time used for intervals and time-based transforms
+    virtual std::chrono::steady_clock::time_point now() const = 0;
+
+    // Wall-clock time used for output timestamps
+    virtual std::chrono::system_clock::time_point wall_time() const = 0;
+
+    // Called with the timestamp of every input update before it is processed.
+    // Real-time clocks ignore it; simulated clocks advance to it.
+    virtual void observe_input_time(std::chrono::steady_clock::time_point /*timestamp*/) {}
+};
+
+// Default clock backed by std::chrono::steady_clock / system_clock
+class RealTimeClock : public IClock {
+public:
+    std::chrono::steady_clock::time_point now() const override;
+    std::chrono::system_clock::time_point wall_time() const override;
+};
+
+// Clock driven purely by input timestamps (or explicit advance calls).
+// Time never moves backwards, so out-of-order inputs do not rewind it.
+// Use for max-speed replay and deterministic tests.
+class SimulatedClock : public IClock {
+public:
+    // wall_origin is the wall-clock time reported when now() is at the
+    // steady_clock epoch; defaults to the system_clock epoch
+    explicit SimulatedClock(std::chrono::system_clock::time_point wall_origin = {});
+
+    std::chrono::steady_clock::time_point now() const override { return now_; }
+    std::chrono::system_clock::time_point wall_time() const override;
+    void observe_input_time(std::chrono::steady_clock::time_point timestamp) override;
+
+    // Move time forward (no-op if timestamp is in the past)
+    void advance_to(std::chrono::steady_clock::time_point timestamp);
+    void advance_by(std::chrono::steady_clock::duration delta);
+
+private:
+    std::chrono::steady_clock::time_point now_{};
+    std::chrono::system_clock::time_point wall_origin_;
+};
+
+// Shared default instance used when no clock is injected
+std::shared_ptr<IClock> default_clock();
+
+} // namespace vssdag
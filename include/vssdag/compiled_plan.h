@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vssdag {
+
+// Startup work done ahead of time by vssdag-compile and carried by compiled
+// artifacts: the DAG orders, the CAN decode plan, DBC enum tables and the Lua
+// bytecode of the generated transforms
+struct CompiledPlan {
+    // SignalDAG::get_processing_order() as signal names, and
+    // get_priority_order() as indices into it
+    std::vector<std::string> processing_order;
+    std::vector<uint32_t> priority_order;
+
+    // CAN message ID -> DBC signals decoded from it
+    std::unordered_map<uint32_t, std::vector<std::string>> decode_plan;
+
+    // Signal -> value descriptions of its DBC source (label -> raw value)
+    std::unordered_map<std::string, std::unordered_map<std::string, int64_t>> enum_tables;
+
+    // lua_dump() of the chunk generated for each signal, and for each
+    // template's shared factory
+    std::unordered_map<std::string, std::string> transform_chunks;
+    std::unordered_map<std::string, std::string> template_chunks;
+};
+
+} // namespace vssdag
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include "vssdag/mapping_types.h"
+#include "vssdag/vss_types.h"
+#include "vssdag/window_aggregator.h"
+
+namespace vssdag {
+
+// Time alignment of the dependencies of one derived signal (JoinPolicy).
+//
+// Keeps a short timestamped history per dependency and, on every update,
+// decides whether a new aligned sample set is available. The node is
+// evaluated once per aligned set, with deps taken from aligned().
+class DependencyJoin {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    struct Sample {
+        time_point timestamp;
+        Value value;
+        SignalQuality quality = SignalQuality::UNKNOWN;
+    };
+
+    // Samples kept per dependency
+    static constexpr size_t kHistorySize = 8;
+
+    DependencyJoin(JoinPolicy policy, std::chrono::milliseconds tolerance, size_t dependency_count);
+
+    // Record a new sample of dependency (index into depends_on)
+    void record(size_t dependency, time_point timestamp, const Value& value, SignalQuality quality);
+
+    // Form the next aligned set if one is available; true if the node should evaluate
+    bool align();
+
+    // Aligned sample of dependency and the time of the set (valid after align())
+    const Sample& aligned(size_t dependency) const { return aligned_[dependency]; }
+    time_point aligned_time() const { return aligned_time_; }
+
+private:
+    JoinPolicy policy_;
+    std::chrono::steady_clock::duration tolerance_;
+
+    std::vector<RingBuffer<Sample>> history_;
+    std::vector<time_point> consumed_;  // WAIT_ALL: newest sample used per dependency
+    std::vector<Sample> aligned_;
+    std::vector<const Sample*> chosen_;  // WAIT_ALL scratch, sized once
+    time_point aligned_time_ = time_point::min();
+
+    bool align_wait_all();
+    bool align_interpolate();
+
+    // Sample of dependency at t: interpolated between neighbours when numeric
+    Sample sample_at(size_t dependency, time_point t) const;
+};
+
+} // namespace vssdag
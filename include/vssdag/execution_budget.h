@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace vssdag {
+
+// Lua execution budgets in VM instructions (0 = unlimited). Counting uses a
+// lua_sethook() count hook that is only installed while a budget applies.
+struct ExecutionBudget {
+    uint64_t node_instructions = 0;   // Default for nodes without SignalMapping::max_instructions
+    uint64_t batch_instructions = 0;  // Shared by all nodes of one process_signal_updates() call
+};
+
+// Counters for budgeted evaluations and deferred work. Instruction counts have the granularity
+// of the hook interval (ExecutionBudget-limited evaluations only).
+struct ExecutionMetrics {
+    uint64_t evaluations = 0;            // Evaluations run under a budget
+    uint64_t instructions = 0;           // Instructions counted across them
+    uint64_t node_budget_exceeded = 0;   // Evaluations aborted by the node budget
+    uint64_t batch_budget_exceeded = 0;  // Evaluations aborted or skipped by the batch budget
+    std::unordered_map<std::string, uint64_t> exceeded_by_signal;
+    uint64_t deferred_nodes = 0;         // Pending nodes deferred by the batch deadline
+};
+
+} // namespace vssdag
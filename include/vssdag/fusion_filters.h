@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace vssdag {
+
+// Linear Kalman filter with a fixed-size state (no heap allocation).
+//
+// Measurements are scalar and applied sequentially, so several sensors
+// observing the same state (e.g. wheel speed and GNSS speed) need no matrix
+// inversion.
+template <size_t N>
+class KalmanFilter {
+public:
+    using Vector = std::array<double, N>;
+    using Matrix = std::array<std::array<double, N>, N>;
+
+    bool initialized() const { return initialized_; }
+
+    // Set the state with a diagonal covariance
+    void initialize(const Vector& x, const Vector& variance) {
+        x_ = x;
+        P_ = Matrix{};
+        for (size_t i = 0; i < N; ++i) {
+            P_[i][i] = variance[i];
+        }
+        initialized_ = true;
+    }
+
+    // x = F x + u, P = F P F' + Q
+    void predict(const Matrix& F, const Matrix& Q, const Vector& u = Vector{}) {
+        Vector x{};
+        Matrix FP{};
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t k = 0; k < N; ++k) {
+                x[i] += F[i][k] * x_[k];
+                for (size_t j = 0; j < N; ++j) {
+                    FP[i][j] += F[i][k] * P_[k][j];
+                }
+            }
+            x[i] += u[i];
+        }
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = 0; j < N; ++j) {
+                double sum = Q[i][j];
+                for (size_t k = 0; k < N; ++k) {
+                    sum += FP[i][k] * F[j][k];
+                }
+                P_[i][j] = sum;
+            }
+        }
+        x_ = x;
+    }
+
+    // Scalar measurement z = h'x + v with variance r
+    void update(const Vector& h, double z, double r) {
+        Vector Ph{};
+        double innovation = z;
+        for (size_t i = 0; i < N; ++i) {
+            innovation -= h[i] * x_[i];
+            for (size_t j = 0; j < N; ++j) {
+                Ph[i] += P_[i][j] * h[j];
+            }
+        }
+        double s = r;
+        for (size_t i = 0; i < N; ++i) {
+            s += h[i] * Ph[i];
+        }
+        if (s <= 0.0) {
+            return;
+        }
+
+        // K = P h / s; x += K y; P -= K (P h)'
+        for (size_t i = 0; i < N; ++i) {
+            x_[i] += Ph[i] / s * innovation;
+        }
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = 0; j < N; ++j) {
+                P_[i][j] -= Ph[i] * Ph[j] / s;
+            }
+        }
+    }
+
+    const Vector& state() const { return x_; }
+    const Matrix& covariance() const { return P_; }
+
+private:
+    Vector x_{};
+    Matrix P_{};
+    bool initialized_ = false;
+};
+
+// Process models for KalmanFilter: transition F and noise Q over dt seconds,
+// q being the spectral density of the unmodelled highest derivative.
+
+// Random walk (scalar)
+inline void random_walk_model(double dt, double q,
+                              KalmanFilter<1>::Matrix& F, KalmanFilter<1>::Matrix& Q) {
+    F = {{{1.0}}};
+    Q = {{{q * dt}}};
+}
+
+// Constant velocity: state [value, rate]
+inline void constant_velocity_model(double dt, double q,
+                                    KalmanFilter<2>::Matrix& F, KalmanFilter<2>::Matrix& Q) {
+    double dt2 = dt * dt;
+    double dt3 = dt2 * dt;
+    F = {{{1.0, dt},
+          {0.0, 1.0}}};
+    Q = {{{q * dt3 / 3, q * dt2 / 2},
+          {q * dt2 / 2, q * dt}}};
+}
+
+// Constant acceleration: state [value, rate, acceleration]
+inline void constant_acceleration_model(double dt, double q,
+                                        KalmanFilter<3>::Matrix& F, KalmanFilter<3>::Matrix& Q) {
+    double dt2 = dt * dt;
+    double dt3 = dt2 * dt;
+    double dt4 = dt3 * dt;
+    double dt5 = dt4 * dt;
+    F = {{{1.0, dt, dt2 / 2},
+          {0.0, 1.0, dt},
+          {0.0, 0.0, 1.0}}};
+    Q = {{{q * dt5 / 20, q * dt4 / 8, q * dt3 / 6},
+          {q * dt4 / 8, q * dt3 / 3, q * dt2 / 2},
+          {q * dt3 / 6, q * dt2 / 2, q * dt}}};
+}
+
+// Complementary filter: integrates a fast rate signal and pulls the estimate
+// towards a slow absolute measurement with time constant tau (seconds)
+class ComplementaryFilter {
+public:
+    bool initialized() const { return initialized_; }
+
+    void reset(double value) {
+        value_ = value;
+        initialized_ = true;
+    }
+
+    double update(double dt, double rate, double measurement, double tau) {
+        if (!initialized_) {
+            reset(measurement);
+            return value_;
+        }
+        double alpha = tau > 0.0 ? tau / (tau + dt) : 0.0;
+        value_ = alpha * (value_ + rate * dt) + (1.0 - alpha) * measurement;
+        return value_;
+    }
+
+    // Propagate with the rate only (measurement unavailable)
+    double predict(double dt, double rate) {
+        value_ += rate * dt;
+        return value_;
+    }
+
+    double value() const { return value_; }
+
+private:
+    double value_ = 0.0;
+    bool initialized_ = false;
+};
+
+// Filter with the input time of its previous step
+template <typename Filter>
+struct TimedFilter {
+    Filter filter;
+    std::chrono::steady_clock::time_point last_time{};
+    bool has_time = false;
+
+    // Seconds since the previous step (0 for the first one)
+    double step(std::chrono::steady_clock::time_point now) {
+        double dt = has_time ? std::chrono::duration<double>(now - last_time).count() : 0.0;
+        last_time = now;
+        has_time = true;
+        return dt > 0.0 ? dt : 0.0;
+    }
+};
+
+// Filter state kept per node by SignalProcessorDAG, one slot per operator
+struct FusionState {
+    TimedFilter<KalmanFilter<1>> scalar;        // kalman()
+    TimedFilter<KalmanFilter<2>> velocity;      // kalman_cv()
+    TimedFilter<KalmanFilter<3>> acceleration;  // kalman_ca()
+    TimedFilter<KalmanFilter<1>> fused;         // kalman_fuse()
+    TimedFilter<ComplementaryFilter> complementary;
+};
+
+} // namespace vssdag
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace vssdag {
+
+// Two-threshold switch with debounce, for event outputs such as
+// overtemperature or harsh braking.
+//
+// With on >= off the state turns on at value >= on and off at value < off.
+// With on < off the comparison is inverted (turns on at value <= on and off
+// at value > off), for low-side events such as low battery. A transition is
+// only taken once its condition has held for the debounce time.
+class Hysteresis {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    using duration = std::chrono::steady_clock::duration;
+
+    struct Config {
+        double on = 0.0;
+        double off = 0.0;
+        duration on_debounce{};
+        duration off_debounce{};
+    };
+
+    struct Result {
+        bool state = false;
+        bool changed = false;                // State changed (or first update)
+        std::optional<time_point> wake_at;   // When the pending transition matures
+    };
+
+    // Update with a new value (nullopt for invalid input, which holds the
+    // state and cancels any pending transition)
+    Result update(time_point now, std::optional<double> value, const Config& config);
+
+    bool state() const { return state_; }
+
+private:
+    bool initialized_ = false;
+    bool state_ = false;
+    bool pending_ = false;
+    time_point pending_since_;
+};
+
+} // namespace vssdag
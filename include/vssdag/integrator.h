@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+
+namespace vssdag {
+
+// Trapezoidal integrator over timestamped samples (odometers, energy counters).
+//
+// The running total uses compensated (Kahan) summation so that long-running
+// accumulators keep their precision. A gap longer than max_gap between two
+// samples, or an explicit break_chain() (invalid input), is not integrated:
+// the next sample only re-anchors the integrator.
+class Integrator {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    using duration = std::chrono::steady_clock::duration;
+
+    static constexpr duration kDefaultMaxGap = std::chrono::seconds(1);
+
+    // Add a sample and return the new total (value units x seconds).
+    // Samples older than the previous one are ignored.
+    double add(time_point timestamp, double value, duration max_gap = kDefaultMaxGap);
+
+    // Do not integrate across the interval up to the next sample
+    void break_chain() { has_last_ = false; }
+
+    // Set the total (e.g. trip reset or restored state) and drop the anchor
+    void reset(double total = 0.0);
+
+    double total() const { return total_; }
+
+private:
+    double total_ = 0.0;
+    double compensation_ = 0.0;
+    bool has_last_ = false;
+    time_point last_time_;
+    double last_value_ = 0.0;
+};
+
+} // namespace vssdag
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+#include "vssdag/mapping_types.h"
+
+namespace vssdag {
+
+// Breakpoints of one table axis, preprocessed for fast segment lookup:
+// uniformly spaced axes are indexed arithmetically, others by binary search.
+class LookupAxis {
+public:
+    // Breakpoints must be strictly increasing with at least two points
+    bool build(const std::vector<double>& points);
+
+    // Locate value: segment index and fraction within it, clamped to the axis
+    void locate(double value, size_t& index, double& fraction) const;
+
+    size_t size() const { return points_.size(); }
+    bool is_uniform() const { return uniform_; }
+
+private:
+    std::vector<double> points_;
+    bool uniform_ = false;
+    double origin_ = 0.0;
+    double inv_step_ = 0.0;
+};
+
+// Calibration table compiled from a LookupTableSpec (linear / bilinear interpolation)
+class LookupTable {
+public:
+    // Validate and preprocess spec; logs and returns nullopt if it is malformed
+    static std::optional<LookupTable> compile(const std::string& name, const LookupTableSpec& spec);
+
+    bool is_2d() const { return is_2d_; }
+
+    double evaluate(double x) const;
+    double evaluate(double x, double y) const;
+
+private:
+    LookupAxis x_axis_;
+    LookupAxis y_axis_;
+    std::vector<double> values_;  // 1D: y values; 2D: z row-major (rows follow y)
+    bool is_2d_ = false;
+};
+
+} // namespace vssdag
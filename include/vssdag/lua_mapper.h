@@ -4,9 +4,13 @@
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <optional>
+#include "vssdag/symbol.h"
+#include "vssdag/value_codec.h"
 #include "vssdag/vss_types.h"
 #include "vssdag/signal_source.h"
+#include "vssdag/clock.h"
 
 extern "C" {
 #include <lua.h>
@@ -17,14 +21,19 @@ extern "C" {
 namespace vssdag {
 
 struct VSSSignal {
-    std::string path;
+    Symbol path;
     DynamicQualifiedValue qualified_value;  // Value with quality and timestamp
 };
 
 class LuaMapper {
 public:
-    LuaMapper();
+    // Lua allocations are served from a pool on top of upstream, so freed
+    // tables and strings are reused instead of going back to the heap
+    explicit LuaMapper(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
     ~LuaMapper();
+
+    LuaMapper(const LuaMapper&) = delete;
+    LuaMapper& operator=(const LuaMapper&) = delete;
     
     bool load_mapping_file(const std::string& lua_file);
     
@@ -34,7 +43,25 @@ public:
     
     // New methods for VSS mapper
     bool execute_lua_string(const std::string& lua_code);
-    std::optional<VSSSignal> call_transform_function(const std::string& signal_name, double value);
+    // Same, naming the chunk chunk_name in errors; unlike execute_lua_string(lua_code)
+    // the source text is not kept as the chunk name in the Lua heap
+    bool execute_lua_string(const std::string& lua_code, const std::string& chunk_name);
+
+    // Compile lua_code without running it and append its bytecode (lua_dump)
+    // to bytecode
+    bool compile_lua_string(const std::string& lua_code, const std::string& chunk_name,
+                            std::string& bytecode);
+    // Run bytecode from compile_lua_string(); source text is rejected
+    bool execute_lua_bytecode(const std::string& bytecode, const std::string& chunk_name);
+    // codec converts the result value; without one the result's type field selects it
+    std::optional<VSSSignal> call_transform_function(const std::string& signal_name, double value,
+                                                     const ValueCodec* codec = nullptr);
+
+    // Calls process_signal(signal_name, value) for a transform returning
+    // (value, status). path and codec are the signal's; returning no status
+    // publishes nothing, a nil value with STATUS_VALID publishes INVALID.
+    std::optional<VSSSignal> call_transform_values(const std::string& signal_name, double value,
+                                                   const Symbol& path, const ValueCodec& codec);
     
     // Get a Lua variable value (for debugging/testing)
     std::optional<std::string> get_lua_variable(const std::string& var_name);
@@ -42,12 +69,20 @@ public:
     // Get the Lua state for advanced operations
     lua_State* get_lua_state() { return L_; }
 
+    // Clock used to timestamp extracted signals (defaults to real time)
+    void set_clock(std::shared_ptr<IClock> clock) { clock_ = std::move(clock); }
+
 private:
+    std::pmr::unsynchronized_pool_resource lua_pool_;  // Outlives L_
     lua_State* L_ = nullptr;
+    std::shared_ptr<IClock> clock_ = default_clock();
     
+    static void* lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize);
+    static int lua_panic(lua_State* L);
+
     bool execute_mapping_function();
-    VSSSignal extract_vss_signal(int index);
-    std::optional<VSSSignal> extract_vss_signal_from_stack();
+    VSSSignal extract_vss_signal(int index, const ValueCodec* codec = nullptr);
+    std::optional<VSSSignal> extract_vss_signal_from_stack(const ValueCodec* codec);
 };
 
 } // namespace vssdag
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "vssdag/compiled_plan.h"
+#include "vssdag/execution_budget.h"
+#include "vssdag/mapping_types.h"
+#include "vssdag/pipeline_config.h"
+#include "vssdag/resampler.h"
+
+namespace vssdag {
+
+// Everything a mapping file configures for a SignalProcessorDAG
+struct MappingConfig {
+    std::unordered_map<std::string, SignalMapping> mappings;
+    std::vector<ResampleGroup> resample_groups;
+    ExecutionBudget execution_budget;
+    std::optional<std::chrono::microseconds> batch_deadline;
+
+    // Staged pipeline (`pipeline:` section); nullopt when absent or disabled
+    std::optional<PipelineConfig> pipeline;
+    size_t pipeline_frame_capacity = 4096;  // Raw CAN frames queued for the decode stage
+
+    // Filled in by vssdag-compile and carried by compiled artifacts only
+    std::optional<CompiledPlan> plan;
+};
+
+// Load a YAML mapping file. Unknown keywords (datatype, priority, join
+// policy, trigger, resample method), duplicate signals, dependencies on
+// undeclared signals and malformed lookup tables are logged and rejected.
+bool load_mapping_file(const std::string& path, MappingConfig& config);
+bool load_mapping_yaml(const std::string& yaml, MappingConfig& config);
+
+// Compiled artifact: the validated MappingConfig and its CompiledPlan in a
+// versioned binary format that loads without YAML parsing (mmap'ed and
+// decoded in one pass). Passing the plan to SignalProcessorDAG::initialize()
+// and CANSignalSource::set_decode_plan() skips the DAG sort, Lua compilation
+// and DBC signal lookups. Loading re-runs the cross-mapping checks and
+// rejects unknown enum tags. Lua bytecode is not verified: only load
+// artifacts from trusted sources, built against the same Lua version.
+bool save_compiled_mappings(const MappingConfig& config, const std::string& path);
+bool load_compiled_mappings(const std::string& path, MappingConfig& config);
+
+// True if path starts with the compiled artifact magic
+bool is_compiled_mapping_file(const std::string& path);
+
+} // namespace vssdag
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -16,6 +18,7 @@ struct DirectMapping {
 
 struct CodeTransform {
     std::string expression;  // Lua code (single or multi-line)
+    bool coroutine = false;  // Run as a coroutine that may wait(ms) / wait_for(dep)
 };
 
 struct ValueMapping {
@@ -24,12 +27,46 @@ struct ValueMapping {
 
 using Transform = std::variant<DirectMapping, CodeTransform, ValueMapping>;
 
+// Calibration table declared on a mapping, used from code as lookup(name, x [, y]).
+// 1D: x -> y. 2D: z[row][column] with rows following y and columns following x.
+// Breakpoints must be strictly increasing; inputs outside the table are clamped.
+struct LookupTableSpec {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<std::vector<double>> z;  // 2D tables only
+};
+
 enum class UpdateTrigger {
     ON_DEPENDENCY,  // Only when dependencies update (default)
     PERIODIC,       // Every interval_ms regardless of dependencies
     BOTH           // On dependency update OR periodic
 };
 
+// Scheduling class. Higher classes are evaluated first within a batch, and a
+// signal's dependencies inherit the highest class of the signals using them.
+enum class Priority {
+    LOW,
+    NORMAL,    // Default
+    HIGH,
+    CRITICAL   // Never deferred by the batch deadline
+};
+
+// How a derived signal combines dependencies that update at different times
+enum class JoinPolicy {
+    LATEST,       // Latest value of every dependency, evaluate on any update (default)
+    WAIT_ALL,     // Evaluate once every dependency has a new sample within join_tolerance_ms
+    INTERPOLATE   // Interpolate every dependency to a common time, evaluate once per new time
+};
+
+// Transform shared by the instances of a `for` mapping template. Every
+// instance calls the same generated Lua factory, which binds the instance
+// index to `variable` in the transform code.
+struct MappingTemplate {
+    std::string name;      // Signal name pattern, e.g. "Battery.Cell{i}.Voltage"
+    std::string variable;  // Loop variable, e.g. "i"
+    Transform transform;
+};
+
 struct SignalMapping {
     ValueType datatype = ValueType::UNSPECIFIED;  // Default to unspecified, must be explicitly set
     int interval_ms = 0;  // Default to 0 (no throttling)
@@ -44,10 +81,44 @@ struct SignalMapping {
     // Update triggering
     UpdateTrigger update_trigger = UpdateTrigger::ON_DEPENDENCY;
 
+    // Scheduling class (see Priority)
+    Priority priority = Priority::NORMAL;
+
+    // Dependency alignment (derived signals only). join_tolerance_ms is the
+    // maximum spread between samples for WAIT_ALL, and for INTERPOLATE the
+    // maximum lag behind the newest sample before lagging dependencies are
+    // held instead of waited for (0 = wait indefinitely).
+    JoinPolicy join_policy = JoinPolicy::LATEST;
+    int join_tolerance_ms = 0;
+
+    // Lua instruction budget per evaluation (0 = ExecutionBudget default).
+    // An evaluation exceeding it is aborted and the signal published INVALID.
+    uint64_t max_instructions = 0;
+
+    // Samples of this signal kept for hist() (0 = no history)
+    int history_size = 0;
+
+    // Calibration tables available to this signal's transform (name -> table)
+    std::unordered_map<std::string, LookupTableSpec> lookup_tables;
+
+    // Template instances leave transform empty and use instance_of->transform
+    std::shared_ptr<const MappingTemplate> instance_of;
+    int64_t template_index = 0;
+
     // Struct support (VSS 4.0)
     std::string struct_type;  // e.g., "Types.Location" (empty if not a struct)
     std::string struct_field; // e.g., "Latitude" (field within the struct)
     bool is_struct = false;   // Quick check flag
+
+    // Transform to evaluate (the template's for template instances)
+    const Transform& effective_transform() const {
+        return instance_of ? instance_of->transform : transform;
+    }
 };
 
+// Mapping set keyed by signal name. SignalDAG nodes reference the entries of
+// a shared, immutable set instead of holding copies.
+using MappingSet = std::unordered_map<std::string, SignalMapping>;
+using SharedMappings = std::shared_ptr<const MappingSet>;
+
 } // namespace vssdag
\ No newline at end of file
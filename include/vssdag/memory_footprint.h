@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "vssdag/mapping_types.h"
+
+namespace vssdag {
+
+// Approximate heap use of a configured SignalProcessorDAG in bytes. Container
+// overheads are estimated from element sizes and bucket counts, so compare
+// figures between configurations rather than against the allocator.
+struct MemoryFootprint {
+    size_t mappings = 0;  // Mapping set: names, dependencies, transform source, tables
+    size_t dag = 0;       // Nodes, edges, name index and processing orders
+    size_t lua = 0;       // Lua heap: generated transforms and their state
+    size_t runtime = 0;   // Signal values, histories and per-node native state
+
+    size_t total() const { return mappings + dag + lua + runtime; }
+};
+
+// Heap bytes owned by a string (0 while it fits the small-string buffer)
+inline size_t heap_bytes(const std::string& text) {
+    return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+}
+
+// Approximate heap bytes of a mapping set; templates are counted once
+size_t estimate_mapping_bytes(const MappingSet& mappings);
+
+} // namespace vssdag
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "vssdag/pipeline_config.h"
+#include "vssdag/signal_processor.h"
+#include "vssdag/signal_source.h"
+#include "vssdag/spsc_ring.h"
+
+namespace vssdag {
+
+struct PipelineStats {
+    uint64_t updates = 0;          // Updates handed to the evaluate stage
+    uint64_t batches = 0;          // process_signal_updates() calls
+    uint64_t outputs = 0;          // Signals delivered to the sink
+    uint64_t outputs_dropped = 0;  // Signals dropped because the sink fell behind
+};
+
+// Three-stage pipeline: decode (source poll) -> evaluate (DAG) -> sink,
+// each on its own thread and connected by bounded SPSC rings.
+//
+// The decode stage waits when the evaluate stage falls behind, so no update
+// is lost between them; the evaluate stage never waits for the sink and
+// drops outputs instead (see PipelineStats). Once started, the source and
+// processor must only be used by the pipeline until stop().
+class Pipeline {
+public:
+    using Sink = std::function<void(const VSSSignal&)>;
+
+    Pipeline(ISignalSource& source, SignalProcessorDAG& processor, Sink sink,
+             PipelineConfig config = {});
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    void start();
+
+    // Stop and join all stages (in-flight updates and outputs are discarded)
+    void stop();
+
+    PipelineStats stats() const;
+
+private:
+    ISignalSource& source_;
+    SignalProcessorDAG& processor_;
+    Sink sink_;
+    PipelineConfig config_;
+
+    SpscRing<SignalUpdate> updates_;
+    SpscRing<VSSSignal> outputs_;
+
+    std::atomic<bool> running_{false};
+    std::thread decode_thread_;
+    std::thread evaluate_thread_;
+    std::thread sink_thread_;
+
+    std::atomic<uint64_t> update_count_{0};
+    std::atomic<uint64_t> batch_count_{0};
+    std::atomic<uint64_t> output_count_{0};
+    std::atomic<uint64_t> dropped_count_{0};
+
+    void decode_loop();
+    void evaluate_loop();
+    void sink_loop();
+};
+
+// Pin a thread to one CPU; false (and a warning) if unsupported or failed
+bool set_thread_affinity(std::thread& thread, int cpu);
+
+} // namespace vssdag
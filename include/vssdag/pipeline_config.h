@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace vssdag {
+
+// Ring sizes, batching and thread placement of a Pipeline
+struct PipelineConfig {
+    size_t update_capacity = 8192;  // Decode -> evaluate ring
+    size_t output_capacity = 8192;  // Evaluate -> sink ring
+    size_t max_batch = 256;         // Updates per process_signal_updates() call
+
+    // CPU per stage thread (-1 = no affinity)
+    int decode_cpu = -1;
+    int evaluate_cpu = -1;
+    int sink_cpu = -1;
+
+    // Sleep of an idle stage before polling again
+    std::chrono::microseconds idle_sleep{200};
+};
+
+} // namespace vssdag
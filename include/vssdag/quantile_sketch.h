@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vssdag {
+
+// Streaming quantile sketch with relative-error guarantees (DDSketch).
+//
+// Values are counted in logarithmically spaced buckets, so any quantile is
+// reported within relative_accuracy of the true sample value, for floats and
+// integers alike. Sketches with the same accuracy merge exactly, which lets
+// per-vehicle sketches be combined offline from their serialized form.
+// Memory is bounded by max_bins buckets per sign; past that the buckets
+// closest to zero are collapsed first.
+class QuantileSketch {
+public:
+    static constexpr double kDefaultRelativeAccuracy = 0.01;
+    static constexpr size_t kDefaultMaxBins = 2048;
+
+    explicit QuantileSketch(double relative_accuracy = kDefaultRelativeAccuracy,
+                            size_t max_bins = kDefaultMaxBins);
+
+    // Add a value (NaN is ignored)
+    void add(double value, uint64_t count = 1);
+
+    // Merge another sketch; fails if the accuracies differ
+    bool merge(const QuantileSketch& other);
+
+    // Value at quantile q in [0, 1], nullopt if empty
+    std::optional<double> quantile(double q) const;
+
+    void clear();
+
+    uint64_t count() const { return count_; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    double sum() const { return sum_; }
+    double relative_accuracy() const { return relative_accuracy_; }
+
+    // Single-line text form, see deserialize()
+    std::string serialize() const;
+    static std::optional<QuantileSketch> deserialize(const std::string& text);
+
+private:
+    // Contiguous bucket counts for indices [offset, offset + counts.size())
+    struct Store {
+        std::vector<uint64_t> counts;
+        int offset = 0;
+
+        void add(int index, uint64_t count, size_t max_bins);
+        bool empty() const { return counts.empty(); }
+    };
+
+    double relative_accuracy_;
+    size_t max_bins_;
+    double gamma_;
+    double log_gamma_;
+
+    Store positive_;
+    Store negative_;  // Indexed by magnitude
+    uint64_t zero_count_ = 0;
+    uint64_t count_ = 0;
+    double min_ = 0.0;
+    double max_ = 0.0;
+    double sum_ = 0.0;
+
+    int index_of(double magnitude) const;
+    double value_of(int index) const;
+    void record_extremes(double min, double max, double sum, uint64_t count);
+};
+
+} // namespace vssdag
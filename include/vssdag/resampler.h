@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "vssdag/window_aggregator.h"
+
+namespace vssdag {
+
+// How a signal is mapped onto a grid tick
+enum class ResampleMethod {
+    HOLD,    // Last sample at or before the tick (default)
+    LINEAR,  // Interpolate between the samples around the tick, hold if none after it
+    MEAN     // Mean of the samples since the previous tick, hold if none
+};
+
+struct ResampleColumn {
+    std::string signal;
+    ResampleMethod method = ResampleMethod::HOLD;
+};
+
+// Signals sampled together on a fixed-rate grid (multiples of period_ms on
+// the steady clock). A tick is emitted delay_ms after its grid time, which
+// gives LINEAR columns the chance to see the sample following the tick.
+struct ResampleGroup {
+    std::string name;
+    int period_ms = 100;
+    int delay_ms = 0;
+    std::vector<ResampleColumn> columns;
+};
+
+// Resamples the columns of one ResampleGroup into a preallocated row.
+//
+// Values are doubles; NaN marks a column without a (valid) sample yet.
+// Once the pending buffers have grown to the input rate, emitting rows
+// does not allocate.
+class Resampler {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    // Called once per tick with the grid time and the row (valid during the call)
+    using RowHandler = std::function<void(const ResampleGroup& group, time_point tick,
+                                          const std::vector<double>& row)>;
+
+    // Ticks start at the first grid time at or after start
+    Resampler(ResampleGroup group, time_point start);
+
+    // Record a sample of column (NaN for an invalid sample); samples older
+    // than the newest one of the column are ignored
+    void record(size_t column, time_point timestamp, double value);
+
+    // Emit every tick due at now, returns the number of rows emitted
+    size_t advance(time_point now, const RowHandler& handler);
+
+    // Time at which the next tick is emitted (grid time + delay)
+    time_point next_emit() const { return next_tick_ + delay_; }
+
+    const ResampleGroup& group() const { return group_; }
+    const std::vector<double>& row() const { return row_; }
+
+private:
+    struct Point {
+        time_point timestamp;
+        double value = 0.0;
+    };
+
+    struct ColumnState {
+        RingBuffer<Point> pending;  // Samples after the previous tick
+        Point last;                 // Newest sample at or before the previous tick
+        bool has_last = false;
+    };
+
+    ResampleGroup group_;
+    std::chrono::steady_clock::duration period_;
+    std::chrono::steady_clock::duration delay_;
+    time_point next_tick_;
+
+    std::vector<ColumnState> columns_;
+    std::vector<double> row_;
+
+    // Value of column at tick, consuming its samples up to tick
+    double sample(ColumnState& column, ResampleMethod method, time_point tick);
+};
+
+} // namespace vssdag
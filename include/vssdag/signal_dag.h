@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,25 +9,37 @@
 #include <stdexcept>
 #include <queue>
 #include <glog/logging.h>
+#include "vssdag/compiled_plan.h"
 #include "vssdag/mapping_types.h"
+#include "vssdag/symbol.h"
+#include "vssdag/value_codec.h"
 
 namespace vssdag {
 
 // Forward declaration
 struct SignalMapping;
 
-// Signal node in the DAG
+// Signal node in the DAG. Name, dependencies and configuration refer to the
+// DAG's shared mapping set.
 struct SignalNode {
-    std::string signal_name;       // Signal name (used in dependencies)
-    std::vector<std::string> depends_on;  // Signal names this depends on
-    std::vector<SignalNode*> dependents;  // Nodes that depend on this
+    SignalNode(const std::string& name, const SignalMapping& signal_mapping)
+        : signal_name(name), depends_on(signal_mapping.depends_on), symbol(name),
+          dependency_symbols(depends_on.begin(), depends_on.end()), mapping(signal_mapping),
+          codec(value_codec(signal_mapping.datatype)) {}
+
+    const std::string& signal_name;              // Signal name (used in dependencies)
+    const std::vector<std::string>& depends_on;  // Signal names this depends on
+    const Symbol symbol;                         // Interned signal_name
+    const std::vector<Symbol> dependency_symbols;  // Interned depends_on
+    std::vector<SignalNode*> dependents;         // Nodes that depend on this
     
     // For topological sort
     int in_degree = 0;
     bool is_input_signal = true;   // true for signals from external sources, false for derived signals
     
     // Transform configuration
-    SignalMapping mapping;
+    const SignalMapping& mapping;
+    const ValueCodec& codec;  // Conversions for mapping.datatype
     
     // Runtime state
     bool has_new_data = false;
@@ -34,11 +47,23 @@ struct SignalNode {
     
     // Output throttling
     std::chrono::steady_clock::time_point last_output = std::chrono::steady_clock::time_point::min();
-    std::string last_output_value;  // To detect changes
+    // Last published value and status, to suppress unchanged timer wakeups
+    Value last_output_value;
+    SignalQuality last_output_quality = SignalQuality::UNKNOWN;
     
     // Periodic processing
     std::chrono::steady_clock::time_point last_process = std::chrono::steady_clock::time_point::min();
     bool needs_periodic_update = false;  // Set based on update_trigger
+
+    // Effective scheduling class: mapping priority raised to that of its dependents
+    Priority priority = Priority::NORMAL;
+
+    // Deferred evaluation (max() when no wakeup is scheduled, see TimerQueue)
+    std::chrono::steady_clock::time_point next_wakeup = std::chrono::steady_clock::time_point::max();
+    bool timer_wakeup_only = false;  // Woken by its timer with no new dependency data
+    // Due time of this node's entry in the timer heap (max() when none); it
+    // can outlive a cancel and be reused when the same time is requested again
+    std::chrono::steady_clock::time_point queued_wakeup = std::chrono::steady_clock::time_point::max();
 };
 
 class SignalDAG {
@@ -46,41 +71,77 @@ public:
     SignalDAG() = default;
     ~SignalDAG() = default;
     
-    // Build DAG from signal mappings
+    // Build DAG from signal mappings (copied once into a shared set)
     bool build(const std::unordered_map<std::string, SignalMapping>& mappings);
+
+    // Build DAG referencing a shared mapping set, which it keeps alive
+    bool build(SharedMappings mappings);
+
+    // Same, taking the processing and priority orders from a compiled plan.
+    // They are checked against the dependencies instead of being re-sorted.
+    bool build(SharedMappings mappings, const CompiledPlan& plan);
+
+    const SharedMappings& get_mappings() const { return mappings_; }
+
+    // Approximate heap bytes of the nodes, edges, index and orders (not
+    // counting the mapping set, see estimate_mapping_bytes())
+    size_t memory_bytes() const;
     
     // Get processing order (topologically sorted)
     const std::vector<SignalNode*>& get_processing_order() const {
         return processing_order_;
     }
     
+    // Processing order grouped by effective priority, highest first
+    // (still a valid topological order)
+    const std::vector<SignalNode*>& get_priority_order() const {
+        return priority_order_;
+    }
+    
     // Get all nodes
     const std::vector<std::unique_ptr<SignalNode>>& get_nodes() const {
         return nodes_;
     }
     
-    // Get node by signal name
-    SignalNode* get_node(const std::string& signal_name) {
-        auto it = signal_map_.find(signal_name);
-        return it != signal_map_.end() ? it->second : nullptr;
+    // Get node by signal name (an index by symbol ID)
+    SignalNode* get_node(Symbol signal) {
+        return signal.id() < nodes_by_symbol_.size() ? nodes_by_symbol_[signal.id()] : nullptr;
     }
+    SignalNode* get_node(std::string_view signal_name) {
+        auto signal = Symbol::find(signal_name);  // Unknown names are not interned
+        return signal ? get_node(*signal) : nullptr;
+    }
+    SignalNode* get_node(const std::string& signal_name) { return get_node(std::string_view(signal_name)); }
+    SignalNode* get_node(const char* signal_name) { return get_node(std::string_view(signal_name)); }
     
     
     // Mark CAN signal as having new data
-    void mark_can_signal_updated(const std::string& signal_name) {
-        if (auto* node = get_node(signal_name)) {
-            node->has_new_data = true;
-            // Mark all dependents as potentially needing update
-            propagate_update_flag(node);
+    void mark_can_signal_updated(Symbol signal) {
+        if (auto* node = get_node(signal)) {
+            mark_node_updated(node);
         }
     }
 
+    // Mark node (e.g. woken by a timer) and its dependents as having new data
+    void mark_node_updated(SignalNode* node) {
+        node->has_new_data = true;
+        // Mark all dependents as potentially needing update
+        propagate_update_flag(node);
+    }
+
 private:
+    SharedMappings mappings_;
     std::vector<std::unique_ptr<SignalNode>> nodes_;
-    std::unordered_map<std::string, SignalNode*> signal_map_;     // signal_name -> node
+    std::vector<SignalNode*> nodes_by_symbol_;  // SymbolId -> node (nullptr for other symbols)
     std::vector<SignalNode*> processing_order_;
+    std::vector<SignalNode*> priority_order_;
     
+    // Create nodes and dependency edges
+    bool build_nodes(SharedMappings mappings);
     bool topological_sort();
+    bool apply_plan_order(const CompiledPlan& plan);
+    void assign_priorities();
+    void log_processing_order() const;
     void propagate_update_flag(SignalNode* node);
 };
 
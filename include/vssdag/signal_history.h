@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include "vssdag/vss_types.h"
+#include "vssdag/window_aggregator.h"
+
+namespace vssdag {
+
+// Last `capacity` samples of one signal (SignalMapping::history_size),
+// shared by every transform reading it through hist().
+class SignalHistory {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    struct Sample {
+        time_point timestamp;
+        Value value;
+        SignalQuality quality = SignalQuality::UNKNOWN;
+    };
+
+    explicit SignalHistory(size_t capacity) : capacity_(capacity) {}
+
+    void push(time_point timestamp, const Value& value, SignalQuality quality) {
+        if (capacity_ == 0) {
+            return;
+        }
+        if (samples_.size() == capacity_) {
+            samples_.pop_front();
+        }
+        samples_.push_back(Sample{timestamp, value, quality});
+    }
+
+    size_t size() const { return samples_.size(); }
+    size_t capacity() const { return capacity_; }
+
+    // k-th newest sample (0 = newest), nullptr if not recorded
+    const Sample* at(size_t k) const {
+        return k < samples_.size() ? &samples_[samples_.size() - 1 - k] : nullptr;
+    }
+
+private:
+    size_t capacity_;
+    RingBuffer<Sample> samples_;
+};
+
+} // namespace vssdag
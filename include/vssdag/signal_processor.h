@@ -1,46 +1,272 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <vector>
 #include <chrono>
 #include <variant>
+#include <optional>
+#include "vssdag/compiled_plan.h"
 #include "vssdag/signal_dag.h"
 #include "vssdag/lua_mapper.h"
 #include "vssdag/signal_source.h"
+#include "vssdag/clock.h"
+#include "vssdag/timer_queue.h"
+#include "vssdag/lookup_table.h"
+#include "vssdag/integrator.h"
+#include "vssdag/fusion_filters.h"
+#include "vssdag/dependency_join.h"
+#include "vssdag/resampler.h"
+#include "vssdag/quantile_sketch.h"
+#include "vssdag/signal_history.h"
+#include "vssdag/hysteresis.h"
+#include "vssdag/execution_budget.h"
+#include "vssdag/memory_footprint.h"
 
 namespace vssdag {
 
 class SignalProcessorDAG {
 public:
     SignalProcessorDAG();
+    // Use an injected clock (e.g. SimulatedClock for replay / tests). Lua
+    // memory is pooled on top of lua_memory (the global heap by default).
+    explicit SignalProcessorDAG(std::shared_ptr<IClock> clock,
+                                std::pmr::memory_resource* lua_memory = nullptr);
     ~SignalProcessorDAG();
     
-    // Initialize with mappings
+    // Initialize with mappings. The processor keeps one private copy (or
+    // takes over an rvalue set) and releases its transform source once
+    // compiled into Lua.
     bool initialize(const std::unordered_map<std::string, SignalMapping>& mappings);
+    bool initialize(std::unordered_map<std::string, SignalMapping>&& mappings);
+
+    // Initialize referencing a shared mapping set (kept alive, not modified)
+    bool initialize(SharedMappings mappings);
+
+    // With a plan from a compiled artifact, the DAG takes its orders instead
+    // of sorting, transforms are loaded from its bytecode instead of being
+    // generated and compiled, and its enum tables fill signal_enums in Lua.
+    // The plan is only read during the call.
+    bool initialize(const std::unordered_map<std::string, SignalMapping>& mappings,
+                    const CompiledPlan& plan);
+    bool initialize(std::unordered_map<std::string, SignalMapping>&& mappings,
+                    const CompiledPlan& plan);
+
+    // Initialize and record the DAG orders and the bytecode of every
+    // generated transform in plan (used by vssdag-compile)
+    bool compile_plan(const std::unordered_map<std::string, SignalMapping>& mappings,
+                      CompiledPlan& plan);
+
+    // Approximate heap use by mapping set, DAG, Lua and runtime state
+    MemoryFootprint memory_footprint() const;
     
     // Process signal updates from signal sources
     std::vector<VSSSignal> process_signal_updates(
         const std::vector<vssdag::SignalUpdate>& updates);
+
+    // Same, appending to out. Reusing out across calls keeps steady-state
+    // processing of numeric signals free of heap allocations.
+    void process_signal_updates(const std::vector<vssdag::SignalUpdate>& updates,
+                                std::vector<VSSSignal>& out);
     
     // Get list of input signals we're interested in
     std::vector<std::string> get_required_input_signals() const;
 
+    // Clock driving periodic triggers, throttling and Lua time helpers
+    const IClock& clock() const { return *clock_; }
+
+    // Earliest time at which process_signal_updates() has work to do without
+    // new input (scheduled wakeups such as delayed(), and periodic nodes).
+    // Run loops can sleep until then; nullopt means nothing is scheduled.
+    std::optional<std::chrono::steady_clock::time_point> next_wakeup() const;
+
+    // Integrator totals (integrate(), odometer(), energy()) by signal name.
+    // Restore after initialize() and before processing to carry odometers and
+    // energy counters across restarts.
+    std::unordered_map<std::string, double> get_accumulator_state() const;
+    void restore_accumulator_state(const std::unordered_map<std::string, double>& totals);
+
+    // Persist accumulator state as "<signal> <total>" lines
+    bool save_accumulators(const std::string& path) const;
+    bool load_accumulators(const std::string& path);
+
+    // Quantile sketches (sketch_add()) by name, serialized with
+    // QuantileSketch::serialize(). Restoring merges into existing sketches.
+    std::unordered_map<std::string, std::string> get_sketch_state() const;
+    bool restore_sketch_state(const std::unordered_map<std::string, std::string>& sketches);
+
+    // Persist sketches in a binary file of length-prefixed name and sketch
+    // records; loading rejects truncated or malformed files
+    bool save_sketches(const std::string& path) const;
+    bool load_sketches(const std::string& path);
+
+    // Bound Lua execution time per node evaluation and per batch. Nodes over
+    // budget are aborted and published INVALID; see execution_metrics().
+    void set_execution_budget(const ExecutionBudget& budget) { budget_ = budget; }
+    const ExecutionMetrics& execution_metrics() const { return metrics_; }
+
+    // Time after the start of process_signal_updates() (on the processor's
+    // clock) after which lower priority classes are deferred to the next
+    // call. CRITICAL signals are always evaluated. nullopt disables it.
+    // A SimulatedClock does not advance during a call, so with one only a
+    // zero deadline ever fires.
+    void set_batch_deadline(std::optional<std::chrono::steady_clock::duration> deadline) {
+        batch_deadline_ = deadline;
+    }
+
+    // Resample signals onto a fixed-rate grid (see ResampleGroup). Add groups
+    // after initialize(); rows are emitted from process_signal_updates() as
+    // their ticks fall due, next_wakeup() includes the next tick.
+    bool add_resample_group(const ResampleGroup& group);
+    void set_resample_handler(Resampler::RowHandler handler);
+
 private:
+    std::shared_ptr<IClock> clock_;
     std::unique_ptr<SignalDAG> dag_;
     std::unique_ptr<LuaMapper> lua_mapper_;
 
     // Current qualified values for all provided signals (combines value + quality + timestamp)
-    std::unordered_map<std::string, DynamicQualifiedValue> signal_values_;
+    std::unordered_map<Symbol, DynamicQualifiedValue> signal_values_;
 
     // Track last processing time for periodic updates
     std::chrono::steady_clock::time_point last_periodic_check_;
+
+    // Deferred evaluation requested from Lua via schedule_at()
+    TimerQueue timer_queue_;
+    std::vector<SignalNode*> due_nodes_;       // Scratch buffer for timer_queue_.pop_due()
+    std::vector<SignalNode*> nodes_to_process_;  // Scratch buffer for process_signal_updates()
+    std::vector<SignalNode*> periodic_nodes_;  // Nodes with PERIODIC/BOTH triggers
+    SignalNode* current_node_ = nullptr;       // Node whose transform is running
+    uint64_t evaluation_seq_ = 0;              // Incremented for every node evaluation
+
+    // Lua: schedule_at(t) - wake the current node at _current_time t (seconds)
+    static int lua_schedule_at(lua_State* L);
+
+    // Lua: mark_pending() - re-evaluate the current node at its next periodic
+    // deadline, or after 10 ms if it has no interval
+    static int lua_mark_pending(lua_State* L);
+
+    // Lua: window_update(w, value, t, agg) - feed a native window, see window_aggregate()
+    static int lua_window_update(lua_State* L);
+
+    // Calibration tables compiled from SignalMapping::lookup_tables, per node
+    std::unordered_map<const SignalNode*, std::vector<std::pair<std::string, LookupTable>>> lookup_tables_;
+
+    // Compile lookup tables of all nodes
+    bool compile_lookup_tables();
+
+    // Lua: lookup(name, x [, y]) - interpolate in one of the current node's tables
+    static int lua_lookup(lua_State* L);
+
+    // Native integrators, one per node using integrate()
+    std::unordered_map<const SignalNode*, Integrator> integrators_;
+
+    // Lua: integrate(value [, max_gap_ms]) / reset_integral([total]) for the current node
+    static int lua_integrate(lua_State* L);
+    static int lua_reset_integral(lua_State* L);
+
+    // Native threshold switches, one per node using hysteresis()
+    std::unordered_map<const SignalNode*, Hysteresis> hysteresis_;
+
+    // Lua: hysteresis(x, on, off [, on_debounce_ms [, off_debounce_ms]]) - publishes on transitions only
+    static int lua_hysteresis(lua_State* L);
+
+    // Named quantile sketches shared by all nodes
+    std::unordered_map<std::string, QuantileSketch> sketches_;
+
+    // Lua: sketch_add(name, value [, accuracy]), sketch_quantile(name, q), sketch_reset(name)
+    static int lua_sketch_add(lua_State* L);
+    static int lua_sketch_quantile(lua_State* L);
+    static int lua_sketch_reset(lua_State* L);
+
+    // Native fusion filters (fixed-size state), one set per node using them
+    std::unordered_map<const SignalNode*, FusionState> fusion_states_;
+
+    // Lua: kalman()/kalman_cv()/kalman_ca() (order in upvalue 2), kalman_fuse(), complementary()
+    static int lua_kalman(lua_State* L);
+    static int lua_kalman_fuse(lua_State* L);
+    static int lua_complementary(lua_State* L);
+
+    // Dependency alignment for nodes with a JoinPolicy other than LATEST
+    std::unordered_map<const SignalNode*, DependencyJoin> joins_;
+    // Dependency node -> (join, index in its depends_on) fed by its samples
+    std::unordered_map<const SignalNode*, std::vector<std::pair<DependencyJoin*, size_t>>> join_feeds_;
+
+    // Build joins_ / join_feeds_ from the mappings
+    void setup_joins();
+
+    // Fixed-rate resampling groups and the columns fed by each node
+    std::vector<std::unique_ptr<Resampler>> resamplers_;
+    std::unordered_map<const SignalNode*, std::vector<std::pair<Resampler*, size_t>>> resample_feeds_;
+    Resampler::RowHandler resample_handler_;
+
+    // Sample history of nodes with SignalMapping::history_size > 0
+    std::unordered_map<const SignalNode*, SignalHistory> histories_;
+
+    // Lua: hist(name, k) / hist_time(name, k) - k-th previous value / time of
+    // the current signal or one of its dependencies
+    static int lua_hist(lua_State* L);
+
+    // Feed a new value of node to its history and the joins and resamplers using it
+    void record_sample(const SignalNode* node, const Value& value, SignalQuality quality);
     
+    // Instruction budgets (see ExecutionBudget)
+    ExecutionBudget budget_;
+    ExecutionMetrics metrics_;
+    uint64_t batch_instructions_used_ = 0;  // Reset per process_signal_updates()
+    uint64_t budget_limit_ = 0;             // Limit of the running evaluation (0 = none)
+    uint64_t budget_used_ = 0;
+    uint64_t budget_step_ = 0;              // Hook interval
+    bool budget_exceeded_ = false;
+
+    // Priority scheduling
+    std::optional<std::chrono::steady_clock::duration> batch_deadline_;
+    bool deferred_work_ = false;  // Last call left pending work behind
+
+    // Count hook charging budget_step_ instructions per call
+    static void lua_budget_hook(lua_State* L, lua_Debug* ar);
+
+    // Lua: arm_budget(co) - give coroutine co the budget hook of the running
+    // evaluation (or none); threads keep the hook they were created with
+    static int lua_arm_budget(lua_State* L);
+
+    // Call the node's transform under its instruction budget, if any
+    std::optional<VSSSignal> call_transform_with_budget(SignalNode* node, double input);
+
     // Generate Lua infrastructure
     bool setup_lua_environment();
     
     // Generate transform function for a node
     bool generate_transform_function(const SignalNode* node);
+
+    // Generate the shared factory of node's template, and bind an instance to it
+    bool generate_template_factory(const SignalNode* node);
+    bool instantiate_template(const SignalNode* node);
+
+    // Lua statements returning the transform closure for node; name is the
+    // Lua expression for the signal name
+    std::string generate_transform_factory(const SignalNode* node, const Transform& transform,
+                                           const std::string& name);
+
+    // Factory statements for a code transform declared as a coroutine
+    std::string generate_coroutine_transform(const SignalNode* node, const CodeTransform& code,
+                                             const std::string& name);
+
+    // Load generated transform code into the Lua state (and record its
+    // bytecode when compiling a plan)
+    bool execute_transform_code(const SignalNode* node, const std::string& lua_code);
+
+    // Load a transform from its precompiled bytecode
+    bool execute_transform_chunk(const SignalNode* node, const std::string& bytecode);
+
+    // Plan initialize() reads, or compile_plan() records into (only set
+    // during those calls)
+    const CompiledPlan* plan_ = nullptr;
+    CompiledPlan* recorded_plan_ = nullptr;
+
+    // Publish plan_'s enum tables as signal_enums
+    void load_enum_tables();
     
     // Process a single node
     std::optional<VSSSignal> process_node(SignalNode* node);
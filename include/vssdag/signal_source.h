@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <iterator>
 #include <vector>
 #include <memory>
 #include <chrono>
@@ -11,13 +12,14 @@
 #include <yaml-cpp/yaml.h>
 #include <vss/types/quality.hpp>
 #include <vss/types/value.hpp>
+#include "vssdag/symbol.h"
 //#include "base_types.h"
 
 namespace vssdag {
 
 // Signal update with type information preserved
 struct SignalUpdate {
-    std::string signal_name;  // Exported signal name
+    Symbol signal_name;       // Exported signal name (interned)
     vss::types::Value value;  // VSS typed value
     std::chrono::steady_clock::time_point timestamp;
     vss::types::SignalQuality status = vss::types::SignalQuality::VALID;  // Signal validity status
@@ -32,6 +34,14 @@ public:
     // Non-blocking poll for new signal updates
     // Returns empty vector if no updates available
     virtual std::vector<SignalUpdate> poll() = 0;    
+
+    // Same, appending to updates; sources override this to let callers reuse
+    // one buffer instead of receiving a new vector per poll
+    virtual void poll_into(std::vector<SignalUpdate>& updates) {
+        auto polled = poll();
+        updates.insert(updates.end(), std::make_move_iterator(polled.begin()),
+                       std::make_move_iterator(polled.end()));
+    }
     
     // Get list of signals this source exports
     virtual std::vector<std::string> get_exported_signals() const = 0; 
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace vssdag {
+
+// Bounded lock-free ring for exactly one producer and one consumer thread.
+//
+// Slots are allocated once. Push assigns into a slot and pop swaps the
+// slot with the caller's element, so buffers of strings and vectors
+// circulate between ring and consumer instead of being stolen from the
+// ring: once warmed up, neither side allocates as long as the consumer
+// reuses the element it pops into.
+template <typename T>
+class SpscRing {
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer: false if the ring is full
+    template <typename U>
+    bool try_push(U&& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == slots_.size()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == slots_.size()) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::forward<U>(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false if the ring is empty
+    bool try_pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        using std::swap;
+        swap(item, slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return slots_.size(); }
+
+    // Exact only when called from the producer or consumer while the other is idle
+    size_t size_approx() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+
+    // Producer and consumer state on separate cache lines
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;  // Producer's view of head_
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;  // Consumer's view of tail_
+};
+
+} // namespace vssdag
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace vssdag {
+
+using SymbolId = uint32_t;
+
+// Interned name (signal names, DBC signal names). All symbols with the same
+// text share one process-wide entry with a stable ID, so copying, comparing
+// and hashing a symbol are integer operations and reading its text never
+// allocates. Interning takes a lock; entries live until the process exits.
+class Symbol {
+public:
+    Symbol();  // The empty name, ID 0
+    Symbol(std::string_view name);
+    Symbol(const std::string& name) : Symbol(std::string_view(name)) {}
+    Symbol(const char* name) : Symbol(std::string_view(name)) {}
+
+    // Symbol of name if it has been interned, without interning it
+    static std::optional<Symbol> find(std::string_view name);
+
+    // Number of interned symbols and the heap bytes they use
+    static size_t count();
+    static size_t memory_bytes();
+
+    SymbolId id() const { return entry_->id; }
+    const std::string& str() const { return entry_->name; }
+    std::string_view view() const { return entry_->name; }
+    const char* c_str() const { return entry_->name.c_str(); }
+    bool empty() const { return entry_->name.empty(); }
+
+    operator const std::string&() const { return entry_->name; }
+
+    friend bool operator==(Symbol a, Symbol b) { return a.entry_ == b.entry_; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.entry_ != b.entry_; }
+
+    // Text comparisons, without interning the other side
+    friend bool operator==(Symbol a, std::string_view b) { return a.view() == b; }
+    friend bool operator==(Symbol a, const std::string& b) { return a.str() == b; }
+    friend bool operator==(Symbol a, const char* b) { return a.view() == b; }
+
+    friend std::ostream& operator<<(std::ostream& os, Symbol s) { return os << s.str(); }
+
+private:
+    struct Entry {
+        std::string name;
+        SymbolId id;
+    };
+
+    struct Table;
+
+    explicit Symbol(const Entry* entry) : entry_(entry) {}
+    static Table& table();
+    static const Entry* intern(std::string_view name, bool insert);
+
+    const Entry* entry_;
+};
+
+} // namespace vssdag
+
+namespace std {
+template <>
+struct hash<vssdag::Symbol> {
+    size_t operator()(vssdag::Symbol s) const noexcept { return s.id(); }
+};
+} // namespace std
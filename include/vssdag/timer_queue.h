@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <vector>
+#include "vssdag/signal_dag.h"
+
+namespace vssdag {
+
+// Min-heap of node wakeups used for deferred evaluation (delayed(), schedule_at()).
+//
+// Each node has at most one pending wakeup, stored in SignalNode::next_wakeup.
+// Scheduling keeps the earliest requested time; superseded heap entries are
+// discarded lazily when they reach the top. A node re-armed to the time of its
+// entry still in the heap (SignalNode::queued_wakeup) reuses that entry, and
+// the heap is compacted once superseded entries outnumber the queued ones, so
+// its size stays bounded by the number of nodes.
+class TimerQueue {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    // Request a wakeup for node at due (earliest request wins)
+    void schedule(SignalNode* node, time_point due);
+
+    // Drop the pending wakeup of node, if any
+    void cancel(SignalNode* node);
+
+    // Append every node due at or before now to out; each is woken once
+    void pop_due(time_point now, std::vector<SignalNode*>& out);
+
+    // Earliest pending wakeup, if any
+    std::optional<time_point> next_deadline() const;
+
+    bool empty() const { return heap_.empty(); }
+
+    // Heap entries, including superseded ones not yet discarded
+    size_t size() const { return heap_.size(); }
+
+private:
+    struct Entry {
+        time_point due;
+        SignalNode* node;
+        bool operator>(const Entry& other) const { return due > other.due; }
+    };
+
+    std::vector<Entry> heap_;  // Min-heap by due (std::greater)
+    size_t queued_ = 0;        // Nodes whose queued_wakeup has an entry in heap_
+
+    void push(Entry entry);
+    void pop();
+
+    // Pop superseded entries so that heap_.front() is always live
+    void prune();
+
+    // Drop every entry that is not its node's queued entry
+    void compact();
+};
+
+} // namespace vssdag
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include "vssdag/binary_io.h"
+#include "vssdag/vss_types.h"
+
+struct lua_State;
+
+namespace vssdag {
+
+// Conversions for one VSS value type, instantiated from a template per type.
+// A DAG node looks its codec up once, so converting a result is one indirect
+// call instead of a switch on the ValueType or a visit of the variant.
+//
+// The functions taking a Value are fastest when it holds the codec's own
+// alternative; any other alternative is handed to value_codec_of(value).
+struct ValueCodec {
+    ValueType type;
+
+    // Lua value at index as this type. Numbers are converted to the type,
+    // tables are read for struct and array types; booleans, strings and nil
+    // keep their Lua type (monostate for nil)
+    Value (*pull_lua)(lua_State* L, int index);
+
+    // Push value onto the Lua stack (nil for monostate, tables for arrays
+    // and structs)
+    void (*push_lua)(lua_State* L, const Value& value);
+
+    // Append value as JSON
+    void (*append_json)(std::string& out, const Value& value);
+
+    // Value payload without a type tag (see write_value() for tagged values)
+    void (*write_binary)(BinaryWriter& out, const Value& value);
+    Value (*read_binary)(BinaryReader& in);
+
+    // Same alternative and same contents; structs compare by field
+    bool (*equal)(const Value& a, const Value& b);
+};
+
+// Codec of a declared type (UNSPECIFIED for unknown enum values)
+const ValueCodec& value_codec(ValueType type);
+
+// Codec of the alternative value holds (UNSPECIFIED for monostate)
+const ValueCodec& value_codec_of(const Value& value);
+
+// Value as JSON
+std::string value_to_json(const Value& value);
+
+// Value with a one-byte type tag, readable without knowing its type
+void write_value(BinaryWriter& out, const Value& value);
+Value read_value(BinaryReader& in);
+
+// a and b hold the same alternative with equal contents
+bool values_equal(const Value& a, const Value& b);
+
+} // namespace vssdag
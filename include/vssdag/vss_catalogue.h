@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace vssdag {
+
+// Represents a property within a struct type
+struct StructProperty {
+    std::string name;           // Property name (e.g., "Latitude")
+    std::string datatype;        // VSS datatype (e.g., "double")
+    std::string description;
+    std::optional<double> min;
+    std::optional<double> max;
+    std::string unit;
+    std::optional<std::variant<double, std::string, bool>> default_value;
+};
+
+// Represents a complete struct type definition
+struct StructType {
+    std::string type_path;      // Full path (e.g., "Types.Location")
+    std::string description;
+    std::vector<StructProperty> properties;
+
+    // Helper to get property by name
+    const StructProperty* get_property(const std::string& name) const {
+        for (const auto& prop : properties) {
+            if (prop.name == name) return &prop;
+        }
+        return nullptr;
+    }
+};
+
+// VSS 4.0 node types
+enum class VSSNodeType : uint8_t {
+    BRANCH,
+    SENSOR,
+    ACTUATOR,
+    ATTRIBUTE,
+    STRUCT,
+    PROPERTY
+};
+
+// One node of a VSS tree. Branches a spec file only implies (e.g. "Vehicle"
+// for "Vehicle.Speed") are added as implicit entries so the tree is complete.
+struct VSSNode {
+    std::string path;            // Full dotted path
+    VSSNodeType type = VSSNodeType::BRANCH;
+    std::string datatype;
+    std::string description;
+    std::string unit;
+    std::optional<double> min;
+    std::optional<double> max;
+    std::optional<std::variant<double, std::string, bool>> default_value;
+    bool implicit = false;
+
+    int32_t parent = -1;             // Index into VSSCatalogue::nodes(), -1 for roots
+    std::vector<uint32_t> children;  // Direct children, in path order
+
+    std::string_view name() const {
+        auto dot = path.rfind('.');
+        return std::string_view(path).substr(dot == std::string::npos ? 0 : dot + 1);
+    }
+};
+
+// A complete VSS tree (branches, signals, structs and their properties)
+// indexed by path. The spec is read in one pass; nodes are then kept sorted
+// by path so lookups are binary searches and every subtree is a contiguous
+// range. The catalogue can be saved in a compact binary form that loads
+// without YAML parsing.
+class VSSCatalogue {
+public:
+    // Parse vspec YAML, either flattened ("Vehicle.Speed": {type: sensor, ...})
+    // or nested (a "children" map below each branch or struct)
+    bool parse_yaml(const std::string& yaml);
+
+    // Load a vspec YAML file or a binary catalogue written by save()
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // True if path starts with the binary catalogue magic
+    static bool is_catalogue_file(const std::string& path);
+
+    const std::vector<VSSNode>& nodes() const { return nodes_; }
+    const VSSNode* find(std::string_view path) const;
+
+    // Descendants of path (excluding path itself) as a [first, last) index
+    // range into nodes()
+    std::pair<size_t, size_t> descendants(std::string_view path) const;
+
+    // Struct types with their direct properties; structs without properties
+    // are skipped
+    std::vector<StructType> struct_types() const;
+
+private:
+    bool decode(const std::string& data);
+
+    // Add implicit branches, sort by path and link parents and children
+    bool build_index(std::vector<VSSNode> nodes);
+
+    std::vector<VSSNode> nodes_;
+};
+
+} // namespace vssdag
@@ -8,40 +8,17 @@
 #include <chrono>
 #include <optional>
 #include "vssdag/mapping_types.h"
+#include "vssdag/vss_catalogue.h"
 #include "vssdag/vss_types.h"
 #include "vssdag/lua_mapper.h"
+#include "vssdag/clock.h"
 
 namespace vssdag {
 
-// Represents a property within a struct type
-struct StructProperty {
-    std::string name;           // Property name (e.g., "Latitude")
-    std::string datatype;        // VSS datatype (e.g., "double")
-    std::string description;
-    std::optional<double> min;
-    std::optional<double> max;
-    std::string unit;
-    std::optional<std::variant<double, std::string, bool>> default_value;
-};
-
-// Represents a complete struct type definition
-struct StructType {
-    std::string type_path;      // Full path (e.g., "Types.Location")
-    std::string description;
-    std::vector<StructProperty> properties;
-    
-    // Helper to get property by name
-    const StructProperty* get_property(const std::string& name) const {
-        for (const auto& prop : properties) {
-            if (prop.name == name) return &prop;
-        }
-        return nullptr;
-    }
-};
-
 // Mapping configuration for a single struct property
 struct StructPropertyMapping {
     std::string property_path;   // e.g., "Types.Location.Latitude"
+    std::string property_name;   // Last path component, e.g., "Latitude"
     std::string can_signal;       // Source CAN signal
     Transform transform;          // Transformation to apply
     std::vector<std::string> input_signals;  // For multi-signal transforms
@@ -73,7 +50,8 @@ struct StructSignalMapping {
 // Buffer for collecting struct field values
 class StructBuffer {
 public:
-    StructBuffer(const StructType& type, const StructSignalMapping& mapping);
+    StructBuffer(const StructType& type, const StructSignalMapping& mapping,
+                 std::shared_ptr<IClock> clock = default_clock());
     
     // Update a field value
     bool update_field(const std::string& property_name, 
@@ -98,6 +76,7 @@ public:
 private:
     const StructType& type_;
     const StructSignalMapping& mapping_;
+    std::shared_ptr<IClock> clock_;
     
     struct FieldValue {
         std::variant<double, std::string, bool> value;
@@ -115,8 +94,13 @@ public:
     VSSStructMapper();
     ~VSSStructMapper();
     
-    // Load struct type definitions from VSS spec
+    // Clock used for buffer expiry, rate limiting and output timestamps.
+    // Must be set before load_struct_mappings() to affect the buffers.
+    void set_clock(std::shared_ptr<IClock> clock);
+    
+    // Load struct type definitions from a VSS spec (YAML or binary catalogue)
     bool load_struct_types(const std::string& vss_spec_file);
+    bool load_struct_types(const VSSCatalogue& catalogue);
     
     // Load struct mapping configuration
     bool load_struct_mappings(const std::string& mapping_file);
@@ -124,6 +108,10 @@ public:
     // Process CAN signals and update struct buffers
     std::vector<VSSSignal> process_struct_signals(
         const std::vector<std::pair<std::string, double>>& can_signals);
+
+    // Same, appending to out so callers can reuse one output buffer
+    void process_struct_signals(const std::vector<std::pair<std::string, double>>& can_signals,
+                                std::vector<VSSSignal>& out);
     
     // Get struct type definition
     const StructType* get_struct_type(const std::string& type_path) const;
@@ -152,11 +140,12 @@ private:
     // Lua mapper for transformations
     std::unique_ptr<LuaMapper> lua_mapper_;
     
+    std::shared_ptr<IClock> clock_ = default_clock();
+    
     // Last emission times for rate limiting
     std::unordered_map<std::string, std::chrono::steady_clock::time_point> last_emission_times_;
     
     // Helper methods
-    bool parse_vss_struct_types(const std::string& vss_content);
     bool parse_struct_mapping_yaml(const std::string& yaml_content);
     std::variant<double, std::string, bool> apply_transform(
         double can_value, 
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace vssdag {
+
+// Growable FIFO ring buffer (capacity doubles when full, never shrinks)
+template <typename T>
+class RingBuffer {
+public:
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    // Element i positions after the front
+    T& operator[](size_t i) { return buffer_[index(i)]; }
+    const T& operator[](size_t i) const { return buffer_[index(i)]; }
+
+    T& front() { return buffer_[head_]; }
+    const T& front() const { return buffer_[head_]; }
+    T& back() { return buffer_[index(size_ - 1)]; }
+    const T& back() const { return buffer_[index(size_ - 1)]; }
+
+    void push_back(const T& item) {
+        if (size_ == buffer_.size()) {
+            grow();
+        }
+        buffer_[index(size_)] = item;
+        ++size_;
+    }
+
+    void pop_front() {
+        head_ = index(1);
+        --size_;
+    }
+
+    void pop_back() { --size_; }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+private:
+    std::vector<T> buffer_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    size_t index(size_t offset) const { return (head_ + offset) % buffer_.size(); }
+
+    void grow() {
+        std::vector<T> grown(buffer_.empty() ? 8 : buffer_.size() * 2);
+        for (size_t i = 0; i < size_; ++i) {
+            grown[i] = buffer_[index(i)];
+        }
+        buffer_.swap(grown);
+        head_ = 0;
+    }
+};
+
+// Aggregate of the samples in a window
+struct WindowStats {
+    double min = 0.0;
+    double max = 0.0;
+    double sum = 0.0;
+    double last = 0.0;
+    size_t count = 0;
+
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+};
+
+// Sliding window over the samples of the last `span` (time-based) or the
+// last `capacity` samples (count-based). Samples live in a ring buffer;
+// min/max come from monotonic deques, so every operation is O(1) amortized.
+class SlidingWindow {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    explicit SlidingWindow(std::chrono::steady_clock::duration span);
+    explicit SlidingWindow(size_t capacity);
+
+    // Add a sample (timestamps are expected to be non-decreasing)
+    void push(time_point timestamp, double value);
+
+    // Drop samples that have left a time-based window
+    void expire(time_point now);
+
+    // Aggregate of the current window, nullopt if empty
+    std::optional<WindowStats> stats() const;
+
+    size_t size() const { return samples_.size(); }
+
+private:
+    struct Sample {
+        time_point timestamp;
+        double value = 0.0;
+        uint64_t seq = 0;
+    };
+
+    std::chrono::steady_clock::duration span_{};
+    size_t capacity_ = 0;  // 0 for time-based windows
+    uint64_t next_seq_ = 0;
+    double sum_ = 0.0;
+
+    RingBuffer<Sample> samples_;
+    RingBuffer<Sample> min_deque_;  // Increasing values, front is the minimum
+    RingBuffer<Sample> max_deque_;  // Decreasing values, front is the maximum
+
+    void evict_front();
+};
+
+// Tumbling (non-overlapping) window of `span` (time-based, aligned to
+// multiples of span on the steady clock) or of `count` samples. Reports the
+// aggregate of the most recently completed window.
+class TumblingWindow {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    explicit TumblingWindow(std::chrono::steady_clock::duration span);
+    explicit TumblingWindow(size_t count);
+
+    // Close any window that ended at or before timestamp, then add the sample.
+    // Returns true if a window was closed.
+    bool push(time_point timestamp, double value);
+
+    // Close any window that ended at or before now. Returns true if one closed.
+    bool advance(time_point now);
+
+    // Aggregate of the last completed window; nullopt before the first one
+    // closes or if it contained no samples
+    const std::optional<WindowStats>& completed() const { return completed_; }
+
+    // End of the current time-based window (nullopt for count-based windows
+    // or before the first sample)
+    std::optional<time_point> next_boundary() const;
+
+private:
+    std::chrono::steady_clock::duration span_{};
+    size_t count_ = 0;  // 0 for time-based windows
+
+    WindowStats current_;
+    std::optional<WindowStats> completed_;
+    std::optional<time_point> boundary_;
+
+    void add(double value);
+};
+
+} // namespace vssdag
@@ -75,6 +75,7 @@ void SocketCANReader::read_loop() {
 
     should_stop_ = false;
     struct can_frame frame;
+    CANFrame can_frame;  // Reused, so its payload buffer is allocated once
     
     while (!should_stop_) {
         ssize_t nbytes = read(socket_fd_, &frame, sizeof(struct can_frame));
@@ -92,7 +93,6 @@ void SocketCANReader::read_loop() {
         }
 
         if (frame_handler_) {
-            CANFrame can_frame;
             can_frame.id = frame.can_id & CAN_EFF_MASK;
             can_frame.data.assign(frame.data, frame.data + frame.can_dlc);
 
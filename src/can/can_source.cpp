@@ -7,8 +7,23 @@ CANSignalSource::CANSignalSource(const std::string& interface_name,
                                  const std::string& dbc_file_path,
                                  const std::unordered_map<std::string, SignalMapping>& mappings)
     : interface_name_(interface_name)
-    , dbc_file_path_(dbc_file_path)
-    , mappings_(mappings) {
+    , dbc_file_path_(dbc_file_path) {
+    // Only the DBC-sourced names are kept (where source.type == "dbc")
+    for (const auto& [signal_name, mapping] : mappings) {
+        if (mapping.source.type == "dbc") {
+            Symbol dbc_name(mapping.source.name);
+            dbc_signal_names_.push_back(dbc_name);
+            dbc_to_signal_name_.insert_or_assign(dbc_name.view(), signal_name);
+        }
+    }
+}
+
+CANSignalSource::CANSignalSource(const std::string& interface_name,
+                                 const std::string& dbc_file_path,
+                                 const std::unordered_map<std::string, SignalMapping>& mappings,
+                                 std::unique_ptr<CANReader> reader)
+    : CANSignalSource(interface_name, dbc_file_path, mappings) {
+    can_reader_ = std::move(reader);
 }
 
 CANSignalSource::~CANSignalSource() {
@@ -23,17 +38,22 @@ bool CANSignalSource::initialize() {
         return false;
     }
     
-    // Extract DBC signals from mappings (where source.type == "dbc")
-    for (const auto& [signal_name, mapping] : mappings_) {
-        if (mapping.source.type == "dbc") {
-            dbc_signal_names_.push_back(mapping.source.name);
-            dbc_to_signal_name_[mapping.source.name] = signal_name;
+    // Build set of required CAN IDs from DBC signal names
+    std::unordered_set<std::string_view> planned;
+    for (const auto& [can_id, signals] : decode_plan_) {
+        for (const auto& signal : signals) {
+            auto it = dbc_to_signal_name_.find(signal);
+            if (it != dbc_to_signal_name_.end()) {
+                planned.insert(it->first);
+                required_can_ids_.insert(can_id);
+            }
         }
     }
-    
-    // Build set of required CAN IDs from DBC signal names
-    for (const auto& dbc_signal_name : dbc_signal_names_) {
-        auto can_id = dbc_parser_->get_message_id_for_signal(dbc_signal_name);
+    for (Symbol dbc_signal_name : dbc_signal_names_) {
+        if (planned.count(dbc_signal_name.view())) {
+            continue;
+        }
+        auto can_id = dbc_parser_->get_message_id_for_signal(dbc_signal_name.view());
         if (can_id.has_value()) {
             required_can_ids_.insert(can_id.value());
             VLOG(1) << "DBC signal " << dbc_signal_name << " is in CAN message ID: 0x" 
@@ -52,7 +72,9 @@ bool CANSignalSource::initialize() {
               << " CAN message IDs for " << dbc_signal_names_.size() << " DBC signals";
 
     // Create CAN reader
-    can_reader_ = std::make_unique<SocketCANReader>();
+    if (!can_reader_) {
+        can_reader_ = std::make_unique<SocketCANReader>();
+    }
     if (!can_reader_->open(interface_name_)) {
         LOG(ERROR) << "Failed to open CAN interface: " << interface_name_;
         return false;
@@ -72,62 +94,94 @@ bool CANSignalSource::initialize() {
     return true;
 }
 
+void CANSignalSource::enable_poll_decode(size_t frame_capacity) {
+    frame_ring_ = std::make_unique<SpscRing<CANFrame>>(frame_capacity);
+}
+
 void CANSignalSource::handle_can_frame(const CANFrame& frame) {
     // Quick check if we care about this CAN ID
     if (required_can_ids_.find(frame.id) == required_can_ids_.end()) {
         return;
     }
 
+    // Poll-decode mode: hand the raw frame over and get back to the socket
+    if (frame_ring_) {
+        if (!frame_ring_->try_push(frame)) {
+            dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    // Decode on the reader thread and enqueue
+    reader_updates_.clear();
+    decode_frame(frame, std::chrono::steady_clock::now(), reader_updates_);
+    for (auto& update : reader_updates_) {
+        signal_queue_.enqueue(std::move(update));
+    }
+}
+
+void CANSignalSource::decode_frame(const CANFrame& frame, std::chrono::steady_clock::time_point timestamp,
+                                   std::vector<SignalUpdate>& updates) {
     VLOG(3) << "Processing CAN frame ID: 0x" << std::hex << frame.id;
     
     // Decode the frame directly to signal updates
-    auto dbc_updates = dbc_parser_->decode_message_as_updates(
-        frame.id, frame.data.data(), frame.data.size());
+    auto& dbc_updates = dbc_updates_;
+    dbc_updates.clear();
+    dbc_parser_->decode_message_as_updates(frame.id, frame.data.data(), frame.data.size(), dbc_updates);
     
-    // Convert to SignalUpdate and enqueue (only the signals we care about)
-    auto timestamp = std::chrono::steady_clock::now();
+    // Convert to SignalUpdate (only the signals we care about)
     for (const auto& dbc_update : dbc_updates) {
         // Check if this DBC signal is one we need
-        // Note: In C++17 we need to construct a string for the lookup
-        auto it = dbc_to_signal_name_.find(std::string(dbc_update.dbc_signal_name));
+        auto it = dbc_to_signal_name_.find(dbc_update.dbc_signal_name);
         if (it != dbc_to_signal_name_.end()) {
             // Use our signal name (not the DBC name) in the update
-            SignalUpdate update{it->second, dbc_update.value, timestamp, dbc_update.status};
-            signal_queue_.enqueue(std::move(update));
+            updates.push_back(SignalUpdate{it->second, dbc_update.value, timestamp, dbc_update.status});
             
-            // Log with type and status info
-            const char* status_str = (dbc_update.status == vss::types::SignalQuality::VALID) ? "valid" :
-                                    (dbc_update.status == vss::types::SignalQuality::INVALID) ? "invalid" : "not_available";
-            std::string value_str = VSSTypeHelper::to_string(dbc_update.value);
-            VLOG(3) << "Enqueued signal: " << it->second << " (DBC: " << dbc_update.dbc_signal_name
-                    << ") = " << value_str << " (" << status_str << ")";
+            // Log with type and status info (formatting the value allocates)
+            if (VLOG_IS_ON(3)) {
+                const char* status_str = (dbc_update.status == vss::types::SignalQuality::VALID) ? "valid" :
+                                        (dbc_update.status == vss::types::SignalQuality::INVALID) ? "invalid" : "not_available";
+                VLOG(3) << "Decoded signal: " << it->second << " (DBC: " << dbc_update.dbc_signal_name
+                        << ") = " << VSSTypeHelper::to_string(dbc_update.value) << " (" << status_str << ")";
+            }
         }
     }
 }
 
 std::vector<SignalUpdate> CANSignalSource::poll() {
     std::vector<SignalUpdate> updates;
-    SignalUpdate update;
-    
-    // Drain the queue up to a reasonable batch size
-    const size_t max_batch_size = 100;
-    while (updates.size() < max_batch_size && signal_queue_.try_dequeue(update)) {
-        updates.push_back(std::move(update));
+    poll_into(updates);
+    return updates;
+}
+
+void CANSignalSource::poll_into(std::vector<SignalUpdate>& updates) {
+    // Drain the queue up to a reasonable batch size (added to updates)
+    const size_t max_batch_size = updates.size() + 100;
+    if (frame_ring_) {
+        // Decode here, stamped with the time the reader received the frame
+        CANFrame& frame = ring_frame_;
+        while (updates.size() < max_batch_size && frame_ring_->try_pop(frame)) {
+            auto timestamp = std::chrono::steady_clock::time_point(
+                std::chrono::microseconds(frame.timestamp_us));
+            decode_frame(frame, timestamp, updates);
+        }
+    } else {
+        SignalUpdate update;
+        while (updates.size() < max_batch_size && signal_queue_.try_dequeue(update)) {
+            updates.push_back(std::move(update));
+        }
     }
     
     if (!updates.empty()) {
         VLOG(2) << "CANSignalSource::poll() returning " << updates.size() << " updates";
     }
-    
-    return updates;
 }
 
 std::vector<std::string> CANSignalSource::get_exported_signals() const {
     std::vector<std::string> signals;
-    for (const auto& [signal_name, mapping] : mappings_) {
-        if (mapping.source.type == "dbc") {
-            signals.push_back(signal_name);
-        }
+    signals.reserve(dbc_to_signal_name_.size());
+    for (const auto& [dbc_signal_name, signal_name] : dbc_to_signal_name_) {
+        signals.push_back(signal_name.str());
     }
     return signals;
 }
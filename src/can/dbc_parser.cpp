@@ -19,6 +19,7 @@ bool DBCParser::parse() {
     }
 
     try {
+        signal_info_.clear();  // Its keys view names owned by the previous network
         network_ = dbcppp::INetwork::LoadDBCFromIs(file);
         if (!network_) {
             LOG(ERROR) << "Failed to parse DBC file: " << dbc_file_;
@@ -26,7 +27,7 @@ bool DBCParser::parse() {
         }
         
         // Extract signal information and pre-calculate invalid/NA patterns
-        signal_info_.clear();
+        const uint32_t CAN_EFF_MASK = 0x1FFFFFFFU;
         for (const auto& msg : network_->Messages()) {
             for (const auto& sig : msg.Signals()) {
                 SignalInfo info;
@@ -47,6 +48,7 @@ bool DBCParser::parse() {
                 info.na_raw_value = max_possible_raw - 1;
                 info.min_physical = sig.Minimum();
                 info.max_physical = sig.Maximum();
+                info.message_id = msg.Id() & CAN_EFF_MASK;
                 
                 // Check if invalid pattern is usable (outside valid range)
                 double physical_invalid = sig.RawToPhys(info.invalid_raw_value);
@@ -66,7 +68,7 @@ bool DBCParser::parse() {
                         << ", range=[" << std::dec << info.min_physical 
                         << ", " << info.max_physical << "]";
                 
-                signal_info_[sig.Name()] = std::move(info);
+                signal_info_.emplace(sig.Name(), std::move(info));
             }
         }
         
@@ -144,10 +146,15 @@ std::unordered_map<std::string, DBCDecodedValue> DBCParser::decode_message(uint3
 
 std::vector<DBCSignalUpdate> DBCParser::decode_message_as_updates(uint32_t can_id, const uint8_t* data, size_t length) const {
     std::vector<DBCSignalUpdate> updates;
-    
+    decode_message_as_updates(can_id, data, length, updates);
+    return updates;
+}
+
+void DBCParser::decode_message_as_updates(uint32_t can_id, const uint8_t* data, size_t length,
+                                          std::vector<DBCSignalUpdate>& updates) const {
     if (!network_) {
         LOG(ERROR) << "Network not initialized";
-        return updates;
+        return;
     }
 
     // Always strip extended frame flag for comparison
@@ -202,8 +209,6 @@ std::vector<DBCSignalUpdate> DBCParser::decode_message_as_updates(uint32_t can_i
             break;
         }
     }
-    
-    return updates;
 }
 
 bool DBCParser::has_message(uint32_t can_id) const {
@@ -234,7 +239,7 @@ std::vector<std::string> DBCParser::get_signal_names(uint32_t can_id) const {
     return signal_names;
 }
 
-DBCParser::EnumMap DBCParser::get_signal_enums(const std::string& signal_name) const {
+DBCParser::EnumMap DBCParser::get_signal_enums(std::string_view signal_name) const {
     auto it = signal_info_.find(signal_name);
     if (it != signal_info_.end()) {
         return it->second.enums;
@@ -246,31 +251,21 @@ std::unordered_map<std::string, DBCParser::EnumMap> DBCParser::get_all_signal_en
     std::unordered_map<std::string, EnumMap> all_enums;
     for (const auto& [name, info] : signal_info_) {
         if (!info.enums.empty()) {
-            all_enums[name] = info.enums;
+            all_enums[std::string(name)] = info.enums;
         }
     }
     return all_enums;
 }
 
-std::optional<uint32_t> DBCParser::get_message_id_for_signal(const std::string& signal_name) const {
-    if (!network_) {
+std::optional<uint32_t> DBCParser::get_message_id_for_signal(std::string_view signal_name) const {
+    auto it = signal_info_.find(signal_name);
+    if (it == signal_info_.end()) {
         return std::nullopt;
     }
-    
-    for (const auto& msg : network_->Messages()) {
-        for (const auto& sig : msg.Signals()) {
-            if (sig.Name() == signal_name) {
-                // Return the ID with extended flag stripped
-                const uint32_t CAN_EFF_MASK = 0x1FFFFFFFU;
-                return msg.Id() & CAN_EFF_MASK;
-            }
-        }
-    }
-    
-    return std::nullopt;
+    return it->second.message_id;
 }
 
-std::optional<std::string> DBCParser::get_enum_string(const std::string& signal_name, int64_t value) const {
+std::optional<std::string> DBCParser::get_enum_string(std::string_view signal_name, int64_t value) const {
     auto it = signal_info_.find(signal_name);
     if (it == signal_info_.end()) {
         return std::nullopt;
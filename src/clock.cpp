@@ -0,0 +1,43 @@
+#include "vssdag/clock.h"
+
+namespace vssdag {
+
+std::chrono::steady_clock::time_point RealTimeClock::now() const {
+    return std::chrono::steady_clock::now();
+}
+
+std::chrono::system_clock::time_point RealTimeClock::wall_time() const {
+    return std::chrono::system_clock::now();
+}
+
+SimulatedClock::SimulatedClock(std::chrono::system_clock::time_point wall_origin)
+    : wall_origin_(wall_origin) {
+}
+
+std::chrono::system_clock::time_point SimulatedClock::wall_time() const {
+    return wall_origin_ + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        now_.time_since_epoch());
+}
+
+void SimulatedClock::observe_input_time(std::chrono::steady_clock::time_point timestamp) {
+    advance_to(timestamp);
+}
+
+void SimulatedClock::advance_to(std::chrono::steady_clock::time_point timestamp) {
+    if (timestamp > now_) {
+        now_ = timestamp;
+    }
+}
+
+void SimulatedClock::advance_by(std::chrono::steady_clock::duration delta) {
+    if (delta > std::chrono::steady_clock::duration::zero()) {
+        now_ += delta;
+    }
+}
+
+std::shared_ptr<IClock> default_clock() {
+    static std::shared_ptr<IClock> clock = std::make_shared<RealTimeClock>();
+    return clock;
+}
+
+} // namespace vssdag
@@ -0,0 +1,146 @@
+#include "vssdag/dependency_join.h"
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+
+namespace vssdag {
+
+namespace {
+
+std::optional<double> numeric_value(const Value& value) {
+    return std::visit([](auto&& v) -> std::optional<double> {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            return static_cast<double>(v);
+        } else {
+            return std::nullopt;
+        }
+    }, value);
+}
+
+} // namespace
+
+DependencyJoin::DependencyJoin(JoinPolicy policy, std::chrono::milliseconds tolerance,
+                               size_t dependency_count)
+    : policy_(policy),
+      tolerance_(tolerance),
+      history_(dependency_count),
+      consumed_(dependency_count, time_point::min()),
+      aligned_(dependency_count),
+      chosen_(dependency_count, nullptr) {
+}
+
+void DependencyJoin::record(size_t dependency, time_point timestamp, const Value& value,
+                            SignalQuality quality) {
+    auto& history = history_[dependency];
+    if (!history.empty() && timestamp < history.back().timestamp) {
+        return;  // Out of order
+    }
+    history.push_back(Sample{timestamp, value, quality});
+    if (history.size() > kHistorySize) {
+        history.pop_front();
+    }
+}
+
+bool DependencyJoin::align() {
+    for (const auto& history : history_) {
+        if (history.empty()) {
+            return false;
+        }
+    }
+    return policy_ == JoinPolicy::WAIT_ALL ? align_wait_all() : align_interpolate();
+}
+
+bool DependencyJoin::align_wait_all() {
+    // Reference time: the newest sample of any dependency
+    time_point reference = time_point::min();
+    for (const auto& history : history_) {
+        reference = std::max(reference, history.back().timestamp);
+    }
+
+    // Every dependency needs an unused sample close enough to it
+    auto& chosen = chosen_;
+    std::fill(chosen.begin(), chosen.end(), nullptr);
+    for (size_t i = 0; i < history_.size(); ++i) {
+        const auto& history = history_[i];
+        for (size_t k = 0; k < history.size(); ++k) {
+            const Sample& sample = history[k];
+            if (sample.timestamp <= consumed_[i]) {
+                continue;
+            }
+            auto distance = reference - sample.timestamp;  // Never negative
+            if (distance <= tolerance_ &&
+                (!chosen[i] || distance < reference - chosen[i]->timestamp)) {
+                chosen[i] = &sample;
+            }
+        }
+        if (!chosen[i]) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < history_.size(); ++i) {
+        consumed_[i] = chosen[i]->timestamp;
+        aligned_[i] = *chosen[i];
+    }
+    aligned_time_ = reference;
+    return true;
+}
+
+bool DependencyJoin::align_interpolate() {
+    // Latest time covered by every dependency
+    time_point newest = time_point::min();
+    time_point target = time_point::max();
+    for (const auto& history : history_) {
+        newest = std::max(newest, history.back().timestamp);
+        target = std::min(target, history.back().timestamp);
+    }
+
+    // Do not wait for dependencies lagging by more than the tolerance; hold them
+    if (tolerance_ > std::chrono::steady_clock::duration::zero() && newest - target > tolerance_) {
+        target = newest - tolerance_;
+    }
+
+    if (aligned_time_ != time_point::min() && target <= aligned_time_) {
+        return false;
+    }
+
+    for (size_t i = 0; i < history_.size(); ++i) {
+        aligned_[i] = sample_at(i, target);
+    }
+    aligned_time_ = target;
+    return true;
+}
+
+DependencyJoin::Sample DependencyJoin::sample_at(size_t dependency, time_point t) const {
+    const auto& history = history_[dependency];
+
+    // Newest sample at or before t
+    size_t before = history.size();
+    for (size_t k = history.size(); k-- > 0;) {
+        if (history[k].timestamp <= t) {
+            before = k;
+            break;
+        }
+    }
+    if (before == history.size()) {
+        return history.front();  // t precedes the history
+    }
+    const Sample& s0 = history[before];
+    if (before + 1 == history.size() || s0.timestamp == t) {
+        return s0;  // Hold
+    }
+
+    const Sample& s1 = history[before + 1];
+    auto v0 = numeric_value(s0.value);
+    auto v1 = numeric_value(s1.value);
+    if (!v0 || !v1 || s0.quality != SignalQuality::VALID || s1.quality != SignalQuality::VALID) {
+        return s0;
+    }
+
+    double fraction = std::chrono::duration<double>(t - s0.timestamp).count() /
+                      std::chrono::duration<double>(s1.timestamp - s0.timestamp).count();
+    return Sample{t, *v0 + fraction * (*v1 - *v0), SignalQuality::VALID};
+}
+
+} // namespace vssdag
@@ -0,0 +1,42 @@
+#include "vssdag/hysteresis.h"
+
+namespace vssdag {
+
+Hysteresis::Result Hysteresis::update(time_point now, std::optional<double> value, const Config& config) {
+    Result result;
+    result.changed = !initialized_;
+    initialized_ = true;
+
+    if (!value) {
+        pending_ = false;
+        result.state = state_;
+        return result;
+    }
+
+    bool rising = config.on >= config.off;
+    bool candidate = state_
+        ? !(rising ? *value < config.off : *value > config.off)
+        : (rising ? *value >= config.on : *value <= config.on);
+
+    if (candidate == state_) {
+        pending_ = false;  // Condition no longer holds, restart debounce
+    } else {
+        if (!pending_) {
+            pending_ = true;
+            pending_since_ = now;
+        }
+        auto debounce = candidate ? config.on_debounce : config.off_debounce;
+        if (now - pending_since_ >= debounce) {
+            state_ = candidate;
+            pending_ = false;
+            result.changed = true;
+        } else {
+            result.wake_at = pending_since_ + debounce;
+        }
+    }
+
+    result.state = state_;
+    return result;
+}
+
+} // namespace vssdag
@@ -0,0 +1,36 @@
+#include "vssdag/integrator.h"
+
+namespace vssdag {
+
+double Integrator::add(time_point timestamp, double value, duration max_gap) {
+    if (has_last_) {
+        if (timestamp < last_time_) {
+            return total_;  // Out of order
+        }
+
+        auto gap = timestamp - last_time_;
+        if (gap <= max_gap) {
+            double dt = std::chrono::duration<double>(gap).count();
+            double area = 0.5 * (last_value_ + value) * dt;
+
+            // Kahan summation
+            double y = area - compensation_;
+            double t = total_ + y;
+            compensation_ = (t - total_) - y;
+            total_ = t;
+        }
+    }
+
+    has_last_ = true;
+    last_time_ = timestamp;
+    last_value_ = value;
+    return total_;
+}
+
+void Integrator::reset(double total) {
+    total_ = total;
+    compensation_ = 0.0;
+    has_last_ = false;
+}
+
+} // namespace vssdag
@@ -0,0 +1,123 @@
+#include "vssdag/lookup_table.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+
+namespace vssdag {
+
+bool LookupAxis::build(const std::vector<double>& points) {
+    if (points.size() < 2) {
+        return false;
+    }
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (!(points[i] > points[i - 1])) {
+            return false;
+        }
+    }
+
+    points_ = points;
+    origin_ = points.front();
+
+    // Uniform if every step matches the mean step up to rounding
+    double step = (points.back() - points.front()) / (points.size() - 1);
+    double tolerance = 1e-9 * (points.back() - points.front());
+    uniform_ = true;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (std::abs(points[i] - (origin_ + i * step)) > tolerance) {
+            uniform_ = false;
+            break;
+        }
+    }
+    inv_step_ = 1.0 / step;
+    return true;
+}
+
+void LookupAxis::locate(double value, size_t& index, double& fraction) const {
+    const size_t last_segment = points_.size() - 2;
+
+    if (!(value > points_.front())) {  // Also catches NaN
+        index = 0;
+        fraction = 0.0;
+        return;
+    }
+    if (value >= points_.back()) {
+        index = last_segment;
+        fraction = 1.0;
+        return;
+    }
+
+    if (uniform_) {
+        double position = (value - origin_) * inv_step_;
+        index = std::min(static_cast<size_t>(position), last_segment);
+        fraction = position - index;
+    } else {
+        auto it = std::upper_bound(points_.begin(), points_.end(), value);
+        index = static_cast<size_t>(it - points_.begin()) - 1;
+        fraction = (value - points_[index]) / (points_[index + 1] - points_[index]);
+    }
+}
+
+std::optional<LookupTable> LookupTable::compile(const std::string& name, const LookupTableSpec& spec) {
+    LookupTable table;
+
+    if (!table.x_axis_.build(spec.x)) {
+        LOG(ERROR) << "Lookup table '" << name << "': x needs at least two strictly increasing points";
+        return std::nullopt;
+    }
+
+    if (spec.z.empty()) {
+        // 1D table: x -> y
+        if (spec.y.size() != spec.x.size()) {
+            LOG(ERROR) << "Lookup table '" << name << "': x has " << spec.x.size()
+                       << " points but y has " << spec.y.size();
+            return std::nullopt;
+        }
+        table.values_ = spec.y;
+        return table;
+    }
+
+    // 2D table: (x, y) -> z
+    if (!table.y_axis_.build(spec.y)) {
+        LOG(ERROR) << "Lookup table '" << name << "': y needs at least two strictly increasing points";
+        return std::nullopt;
+    }
+    if (spec.z.size() != spec.y.size()) {
+        LOG(ERROR) << "Lookup table '" << name << "': z has " << spec.z.size()
+                   << " rows but y has " << spec.y.size() << " points";
+        return std::nullopt;
+    }
+    table.values_.reserve(spec.x.size() * spec.y.size());
+    for (const auto& row : spec.z) {
+        if (row.size() != spec.x.size()) {
+            LOG(ERROR) << "Lookup table '" << name << "': z row has " << row.size()
+                       << " columns but x has " << spec.x.size() << " points";
+            return std::nullopt;
+        }
+        table.values_.insert(table.values_.end(), row.begin(), row.end());
+    }
+    table.is_2d_ = true;
+    return table;
+}
+
+double LookupTable::evaluate(double x) const {
+    size_t i;
+    double t;
+    x_axis_.locate(x, i, t);
+    return values_[i] + t * (values_[i + 1] - values_[i]);
+}
+
+double LookupTable::evaluate(double x, double y) const {
+    size_t col, row;
+    double tx, ty;
+    x_axis_.locate(x, col, tx);
+    y_axis_.locate(y, row, ty);
+
+    const size_t width = x_axis_.size();
+    const double* lower = &values_[row * width + col];
+    const double* upper = lower + width;
+    double z_lower = lower[0] + tx * (lower[1] - lower[0]);
+    double z_upper = upper[0] + tx * (upper[1] - upper[0]);
+    return z_lower + ty * (z_upper - z_lower);
+}
+
+} // namespace vssdag
@@ -1,16 +1,44 @@
 #include "vssdag/lua_mapper.h"
 #include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <sstream>
 #include <optional>
 
 namespace vssdag {
 
-LuaMapper::LuaMapper() {
-    L_ = luaL_newstate();
+namespace {
+
+// Blocks up to this size are pooled; larger ones (big tables, chunk
+// sources) go straight to the upstream resource
+std::pmr::pool_options lua_pool_options() {
+    std::pmr::pool_options options;
+    options.largest_required_pool_block = 64 * 1024;
+    return options;
+}
+
+// Status at index (STATUS_* integer); anything else counts as VALID
+SignalQuality quality_at(lua_State* L, int index) {
+    if (lua_isinteger(L, index)) {
+        return static_cast<SignalQuality>(lua_tointeger(L, index));
+    }
+    if (lua_isnumber(L, index)) {
+        return static_cast<SignalQuality>(static_cast<int>(lua_tonumber(L, index)));
+    }
+    return SignalQuality::VALID;
+}
+
+} // namespace
+
+LuaMapper::LuaMapper(std::pmr::memory_resource* upstream)
+    : lua_pool_(lua_pool_options(), upstream ? upstream : std::pmr::get_default_resource()) {
+    L_ = lua_newstate(&LuaMapper::lua_alloc, &lua_pool_);
     if (!L_) {
         LOG(ERROR) << "Failed to create Lua state";
         return;
     }
+    lua_atpanic(L_, &LuaMapper::lua_panic);
     
     luaL_openlibs(L_);
     
@@ -29,6 +57,36 @@ LuaMapper::~LuaMapper() {
     }
 }
 
+void* LuaMapper::lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    auto* pool = static_cast<std::pmr::memory_resource*>(ud);
+    if (nsize == 0) {
+        if (ptr) {
+            pool->deallocate(ptr, osize);
+        }
+        return nullptr;
+    }
+
+    // For a new object osize is a type tag, not a size
+    void* block;
+    try {
+        block = pool->allocate(nsize);
+    } catch (const std::bad_alloc&) {
+        // Lua expects shrinking to succeed
+        return (ptr && nsize <= osize) ? ptr : nullptr;
+    }
+    if (ptr) {
+        std::memcpy(block, ptr, std::min(osize, nsize));
+        pool->deallocate(ptr, osize);
+    }
+    return block;
+}
+
+int LuaMapper::lua_panic(lua_State* L) {
+    const char* msg = lua_tostring(L, -1);
+    LOG(ERROR) << "Unprotected Lua error: " << (msg ? msg : "(error object is not a string)");
+    return 0;  // Lua aborts
+}
+
 bool LuaMapper::load_mapping_file(const std::string& lua_file) {
     if (!L_) {
         LOG(ERROR) << "Lua state not initialized";
@@ -127,106 +185,51 @@ bool LuaMapper::execute_mapping_function() {
     return true;
 }
 
-VSSSignal LuaMapper::extract_vss_signal(int index) {
+VSSSignal LuaMapper::extract_vss_signal(int index, const ValueCodec* codec) {
     VSSSignal signal;
 
     if (!lua_istable(L_, index)) {
         return signal;
     }
+    index = lua_absindex(L_, index);
 
     // Get path
     lua_getfield(L_, index, "path");
     if (lua_isstring(L_, -1)) {
-        signal.path = lua_tostring(L_, -1);
+        size_t len = 0;
+        const char* path = lua_tolstring(L_, -1, &len);
+        signal.path = Symbol(std::string_view(path, len));
     }
     lua_pop(L_, 1);
 
-    // Get value type (stored as integer ValueType enum)
-    ValueType value_type = ValueType::DOUBLE;  // Default
-    lua_getfield(L_, index, "type");
-    if (lua_isinteger(L_, -1)) {
-        value_type = static_cast<ValueType>(lua_tointeger(L_, -1));
-    } else if (lua_isnumber(L_, -1)) {
-        value_type = static_cast<ValueType>(static_cast<int>(lua_tonumber(L_, -1)));
+    // Without a node codec, the value type comes from the table (ValueType enum)
+    if (!codec) {
+        ValueType value_type = ValueType::DOUBLE;  // Default
+        lua_getfield(L_, index, "type");
+        if (lua_isinteger(L_, -1)) {
+            value_type = static_cast<ValueType>(lua_tointeger(L_, -1));
+        } else if (lua_isnumber(L_, -1)) {
+            value_type = static_cast<ValueType>(static_cast<int>(lua_tonumber(L_, -1)));
+        }
+        lua_pop(L_, 1);
+        codec = &value_codec(value_type);
     }
-    lua_pop(L_, 1);
 
-    // Get value and convert to appropriate VSS Value type based on enum
+    // Get value as the declared type
     lua_getfield(L_, index, "value");
-    if (lua_type(L_, -1) == LUA_TNUMBER) {
-        // Use the ValueType enum to determine the correct C++ type
-        switch (value_type) {
-            case ValueType::FLOAT:
-                signal.qualified_value.value = static_cast<float>(lua_tonumber(L_, -1));
-                break;
-            case ValueType::DOUBLE:
-                signal.qualified_value.value = lua_tonumber(L_, -1);
-                break;
-            case ValueType::INT8:
-                signal.qualified_value.value = static_cast<int8_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::INT16:
-                signal.qualified_value.value = static_cast<int16_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::INT32:
-                signal.qualified_value.value = static_cast<int32_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::INT64:
-                signal.qualified_value.value = static_cast<int64_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::UINT8:
-                signal.qualified_value.value = static_cast<uint8_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::UINT16:
-                signal.qualified_value.value = static_cast<uint16_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::UINT32:
-                signal.qualified_value.value = static_cast<uint32_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::UINT64:
-                signal.qualified_value.value = static_cast<uint64_t>(lua_tointeger(L_, -1));
-                break;
-            default:
-                // For unrecognized types, default to double
-                signal.qualified_value.value = lua_tonumber(L_, -1);
-                break;
-        }
-    } else if (lua_type(L_, -1) == LUA_TBOOLEAN) {
-        signal.qualified_value.value = static_cast<bool>(lua_toboolean(L_, -1));
-    } else if (lua_type(L_, -1) == LUA_TSTRING) {
-        signal.qualified_value.value = std::string(lua_tostring(L_, -1));
-    } else if (lua_type(L_, -1) == LUA_TTABLE) {
-        // Handle struct values (Lua tables)
-        if (value_type == ValueType::STRUCT || value_type == ValueType::STRUCT_ARRAY) {
-            // Convert Lua table to VSS struct with proper type handling
-            signal.qualified_value.value = VSSTypeHelper::from_lua_table_typed(L_, -1, value_type);
-        } else {
-            // Unknown table type, use empty monostate
-            signal.qualified_value.value = std::monostate{};
-        }
-    } else if (lua_type(L_, -1) == LUA_TNIL) {
-        // For nil values, use empty monostate
-        signal.qualified_value.value = std::monostate{};
-    }
+    VLOG(3) << "[extract_vss_signal] Signal: " << signal.path
+            << ", ValueType enum: " << static_cast<int>(codec->type)
+            << ", Lua type: " << lua_typename(L_, lua_type(L_, -1));
+    signal.qualified_value.value = codec->pull_lua(L_, -1);
     lua_pop(L_, 1);
 
     // Get quality (formerly status)
     lua_getfield(L_, index, "status");
-    if (lua_isinteger(L_, -1)) {
-        int status_val = lua_tointeger(L_, -1);
-        signal.qualified_value.quality = static_cast<SignalQuality>(status_val);
-    } else if (lua_isnumber(L_, -1)) {
-        // Handle as number if not specifically integer
-        int status_val = static_cast<int>(lua_tonumber(L_, -1));
-        signal.qualified_value.quality = static_cast<SignalQuality>(status_val);
-    } else {
-        // Default to valid if no status field or wrong type
-        signal.qualified_value.quality = SignalQuality::VALID;
-    }
+    signal.qualified_value.quality = quality_at(L_, -1);
     lua_pop(L_, 1);
 
     // Set timestamp to current time
-    signal.qualified_value.timestamp = std::chrono::system_clock::now();
+    signal.qualified_value.timestamp = clock_->wall_time();
 
     return signal;
 }
@@ -246,7 +249,64 @@ bool LuaMapper::execute_lua_string(const std::string& lua_code) {
     return true;
 }
 
-std::optional<VSSSignal> LuaMapper::call_transform_function(const std::string& signal_name, double value) {
+bool LuaMapper::execute_lua_string(const std::string& lua_code, const std::string& chunk_name) {
+    if (!L_) {
+        LOG(ERROR) << "Lua state not initialized";
+        return false;
+    }
+    
+    std::string name = "=" + chunk_name;
+    if (luaL_loadbuffer(L_, lua_code.data(), lua_code.size(), name.c_str()) != LUA_OK ||
+        lua_pcall(L_, 0, LUA_MULTRET, 0) != LUA_OK) {
+        LOG(ERROR) << "Failed to execute Lua code: " << lua_tostring(L_, -1);
+        lua_pop(L_, 1);
+        return false;
+    }
+    
+    return true;
+}
+
+bool LuaMapper::compile_lua_string(const std::string& lua_code, const std::string& chunk_name,
+                                   std::string& bytecode) {
+    if (!L_) {
+        LOG(ERROR) << "Lua state not initialized";
+        return false;
+    }
+
+    std::string name = "=" + chunk_name;
+    if (luaL_loadbuffer(L_, lua_code.data(), lua_code.size(), name.c_str()) != LUA_OK) {
+        LOG(ERROR) << "Failed to compile Lua code: " << lua_tostring(L_, -1);
+        lua_pop(L_, 1);
+        return false;
+    }
+    auto writer = [](lua_State*, const void* data, size_t size, void* out) {
+        static_cast<std::string*>(out)->append(static_cast<const char*>(data), size);
+        return 0;
+    };
+    lua_dump(L_, writer, &bytecode, 0);  // Debug info kept for error messages
+    lua_pop(L_, 1);
+    return true;
+}
+
+bool LuaMapper::execute_lua_bytecode(const std::string& bytecode, const std::string& chunk_name) {
+    if (!L_) {
+        LOG(ERROR) << "Lua state not initialized";
+        return false;
+    }
+
+    std::string name = "=" + chunk_name;
+    if (luaL_loadbufferx(L_, bytecode.data(), bytecode.size(), name.c_str(), "b") != LUA_OK ||
+        lua_pcall(L_, 0, LUA_MULTRET, 0) != LUA_OK) {
+        LOG(ERROR) << "Failed to execute Lua bytecode: " << lua_tostring(L_, -1);
+        lua_pop(L_, 1);
+        return false;
+    }
+
+    return true;
+}
+
+std::optional<VSSSignal> LuaMapper::call_transform_function(const std::string& signal_name, double value,
+                                                            const ValueCodec* codec) {
     if (!L_) {
         LOG(ERROR) << "Lua state not initialized";
         return std::nullopt;
@@ -275,128 +335,71 @@ std::optional<VSSSignal> LuaMapper::call_transform_function(const std::string& s
         return std::nullopt;
     }
     
-    auto result = extract_vss_signal_from_stack();
+    auto result = extract_vss_signal_from_stack(codec);
     lua_pop(L_, 1);
     
     return result;
 }
 
-std::optional<VSSSignal> LuaMapper::extract_vss_signal_from_stack() {
-    if (!lua_istable(L_, -1)) {
+std::optional<VSSSignal> LuaMapper::call_transform_values(const std::string& signal_name, double value,
+                                                          const Symbol& path, const ValueCodec& codec) {
+    if (!L_) {
+        LOG(ERROR) << "Lua state not initialized";
         return std::nullopt;
     }
 
-    VSSSignal signal;
-
-    // Get path
-    lua_getfield(L_, -1, "path");
-    if (lua_isstring(L_, -1)) {
-        signal.path = lua_tostring(L_, -1);
+    lua_getglobal(L_, "process_signal");
+    if (!lua_isfunction(L_, -1)) {
+        LOG(ERROR) << "process_signal function not found";
+        lua_pop(L_, 1);
+        return std::nullopt;
     }
-    lua_pop(L_, 1);
 
-    if (signal.path.empty()) {
+    lua_pushstring(L_, signal_name.c_str());
+    lua_pushnumber(L_, value);
+
+    if (lua_pcall(L_, 2, 2, 0) != LUA_OK) {
+        LOG(ERROR) << "Error calling process_signal: " << lua_tostring(L_, -1);
+        lua_pop(L_, 1);
         return std::nullopt;
     }
 
-    // Get value type (stored as integer ValueType enum)
-    ValueType value_type = ValueType::DOUBLE;  // Default
-    lua_getfield(L_, -1, "type");
-    if (lua_isinteger(L_, -1)) {
-        value_type = static_cast<ValueType>(lua_tointeger(L_, -1));
-    } else if (lua_isnumber(L_, -1)) {
-        value_type = static_cast<ValueType>(static_cast<int>(lua_tonumber(L_, -1)));
+    // No status: the transform has nothing to publish
+    if (lua_isnil(L_, -1)) {
+        lua_pop(L_, 2);
+        return std::nullopt;
     }
-    lua_pop(L_, 1);
 
-    // Get value and convert to appropriate VSS Value type based on enum
-    lua_getfield(L_, -1, "value");
-    int lua_value_type = lua_type(L_, -1);
-    LOG(INFO) << "[extract_vss_signal] Signal: " << signal.path
-              << ", ValueType enum: " << static_cast<int>(value_type)
-              << ", Lua type: " << lua_value_type
-              << " (0=nil,1=boolean,2=lightuserdata,3=number,4=string,5=table,6=function,7=userdata,8=thread)";
-
-    if (lua_value_type == LUA_TNUMBER) {
-        // Use the ValueType enum to determine the correct C++ type
-        switch (value_type) {
-            case ValueType::BOOL:
-                // Boolean stored as number in Lua (1=true, 0=false) - convert back
-                LOG(INFO) << "[extract_vss_signal] Converting Lua number to C++ bool (number value: " << lua_tonumber(L_, -1) << ")";
-                signal.qualified_value.value = static_cast<bool>(lua_tointeger(L_, -1) != 0);
-                break;
-            case ValueType::FLOAT:
-                signal.qualified_value.value = static_cast<float>(lua_tonumber(L_, -1));
-                break;
-            case ValueType::DOUBLE:
-                signal.qualified_value.value = lua_tonumber(L_, -1);
-                break;
-            case ValueType::INT8:
-                signal.qualified_value.value = static_cast<int8_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::INT16:
-                signal.qualified_value.value = static_cast<int16_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::INT32:
-                signal.qualified_value.value = static_cast<int32_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::INT64:
-                signal.qualified_value.value = static_cast<int64_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::UINT8:
-                signal.qualified_value.value = static_cast<uint8_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::UINT16:
-                signal.qualified_value.value = static_cast<uint16_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::UINT32:
-                signal.qualified_value.value = static_cast<uint32_t>(lua_tointeger(L_, -1));
-                break;
-            case ValueType::UINT64:
-                signal.qualified_value.value = static_cast<uint64_t>(lua_tointeger(L_, -1));
-                break;
-            default:
-                // For unrecognized types, default to double
-                signal.qualified_value.value = lua_tonumber(L_, -1);
-                break;
-        }
-    } else if (lua_value_type == LUA_TBOOLEAN) {
-        signal.qualified_value.value = static_cast<bool>(lua_toboolean(L_, -1));
-    } else if (lua_value_type == LUA_TSTRING) {
-        signal.qualified_value.value = std::string(lua_tostring(L_, -1));
-    } else if (lua_type(L_, -1) == LUA_TTABLE) {
-        // Handle struct values (Lua tables)
-        if (value_type == ValueType::STRUCT || value_type == ValueType::STRUCT_ARRAY) {
-            // Convert Lua table to VSS struct with proper type handling
-            signal.qualified_value.value = VSSTypeHelper::from_lua_table_typed(L_, -1, value_type);
-        } else {
-            // Unknown table type, use empty monostate
-            signal.qualified_value.value = std::monostate{};
-        }
-    } else if (lua_type(L_, -1) == LUA_TNIL) {
-        // For nil values, use empty monostate
-        signal.qualified_value.value = std::monostate{};
-    }
-    lua_pop(L_, 1);
+    VSSSignal signal;
+    signal.path = path;
+    auto& qualified = signal.qualified_value;
+    qualified.value = codec.pull_lua(L_, -2);
+    qualified.quality = quality_at(L_, -1);
+    if (qualified.quality == SignalQuality::VALID && lua_isnil(L_, -2)) {
+        qualified.quality = SignalQuality::INVALID;
+    }
+    lua_pop(L_, 2);
 
-    // Get quality (formerly status)
-    lua_getfield(L_, -1, "status");
-    if (lua_isinteger(L_, -1)) {
-        int status_val = lua_tointeger(L_, -1);
-        signal.qualified_value.quality = static_cast<SignalQuality>(status_val);
-    } else if (lua_isnumber(L_, -1)) {
-        // Handle as number if not specifically integer
-        int status_val = static_cast<int>(lua_tonumber(L_, -1));
-        signal.qualified_value.quality = static_cast<SignalQuality>(status_val);
-    } else {
-        // Default to valid if no status field or wrong type
-        signal.qualified_value.quality = SignalQuality::VALID;
+    // Floating point noise around zero is published as 0
+    if (auto* d = std::get_if<double>(&qualified.value); d && std::abs(*d) < 1e-6) {
+        *d = 0.0;
+    } else if (auto* f = std::get_if<float>(&qualified.value); f && std::abs(*f) < 1e-6f) {
+        *f = 0.0f;
     }
-    lua_pop(L_, 1);
 
-    // Set timestamp to current time
-    signal.qualified_value.timestamp = std::chrono::system_clock::now();
+    qualified.timestamp = clock_->wall_time();
+    return signal;
+}
+
+std::optional<VSSSignal> LuaMapper::extract_vss_signal_from_stack(const ValueCodec* codec) {
+    if (!lua_istable(L_, -1)) {
+        return std::nullopt;
+    }
 
+    VSSSignal signal = extract_vss_signal(-1, codec);
+    if (signal.path.empty()) {
+        return std::nullopt;
+    }
     return signal;
 }
 
@@ -0,0 +1,781 @@
+#include "vssdag/mapping_loader.h"
+#include <glog/logging.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "vssdag/binary_io.h"
+#include "vssdag/lookup_table.h"
+
+namespace vssdag {
+
+namespace {
+
+constexpr char kCompiledMagic[8] = {'V', 'S', 'S', 'D', 'A', 'G', 'C', '1'};
+constexpr uint32_t kCompiledVersion = 5;
+
+bool parse_priority(const std::string& text, Priority& priority) {
+    if (text == "low") {
+        priority = Priority::LOW;
+    } else if (text == "normal") {
+        priority = Priority::NORMAL;
+    } else if (text == "high") {
+        priority = Priority::HIGH;
+    } else if (text == "critical") {
+        priority = Priority::CRITICAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parse_join_policy(const std::string& text, JoinPolicy& policy) {
+    if (text == "latest") {
+        policy = JoinPolicy::LATEST;
+    } else if (text == "wait_all") {
+        policy = JoinPolicy::WAIT_ALL;
+    } else if (text == "interpolate") {
+        policy = JoinPolicy::INTERPOLATE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parse_update_trigger(const std::string& text, UpdateTrigger& trigger) {
+    if (text == "on_dependency") {
+        trigger = UpdateTrigger::ON_DEPENDENCY;
+    } else if (text == "periodic") {
+        trigger = UpdateTrigger::PERIODIC;
+    } else if (text == "both") {
+        trigger = UpdateTrigger::BOTH;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parse_resample_method(const std::string& text, ResampleMethod& method) {
+    if (text == "hold") {
+        method = ResampleMethod::HOLD;
+    } else if (text == "linear") {
+        method = ResampleMethod::LINEAR;
+    } else if (text == "mean") {
+        method = ResampleMethod::MEAN;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parse_mapping(const YAML::Node& node, const std::string& signal_name, SignalMapping& mapping) {
+    if (node["source"]) {
+        const auto& source_node = node["source"];
+        mapping.source.type = source_node["type"].as<std::string>();
+        mapping.source.name = source_node["name"].as<std::string>();
+    }
+
+    // Datatype - no default, must be specified
+    if (node["datatype"]) {
+        std::string datatype = node["datatype"].as<std::string>();
+        auto type = value_type_from_string(datatype);
+        if (!type) {
+            LOG(ERROR) << "Unknown datatype '" << datatype << "' for signal " << signal_name;
+            return false;
+        }
+        mapping.datatype = *type;
+    } else {
+        LOG(WARNING) << "No datatype specified for signal " << signal_name << ", using UNSPECIFIED";
+    }
+
+    mapping.interval_ms = node["interval_ms"].as<int>(0);
+    mapping.history_size = node["history"].as<int>(0);
+    mapping.max_instructions = node["max_instructions"].as<uint64_t>(0);
+    if (mapping.interval_ms < 0 || mapping.history_size < 0) {
+        LOG(ERROR) << "interval_ms and history must not be negative for signal " << signal_name;
+        return false;
+    }
+
+    std::string priority = node["priority"].as<std::string>("normal");
+    if (!parse_priority(priority, mapping.priority)) {
+        LOG(ERROR) << "Unknown priority '" << priority << "' for signal " << signal_name;
+        return false;
+    }
+
+    if (mapping.datatype == ValueType::STRUCT) {
+        mapping.is_struct = true;
+        mapping.struct_type = node["struct_type"].as<std::string>("");
+    }
+
+    for (const auto& dep : node["depends_on"]) {
+        mapping.depends_on.push_back(dep.as<std::string>());
+    }
+
+    if (node["join"]) {
+        const auto& join_node = node["join"];
+        std::string policy = join_node["policy"].as<std::string>("latest");
+        if (!parse_join_policy(policy, mapping.join_policy)) {
+            LOG(ERROR) << "Unknown join policy '" << policy << "' for signal " << signal_name;
+            return false;
+        }
+        mapping.join_tolerance_ms = join_node["tolerance_ms"].as<int>(0);
+    }
+
+    // Calibration tables for lookup(name, x [, y])
+    for (const auto& table_node : node["lookup_tables"]) {
+        std::string table_name = table_node.first.as<std::string>();
+        LookupTableSpec spec;
+        spec.x = table_node.second["x"].as<std::vector<double>>();
+        spec.y = table_node.second["y"].as<std::vector<double>>();
+        if (table_node.second["z"]) {
+            spec.z = table_node.second["z"].as<std::vector<std::vector<double>>>();
+        }
+        if (!LookupTable::compile(signal_name + "." + table_name, spec)) {
+            return false;
+        }
+        mapping.lookup_tables[table_name] = std::move(spec);
+    }
+
+    if (node["transform"]) {
+        const YAML::Node& transform = node["transform"];
+        if (transform["code"]) {
+            mapping.transform = CodeTransform{transform["code"].as<std::string>(),
+                                              transform["coroutine"].as<bool>(false)};
+        } else if (transform["math"]) {
+            // Keep backward compatibility
+            mapping.transform = CodeTransform{transform["math"].as<std::string>()};
+        } else if (transform["mapping"]) {
+            ValueMapping value_map;
+            for (const auto& item : transform["mapping"]) {
+                value_map.mappings[item["from"].as<std::string>()] = item["to"].as<std::string>();
+            }
+            mapping.transform = value_map;
+        }
+    }
+
+    if (node["update_trigger"]) {
+        std::string trigger = node["update_trigger"].as<std::string>();
+        if (!parse_update_trigger(trigger, mapping.update_trigger)) {
+            LOG(ERROR) << "Unknown update_trigger '" << trigger << "' for signal " << signal_name;
+            return false;
+        }
+    }
+    if (mapping.update_trigger != UpdateTrigger::ON_DEPENDENCY && mapping.interval_ms <= 0) {
+        LOG(ERROR) << "Periodic signal " << signal_name << " needs a positive interval_ms";
+        return false;
+    }
+    return true;
+}
+
+bool parse_resample_group(const YAML::Node& node, ResampleGroup& group) {
+    group.name = node["name"].as<std::string>("");
+    group.period_ms = node["period_ms"].as<int>(100);
+    group.delay_ms = node["delay_ms"].as<int>(0);
+    for (const auto& column_node : node["signals"]) {
+        ResampleColumn column;
+        column.signal = column_node["signal"].as<std::string>();
+        std::string method = column_node["method"].as<std::string>("hold");
+        if (!parse_resample_method(method, column.method)) {
+            LOG(ERROR) << "Unknown resample method '" << method << "' in group " << group.name;
+            return false;
+        }
+        group.columns.push_back(column);
+    }
+    return true;
+}
+
+// Replace every "{variable}" in text with value
+std::string substitute(const std::string& text, const std::string& variable, int64_t value) {
+    std::string placeholder = "{" + variable + "}";
+    std::string replacement = std::to_string(value);
+    std::string result = text;
+    for (size_t pos = result.find(placeholder); pos != std::string::npos;
+         pos = result.find(placeholder, pos + replacement.size())) {
+        result.replace(pos, placeholder.size(), replacement);
+    }
+    return result;
+}
+
+// Expand a `for: "<variable> in <first>..<last>"` mapping. "{variable}" is
+// substituted in the signal name, source name, dependencies and struct
+// fields; the transform is shared and sees the index as a Lua variable.
+bool expand_template(const YAML::Node& node, const std::string& pattern,
+                     std::unordered_map<std::string, SignalMapping>& mappings) {
+    static const std::regex kForPattern(R"(^\s*([A-Za-z_]\w*)\s+in\s+(-?\d+)\s*\.\.\s*(-?\d+)\s*$)");
+    std::string spec = node["for"].as<std::string>();
+    std::smatch match;
+    if (!std::regex_match(spec, match, kForPattern)) {
+        LOG(ERROR) << "Invalid template range '" << spec << "' for " << pattern
+                   << " (expected \"<variable> in <first>..<last>\")";
+        return false;
+    }
+    std::string variable = match[1];
+    int64_t first = std::stoll(match[2]);
+    int64_t last = std::stoll(match[3]);
+    if (first > last) {
+        LOG(ERROR) << "Empty template range '" << spec << "' for " << pattern;
+        return false;
+    }
+    if (pattern.find("{" + variable + "}") == std::string::npos) {
+        LOG(ERROR) << "Template signal " << pattern << " does not use {" << variable << "}";
+        return false;
+    }
+
+    SignalMapping base;
+    if (!parse_mapping(node, pattern, base)) {
+        return false;
+    }
+    auto tmpl = std::make_shared<MappingTemplate>();
+    tmpl->name = pattern;
+    tmpl->variable = variable;
+    tmpl->transform = std::move(base.transform);
+    base.transform = DirectMapping{};
+    base.instance_of = tmpl;
+
+    for (int64_t i = first; i <= last; ++i) {
+        SignalMapping mapping = base;
+        mapping.template_index = i;
+        mapping.source.name = substitute(base.source.name, variable, i);
+        for (auto& dep : mapping.depends_on) {
+            dep = substitute(dep, variable, i);
+        }
+        mapping.struct_type = substitute(base.struct_type, variable, i);
+        mapping.struct_field = substitute(base.struct_field, variable, i);
+
+        std::string signal_name = substitute(pattern, variable, i);
+        if (!mappings.emplace(signal_name, std::move(mapping)).second) {
+            LOG(ERROR) << "Duplicate mapping for signal " << signal_name;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Cross-mapping checks that need the complete signal set
+bool validate(const MappingConfig& config) {
+    for (const auto& [name, mapping] : config.mappings) {
+        for (const auto& dep : mapping.depends_on) {
+            if (!config.mappings.count(dep)) {
+                LOG(ERROR) << "Signal " << name << " depends on undeclared signal " << dep;
+                return false;
+            }
+        }
+    }
+    for (const auto& group : config.resample_groups) {
+        if (group.period_ms <= 0 || group.delay_ms < 0) {
+            LOG(ERROR) << "Resample group " << group.name << " needs a positive period_ms";
+            return false;
+        }
+        for (const auto& column : group.columns) {
+            if (!config.mappings.count(column.signal)) {
+                LOG(ERROR) << "Resample group " << group.name << " uses undeclared signal "
+                           << column.signal;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Enum stored as a Tag; false for values past last
+template <typename Tag, typename Enum>
+bool read_enum(BinaryReader& in, Enum last, Enum& value) {
+    Tag tag = in.get<Tag>();
+    if (tag > static_cast<Tag>(last)) {
+        return false;
+    }
+    value = static_cast<Enum>(tag);
+    return true;
+}
+
+void write_transform(BinaryWriter& out, const Transform& transform) {
+    out.put<uint8_t>(static_cast<uint8_t>(transform.index()));
+    if (const auto* code = std::get_if<CodeTransform>(&transform)) {
+        out.put(code->expression);
+        out.put<uint8_t>(code->coroutine ? 1 : 0);
+    } else if (const auto* value_map = std::get_if<ValueMapping>(&transform)) {
+        out.put<uint32_t>(static_cast<uint32_t>(value_map->mappings.size()));
+        for (const auto& [from, to] : value_map->mappings) {
+            out.put(from);
+            out.put(to);
+        }
+    }
+}
+
+bool read_transform(BinaryReader& in, Transform& transform) {
+    switch (in.get<uint8_t>()) {
+        case 0:
+            transform = DirectMapping{};
+            return true;
+        case 1: {
+            CodeTransform code;
+            code.expression = in.get_string();
+            code.coroutine = in.get<uint8_t>() != 0;
+            transform = std::move(code);
+            return true;
+        }
+        case 2: {
+            ValueMapping value_map;
+            for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+                std::string from = in.get_string();
+                value_map.mappings[from] = in.get_string();
+            }
+            transform = std::move(value_map);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+using TemplateIndex = std::unordered_map<const MappingTemplate*, uint32_t>;
+using TemplateTable = std::vector<std::shared_ptr<const MappingTemplate>>;
+
+void write_mapping(BinaryWriter& out, const std::string& name, const SignalMapping& mapping,
+                   const TemplateIndex& templates) {
+    out.put(name);
+    out.put<uint32_t>(static_cast<uint32_t>(mapping.datatype));
+    out.put<int32_t>(mapping.interval_ms);
+    out.put(mapping.source.type);
+    out.put(mapping.source.name);
+    out.put<uint32_t>(static_cast<uint32_t>(mapping.depends_on.size()));
+    for (const auto& dep : mapping.depends_on) {
+        out.put(dep);
+    }
+    out.put<uint8_t>(static_cast<uint8_t>(mapping.update_trigger));
+    out.put<uint8_t>(static_cast<uint8_t>(mapping.priority));
+    out.put<uint8_t>(static_cast<uint8_t>(mapping.join_policy));
+    out.put<int32_t>(mapping.join_tolerance_ms);
+    out.put<uint64_t>(mapping.max_instructions);
+    out.put<int32_t>(mapping.history_size);
+
+    out.put<uint32_t>(static_cast<uint32_t>(mapping.lookup_tables.size()));
+    for (const auto& [table_name, spec] : mapping.lookup_tables) {
+        out.put(table_name);
+        out.put(spec.x);
+        out.put(spec.y);
+        out.put<uint32_t>(static_cast<uint32_t>(spec.z.size()));
+        for (const auto& row : spec.z) {
+            out.put(row);
+        }
+    }
+
+    write_transform(out, mapping.transform);
+    auto tmpl = templates.find(mapping.instance_of.get());
+    out.put<uint32_t>(tmpl != templates.end() ? tmpl->second + 1 : 0);  // 0 = no template
+    out.put<int64_t>(mapping.template_index);
+
+    out.put(mapping.struct_type);
+    out.put(mapping.struct_field);
+    out.put<uint8_t>(mapping.is_struct ? 1 : 0);
+}
+
+bool read_mapping(BinaryReader& in, std::string& name, SignalMapping& mapping,
+                  const TemplateTable& templates) {
+    name = in.get_string();
+    if (!read_enum<uint32_t>(in, ValueType::STRUCT_ARRAY, mapping.datatype)) {
+        return false;
+    }
+    mapping.interval_ms = in.get<int32_t>();
+    mapping.source.type = in.get_string();
+    mapping.source.name = in.get_string();
+    for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+        mapping.depends_on.push_back(in.get_string());
+    }
+    if (!read_enum<uint8_t>(in, UpdateTrigger::BOTH, mapping.update_trigger) ||
+        !read_enum<uint8_t>(in, Priority::CRITICAL, mapping.priority) ||
+        !read_enum<uint8_t>(in, JoinPolicy::INTERPOLATE, mapping.join_policy)) {
+        return false;
+    }
+    mapping.join_tolerance_ms = in.get<int32_t>();
+    mapping.max_instructions = in.get<uint64_t>();
+    mapping.history_size = in.get<int32_t>();
+
+    for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+        std::string table_name = in.get_string();
+        LookupTableSpec spec;
+        spec.x = in.get_doubles();
+        spec.y = in.get_doubles();
+        for (size_t r = 0, rows = in.get_count(); r < rows && in.ok(); ++r) {
+            spec.z.push_back(in.get_doubles());
+        }
+        mapping.lookup_tables[table_name] = std::move(spec);
+    }
+
+    if (!read_transform(in, mapping.transform)) {
+        return false;
+    }
+    uint32_t tmpl = in.get<uint32_t>();
+    if (tmpl > templates.size()) {
+        return false;
+    }
+    if (tmpl > 0) {
+        mapping.instance_of = templates[tmpl - 1];
+    }
+    mapping.template_index = in.get<int64_t>();
+
+    mapping.struct_type = in.get_string();
+    mapping.struct_field = in.get_string();
+    mapping.is_struct = in.get<uint8_t>() != 0;
+    return in.ok();
+}
+
+void write_chunks(BinaryWriter& out, const std::unordered_map<std::string, std::string>& chunks) {
+    out.put<uint32_t>(static_cast<uint32_t>(chunks.size()));
+    for (const auto& [name, bytecode] : chunks) {
+        out.put(name);
+        out.put(bytecode);
+    }
+}
+
+void read_chunks(BinaryReader& in, std::unordered_map<std::string, std::string>& chunks) {
+    for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+        std::string name = in.get_string();
+        chunks[name] = in.get_string();
+    }
+}
+
+void write_plan(BinaryWriter& out, const CompiledPlan& plan) {
+    out.put<uint32_t>(static_cast<uint32_t>(plan.processing_order.size()));
+    for (const auto& name : plan.processing_order) {
+        out.put(name);
+    }
+    out.put<uint32_t>(static_cast<uint32_t>(plan.priority_order.size()));
+    for (uint32_t index : plan.priority_order) {
+        out.put<uint32_t>(index);
+    }
+
+    out.put<uint32_t>(static_cast<uint32_t>(plan.decode_plan.size()));
+    for (const auto& [message_id, signals] : plan.decode_plan) {
+        out.put<uint32_t>(message_id);
+        out.put<uint32_t>(static_cast<uint32_t>(signals.size()));
+        for (const auto& signal : signals) {
+            out.put(signal);
+        }
+    }
+
+    out.put<uint32_t>(static_cast<uint32_t>(plan.enum_tables.size()));
+    for (const auto& [signal, values] : plan.enum_tables) {
+        out.put(signal);
+        out.put<uint32_t>(static_cast<uint32_t>(values.size()));
+        for (const auto& [label, value] : values) {
+            out.put(label);
+            out.put<int64_t>(value);
+        }
+    }
+
+    write_chunks(out, plan.transform_chunks);
+    write_chunks(out, plan.template_chunks);
+}
+
+// Orders are checked against the DAG when it is built from the plan
+void read_plan(BinaryReader& in, CompiledPlan& plan) {
+    for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+        plan.processing_order.push_back(in.get_string());
+    }
+    for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+        plan.priority_order.push_back(in.get<uint32_t>());
+    }
+
+    for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+        auto& signals = plan.decode_plan[in.get<uint32_t>()];
+        for (size_t s = 0, count = in.get_count(); s < count && in.ok(); ++s) {
+            signals.push_back(in.get_string());
+        }
+    }
+
+    for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+        auto& values = plan.enum_tables[in.get_string()];
+        for (size_t v = 0, count = in.get_count(); v < count && in.ok(); ++v) {
+            std::string label = in.get_string();
+            values[label] = in.get<int64_t>();
+        }
+    }
+
+    read_chunks(in, plan.transform_chunks);
+    read_chunks(in, plan.template_chunks);
+}
+
+} // namespace
+
+bool load_mapping_file(const std::string& path, MappingConfig& config) {
+    std::ifstream file(path);
+    if (!file) {
+        LOG(ERROR) << "Failed to open mapping file: " << path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return load_mapping_yaml(buffer.str(), config);
+}
+
+bool load_mapping_yaml(const std::string& yaml, MappingConfig& config) {
+    MappingConfig loaded;
+    try {
+        YAML::Node root = YAML::Load(yaml);
+        if (!root["mappings"]) {
+            LOG(ERROR) << "No 'mappings' section found in mapping file";
+            return false;
+        }
+
+        for (const auto& mapping_node : root["mappings"]) {
+            if (!mapping_node["signal"]) {
+                LOG(ERROR) << "Mapping without 'signal' name";
+                return false;
+            }
+            std::string signal_name = mapping_node["signal"].as<std::string>();
+            if (mapping_node["for"]) {
+                if (!expand_template(mapping_node, signal_name, loaded.mappings)) {
+                    return false;
+                }
+                continue;
+            }
+            SignalMapping mapping;
+            if (!parse_mapping(mapping_node, signal_name, mapping)) {
+                return false;
+            }
+            if (!loaded.mappings.emplace(signal_name, std::move(mapping)).second) {
+                LOG(ERROR) << "Duplicate mapping for signal " << signal_name;
+                return false;
+            }
+        }
+
+        // Lua execution budgets and batch deadline (optional)
+        if (root["execution_budget"]) {
+            const auto& budget = root["execution_budget"];
+            loaded.execution_budget.node_instructions = budget["node_instructions"].as<uint64_t>(0);
+            loaded.execution_budget.batch_instructions = budget["batch_instructions"].as<uint64_t>(0);
+        }
+        if (root["batch_deadline_us"]) {
+            loaded.batch_deadline = std::chrono::microseconds(root["batch_deadline_us"].as<int64_t>());
+        }
+
+        // Staged pipeline (optional, enabled unless `enabled: false`)
+        if (const auto& node = root["pipeline"]; node && node["enabled"].as<bool>(true)) {
+            PipelineConfig pipeline;
+            pipeline.update_capacity = node["update_capacity"].as<size_t>(pipeline.update_capacity);
+            pipeline.output_capacity = node["output_capacity"].as<size_t>(pipeline.output_capacity);
+            pipeline.max_batch = node["max_batch"].as<size_t>(pipeline.max_batch);
+            pipeline.decode_cpu = node["decode_cpu"].as<int>(pipeline.decode_cpu);
+            pipeline.evaluate_cpu = node["evaluate_cpu"].as<int>(pipeline.evaluate_cpu);
+            pipeline.sink_cpu = node["sink_cpu"].as<int>(pipeline.sink_cpu);
+            pipeline.idle_sleep = std::chrono::microseconds(
+                node["idle_sleep_us"].as<int64_t>(pipeline.idle_sleep.count()));
+            loaded.pipeline = pipeline;
+            loaded.pipeline_frame_capacity = node["frame_capacity"].as<size_t>(loaded.pipeline_frame_capacity);
+        }
+
+        // Fixed-rate resampling groups (optional)
+        for (const auto& group_node : root["resample"]) {
+            ResampleGroup group;
+            if (!parse_resample_group(group_node, group)) {
+                return false;
+            }
+            loaded.resample_groups.push_back(std::move(group));
+        }
+    } catch (const std::exception& e) {
+        LOG(ERROR) << "Error parsing mapping file: " << e.what();
+        return false;
+    }
+
+    if (!validate(loaded)) {
+        return false;
+    }
+    config = std::move(loaded);
+    return true;
+}
+
+bool save_compiled_mappings(const MappingConfig& config, const std::string& path) {
+    BinaryWriter out;
+    for (char c : kCompiledMagic) {
+        out.put<char>(c);
+    }
+    out.put<uint32_t>(kCompiledVersion);
+
+    // Template transforms are stored once and referenced by their instances
+    TemplateIndex templates;
+    std::vector<const MappingTemplate*> template_order;
+    for (const auto& [name, mapping] : config.mappings) {
+        if (mapping.instance_of &&
+            templates.emplace(mapping.instance_of.get(), template_order.size()).second) {
+            template_order.push_back(mapping.instance_of.get());
+        }
+    }
+    out.put<uint32_t>(static_cast<uint32_t>(template_order.size()));
+    for (const auto* tmpl : template_order) {
+        out.put(tmpl->name);
+        out.put(tmpl->variable);
+        write_transform(out, tmpl->transform);
+    }
+
+    out.put<uint32_t>(static_cast<uint32_t>(config.mappings.size()));
+    for (const auto& [name, mapping] : config.mappings) {
+        write_mapping(out, name, mapping, templates);
+    }
+
+    out.put<uint32_t>(static_cast<uint32_t>(config.resample_groups.size()));
+    for (const auto& group : config.resample_groups) {
+        out.put(group.name);
+        out.put<int32_t>(group.period_ms);
+        out.put<int32_t>(group.delay_ms);
+        out.put<uint32_t>(static_cast<uint32_t>(group.columns.size()));
+        for (const auto& column : group.columns) {
+            out.put(column.signal);
+            out.put<uint8_t>(static_cast<uint8_t>(column.method));
+        }
+    }
+
+    out.put<uint64_t>(config.execution_budget.node_instructions);
+    out.put<uint64_t>(config.execution_budget.batch_instructions);
+    out.put<int64_t>(config.batch_deadline ? config.batch_deadline->count() : -1);
+
+    out.put<uint8_t>(config.pipeline ? 1 : 0);
+    if (config.pipeline) {
+        out.put<uint64_t>(config.pipeline->update_capacity);
+        out.put<uint64_t>(config.pipeline->output_capacity);
+        out.put<uint64_t>(config.pipeline->max_batch);
+        out.put<int32_t>(config.pipeline->decode_cpu);
+        out.put<int32_t>(config.pipeline->evaluate_cpu);
+        out.put<int32_t>(config.pipeline->sink_cpu);
+        out.put<int64_t>(config.pipeline->idle_sleep.count());
+        out.put<uint64_t>(config.pipeline_frame_capacity);
+    }
+
+    out.put<uint8_t>(config.plan ? 1 : 0);
+    if (config.plan) {
+        write_plan(out, *config.plan);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG(ERROR) << "Failed to open compiled mapping file for writing: " << path;
+        return false;
+    }
+    file.write(out.data().data(), static_cast<std::streamsize>(out.data().size()));
+    return static_cast<bool>(file);
+}
+
+bool load_compiled_mappings(const std::string& path, MappingConfig& config) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG(ERROR) << "Failed to open compiled mapping file: " << path;
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(kCompiledMagic))) {
+        LOG(ERROR) << "Compiled mapping file is truncated: " << path;
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        LOG(ERROR) << "Failed to map compiled mapping file: " << path;
+        return false;
+    }
+
+    BinaryReader in(static_cast<const char*>(mapped), size);
+    MappingConfig loaded;
+    bool ok = true;
+    bool header_ok = true;
+
+    char magic[sizeof(kCompiledMagic)];
+    for (char& c : magic) {
+        c = in.get<char>();
+    }
+    if (std::memcmp(magic, kCompiledMagic, sizeof(magic)) != 0) {
+        LOG(ERROR) << "Not a compiled mapping file: " << path;
+        ok = header_ok = false;
+    } else if (uint32_t version = in.get<uint32_t>(); version != kCompiledVersion) {
+        LOG(ERROR) << "Unsupported compiled mapping version " << version << " in " << path;
+        ok = header_ok = false;
+    }
+
+    TemplateTable templates;
+    for (size_t i = 0, n = ok ? in.get_count() : 0; i < n && ok; ++i) {
+        auto tmpl = std::make_shared<MappingTemplate>();
+        tmpl->name = in.get_string();
+        tmpl->variable = in.get_string();
+        ok = read_transform(in, tmpl->transform);
+        templates.push_back(std::move(tmpl));
+    }
+
+    for (size_t i = 0, n = ok ? in.get_count() : 0; i < n && ok; ++i) {
+        std::string name;
+        SignalMapping mapping;
+        ok = read_mapping(in, name, mapping, templates);
+        loaded.mappings[name] = std::move(mapping);
+    }
+
+    for (size_t i = 0, n = ok ? in.get_count() : 0; i < n && ok && in.ok(); ++i) {
+        ResampleGroup group;
+        group.name = in.get_string();
+        group.period_ms = in.get<int32_t>();
+        group.delay_ms = in.get<int32_t>();
+        for (size_t c = 0, columns = in.get_count(); c < columns && ok && in.ok(); ++c) {
+            ResampleColumn column;
+            column.signal = in.get_string();
+            ok = read_enum<uint8_t>(in, ResampleMethod::MEAN, column.method);
+            group.columns.push_back(std::move(column));
+        }
+        loaded.resample_groups.push_back(std::move(group));
+    }
+
+    if (ok) {
+        loaded.execution_budget.node_instructions = in.get<uint64_t>();
+        loaded.execution_budget.batch_instructions = in.get<uint64_t>();
+        int64_t deadline = in.get<int64_t>();
+        if (deadline >= 0) {
+            loaded.batch_deadline = std::chrono::microseconds(deadline);
+        }
+
+        if (in.get<uint8_t>() != 0) {
+            PipelineConfig pipeline;
+            pipeline.update_capacity = in.get<uint64_t>();
+            pipeline.output_capacity = in.get<uint64_t>();
+            pipeline.max_batch = in.get<uint64_t>();
+            pipeline.decode_cpu = in.get<int32_t>();
+            pipeline.evaluate_cpu = in.get<int32_t>();
+            pipeline.sink_cpu = in.get<int32_t>();
+            pipeline.idle_sleep = std::chrono::microseconds(in.get<int64_t>());
+            loaded.pipeline = pipeline;
+            loaded.pipeline_frame_capacity = in.get<uint64_t>();
+        }
+
+        if (in.get<uint8_t>() != 0) {
+            loaded.plan.emplace();
+            read_plan(in, *loaded.plan);
+        }
+    }
+    ::munmap(mapped, size);
+
+    if (!ok || !in.ok()) {
+        if (header_ok) {
+            LOG(ERROR) << "Compiled mapping file is corrupt: " << path;
+        }
+        return false;
+    }
+    if (!validate(loaded)) {
+        LOG(ERROR) << "Compiled mapping file is inconsistent: " << path;
+        return false;
+    }
+    config = std::move(loaded);
+    return true;
+}
+
+bool is_compiled_mapping_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(kCompiledMagic)] = {};
+    file.read(magic, sizeof(magic));
+    return file && std::memcmp(magic, kCompiledMagic, sizeof(magic)) == 0;
+}
+
+} // namespace vssdag
@@ -0,0 +1,62 @@
+#include "vssdag/memory_footprint.h"
+#include <unordered_set>
+
+namespace vssdag {
+
+namespace {
+
+size_t vector_bytes(const std::vector<double>& values) {
+    return values.capacity() * sizeof(double);
+}
+
+size_t transform_bytes(const Transform& transform) {
+    if (const auto* code = std::get_if<CodeTransform>(&transform)) {
+        return heap_bytes(code->expression);
+    }
+    size_t bytes = 0;
+    if (const auto* value_map = std::get_if<ValueMapping>(&transform)) {
+        bytes += value_map->mappings.bucket_count() * sizeof(void*);
+        for (const auto& [from, to] : value_map->mappings) {
+            bytes += sizeof(std::pair<const std::string, std::string>) + sizeof(void*) +
+                     heap_bytes(from) + heap_bytes(to);
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+size_t estimate_mapping_bytes(const MappingSet& mappings) {
+    size_t bytes = mappings.bucket_count() * sizeof(void*);
+    std::unordered_set<const MappingTemplate*> templates;
+
+    for (const auto& [name, mapping] : mappings) {
+        bytes += sizeof(MappingSet::value_type) + sizeof(void*) + heap_bytes(name);
+        bytes += heap_bytes(mapping.source.type) + heap_bytes(mapping.source.name);
+        bytes += mapping.depends_on.capacity() * sizeof(std::string);
+        for (const auto& dep : mapping.depends_on) {
+            bytes += heap_bytes(dep);
+        }
+        bytes += transform_bytes(mapping.transform);
+
+        bytes += mapping.lookup_tables.bucket_count() * sizeof(void*);
+        for (const auto& [table_name, spec] : mapping.lookup_tables) {
+            bytes += sizeof(std::pair<const std::string, LookupTableSpec>) + sizeof(void*) +
+                     heap_bytes(table_name) + vector_bytes(spec.x) + vector_bytes(spec.y) +
+                     spec.z.capacity() * sizeof(std::vector<double>);
+            for (const auto& row : spec.z) {
+                bytes += vector_bytes(row);
+            }
+        }
+
+        if (mapping.instance_of && templates.insert(mapping.instance_of.get()).second) {
+            bytes += sizeof(MappingTemplate) + heap_bytes(mapping.instance_of->name) +
+                     heap_bytes(mapping.instance_of->variable) +
+                     transform_bytes(mapping.instance_of->transform);
+        }
+        bytes += heap_bytes(mapping.struct_type) + heap_bytes(mapping.struct_field);
+    }
+    return bytes;
+}
+
+} // namespace vssdag
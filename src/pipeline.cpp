@@ -0,0 +1,150 @@
+#include "vssdag/pipeline.h"
+#include <glog/logging.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vssdag {
+
+Pipeline::Pipeline(ISignalSource& source, SignalProcessorDAG& processor, Sink sink,
+                   PipelineConfig config)
+    : source_(source),
+      processor_(processor),
+      sink_(std::move(sink)),
+      config_(config),
+      updates_(config.update_capacity),
+      outputs_(config.output_capacity) {
+}
+
+Pipeline::~Pipeline() {
+    stop();
+}
+
+void Pipeline::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+
+    sink_thread_ = std::thread(&Pipeline::sink_loop, this);
+    evaluate_thread_ = std::thread(&Pipeline::evaluate_loop, this);
+    decode_thread_ = std::thread(&Pipeline::decode_loop, this);
+
+    const std::pair<std::thread*, int> affinities[] = {
+        {&decode_thread_, config_.decode_cpu},
+        {&evaluate_thread_, config_.evaluate_cpu},
+        {&sink_thread_, config_.sink_cpu}};
+    for (const auto& [thread, cpu] : affinities) {
+        if (cpu >= 0) {
+            set_thread_affinity(*thread, cpu);
+        }
+    }
+}
+
+void Pipeline::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    for (auto* thread : {&decode_thread_, &evaluate_thread_, &sink_thread_}) {
+        if (thread->joinable()) {
+            thread->join();
+        }
+    }
+}
+
+PipelineStats Pipeline::stats() const {
+    PipelineStats stats;
+    stats.updates = update_count_.load(std::memory_order_relaxed);
+    stats.batches = batch_count_.load(std::memory_order_relaxed);
+    stats.outputs = output_count_.load(std::memory_order_relaxed);
+    stats.outputs_dropped = dropped_count_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Pipeline::decode_loop() {
+    std::vector<SignalUpdate> updates;
+    while (running_.load(std::memory_order_relaxed)) {
+        updates.clear();
+        source_.poll_into(updates);
+        if (updates.empty()) {
+            std::this_thread::sleep_for(config_.idle_sleep);
+            continue;
+        }
+        for (auto& update : updates) {
+            // Back-pressure: wait for the evaluate stage rather than drop
+            while (!updates_.try_push(std::move(update))) {
+                if (!running_.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::sleep_for(config_.idle_sleep);
+            }
+        }
+    }
+}
+
+void Pipeline::evaluate_loop() {
+    std::vector<SignalUpdate> batch;
+    batch.reserve(config_.max_batch);
+    std::vector<VSSSignal> signals;
+    SignalUpdate update;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        batch.clear();
+        while (batch.size() < config_.max_batch && updates_.try_pop(update)) {
+            batch.push_back(std::move(update));
+        }
+
+        // Scheduled wakeups and periodic nodes run without new input
+        auto wakeup = processor_.next_wakeup();
+        bool due = wakeup && *wakeup <= processor_.clock().now();
+        if (batch.empty() && !due) {
+            std::this_thread::sleep_for(config_.idle_sleep);
+            continue;
+        }
+
+        update_count_.fetch_add(batch.size(), std::memory_order_relaxed);
+        batch_count_.fetch_add(1, std::memory_order_relaxed);
+        signals.clear();
+        processor_.process_signal_updates(batch, signals);
+        for (auto& signal : signals) {
+            // Never wait for the sink
+            if (!outputs_.try_push(std::move(signal))) {
+                dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void Pipeline::sink_loop() {
+    VSSSignal signal;
+    while (running_.load(std::memory_order_relaxed)) {
+        if (!outputs_.try_pop(signal)) {
+            std::this_thread::sleep_for(config_.idle_sleep);
+            continue;
+        }
+        if (sink_) {
+            sink_(signal);
+        }
+        output_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool set_thread_affinity(std::thread& thread, int cpu) {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    int rc = pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+    if (rc != 0) {
+        LOG(WARNING) << "Failed to pin thread to CPU " << cpu << ": error " << rc;
+        return false;
+    }
+    return true;
+#else
+    (void)thread;
+    LOG(WARNING) << "Thread affinity not supported on this platform (CPU " << cpu << ")";
+    return false;
+#endif
+}
+
+} // namespace vssdag
@@ -0,0 +1,219 @@
+#include "vssdag/quantile_sketch.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace vssdag {
+
+namespace {
+
+// Magnitudes below this are counted as zero
+constexpr double kMinIndexable = 1e-9;
+
+constexpr const char* kFormatTag = "ddsketch1";
+
+} // namespace
+
+QuantileSketch::QuantileSketch(double relative_accuracy, size_t max_bins)
+    : relative_accuracy_(relative_accuracy),
+      max_bins_(std::max<size_t>(max_bins, 1)),
+      gamma_((1.0 + relative_accuracy) / (1.0 - relative_accuracy)),
+      log_gamma_(std::log(gamma_)) {
+}
+
+void QuantileSketch::Store::add(int index, uint64_t count, size_t max_bins) {
+    if (counts.empty()) {
+        counts.assign(1, 0);
+        offset = index;
+    }
+
+    if (index < offset) {
+        size_t grow = static_cast<size_t>(offset - index);
+        if (counts.size() + grow > max_bins) {
+            // Collapse into the lowest bucket that still fits
+            grow = max_bins > counts.size() ? max_bins - counts.size() : 0;
+        }
+        counts.insert(counts.begin(), grow, 0);
+        offset -= static_cast<int>(grow);
+        index = std::max(index, offset);
+    } else if (index >= offset + static_cast<int>(counts.size())) {
+        size_t size = static_cast<size_t>(index - offset) + 1;
+        if (size > max_bins) {
+            // Fold the lowest buckets together to make room at the top
+            size_t shift = size - max_bins;
+            size_t drop = std::min(shift, counts.size());
+            uint64_t folded = 0;
+            for (size_t i = 0; i < drop; ++i) {
+                folded += counts[i];
+            }
+            counts.erase(counts.begin(), counts.begin() + drop);
+            offset += static_cast<int>(shift);
+            counts.resize(max_bins, 0);
+            counts[0] += folded;
+        } else {
+            counts.resize(size, 0);
+        }
+    }
+
+    counts[static_cast<size_t>(index - offset)] += count;
+}
+
+int QuantileSketch::index_of(double magnitude) const {
+    return static_cast<int>(std::ceil(std::log(magnitude) / log_gamma_));
+}
+
+double QuantileSketch::value_of(int index) const {
+    // Midpoint (in relative terms) of (gamma^(i-1), gamma^i]
+    return 2.0 * std::pow(gamma_, index) / (gamma_ + 1.0);
+}
+
+void QuantileSketch::record_extremes(double min, double max, double sum, uint64_t count) {
+    if (count_ == 0) {
+        min_ = min;
+        max_ = max;
+    } else {
+        min_ = std::min(min_, min);
+        max_ = std::max(max_, max);
+    }
+    sum_ += sum;
+    count_ += count;
+}
+
+void QuantileSketch::add(double value, uint64_t count) {
+    if (std::isnan(value) || count == 0) {
+        return;
+    }
+
+    double magnitude = std::fabs(value);
+    if (magnitude < kMinIndexable) {
+        zero_count_ += count;
+    } else if (value > 0) {
+        positive_.add(index_of(magnitude), count, max_bins_);
+    } else {
+        negative_.add(index_of(magnitude), count, max_bins_);
+    }
+    record_extremes(value, value, value * count, count);
+}
+
+bool QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.relative_accuracy_ != relative_accuracy_) {
+        return false;
+    }
+    if (other.count_ == 0) {
+        return true;
+    }
+
+    for (size_t i = 0; i < other.positive_.counts.size(); ++i) {
+        if (other.positive_.counts[i] > 0) {
+            positive_.add(other.positive_.offset + static_cast<int>(i), other.positive_.counts[i], max_bins_);
+        }
+    }
+    for (size_t i = 0; i < other.negative_.counts.size(); ++i) {
+        if (other.negative_.counts[i] > 0) {
+            negative_.add(other.negative_.offset + static_cast<int>(i), other.negative_.counts[i], max_bins_);
+        }
+    }
+    zero_count_ += other.zero_count_;
+    record_extremes(other.min_, other.max_, other.sum_, other.count_);
+    return true;
+}
+
+std::optional<double> QuantileSketch::quantile(double q) const {
+    if (count_ == 0 || std::isnan(q)) {
+        return std::nullopt;
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    if (q == 0.0) {
+        return min_;
+    }
+    if (q == 1.0) {
+        return max_;
+    }
+
+    double rank = q * static_cast<double>(count_ - 1);
+    double seen = 0.0;
+    double result = max_;
+    bool found = false;
+
+    // Most negative values first (largest magnitude)
+    for (size_t i = negative_.counts.size(); i-- > 0 && !found;) {
+        seen += static_cast<double>(negative_.counts[i]);
+        if (seen > rank) {
+            result = -value_of(negative_.offset + static_cast<int>(i));
+            found = true;
+        }
+    }
+    if (!found) {
+        seen += static_cast<double>(zero_count_);
+        if (seen > rank) {
+            result = 0.0;
+            found = true;
+        }
+    }
+    for (size_t i = 0; i < positive_.counts.size() && !found; ++i) {
+        seen += static_cast<double>(positive_.counts[i]);
+        if (seen > rank) {
+            result = value_of(positive_.offset + static_cast<int>(i));
+            found = true;
+        }
+    }
+
+    return std::clamp(result, min_, max_);
+}
+
+void QuantileSketch::clear() {
+    positive_ = Store();
+    negative_ = Store();
+    zero_count_ = 0;
+    count_ = 0;
+    min_ = 0.0;
+    max_ = 0.0;
+    sum_ = 0.0;
+}
+
+// Format: ddsketch1 <accuracy> <max_bins> <count> <min> <max> <sum> <zero_count>
+//         <positive offset> <n> <counts...> <negative offset> <n> <counts...>
+std::string QuantileSketch::serialize() const {
+    std::ostringstream out;
+    out << std::setprecision(17) << kFormatTag << " " << relative_accuracy_ << " " << max_bins_
+        << " " << count_ << " " << min_ << " " << max_ << " " << sum_ << " " << zero_count_;
+    for (const Store* store : {&positive_, &negative_}) {
+        out << " " << store->offset << " " << store->counts.size();
+        for (uint64_t c : store->counts) {
+            out << " " << c;
+        }
+    }
+    return out.str();
+}
+
+std::optional<QuantileSketch> QuantileSketch::deserialize(const std::string& text) {
+    std::istringstream in(text);
+    std::string tag;
+    double accuracy = 0.0;
+    size_t max_bins = 0;
+    if (!(in >> tag >> accuracy >> max_bins) || tag != kFormatTag ||
+        !(accuracy > 0.0 && accuracy < 1.0) || max_bins == 0) {
+        return std::nullopt;
+    }
+
+    QuantileSketch sketch(accuracy, max_bins);
+    if (!(in >> sketch.count_ >> sketch.min_ >> sketch.max_ >> sketch.sum_ >> sketch.zero_count_)) {
+        return std::nullopt;
+    }
+    for (Store* store : {&sketch.positive_, &sketch.negative_}) {
+        size_t size = 0;
+        if (!(in >> store->offset >> size) || size > max_bins) {
+            return std::nullopt;
+        }
+        store->counts.resize(size);
+        for (auto& c : store->counts) {
+            if (!(in >> c)) {
+                return std::nullopt;
+            }
+        }
+    }
+    return sketch;
+}
+
+} // namespace vssdag
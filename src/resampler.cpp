@@ -0,0 +1,85 @@
+#include "vssdag/resampler.h"
+#include <cmath>
+#include <limits>
+
+namespace vssdag {
+
+namespace {
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+} // namespace
+
+Resampler::Resampler(ResampleGroup group, time_point start)
+    : group_(std::move(group)),
+      period_(std::chrono::milliseconds(group_.period_ms)),
+      delay_(std::chrono::milliseconds(group_.delay_ms)),
+      columns_(group_.columns.size()),
+      row_(group_.columns.size(), kMissing) {
+    // First grid time at or after start
+    auto since_epoch = start.time_since_epoch();
+    auto ticks = since_epoch / period_;
+    if (ticks * period_ < since_epoch) {
+        ++ticks;
+    }
+    next_tick_ = time_point(ticks * period_);
+}
+
+void Resampler::record(size_t column, time_point timestamp, double value) {
+    auto& state = columns_[column];
+    if (!state.pending.empty()) {
+        if (timestamp < state.pending.back().timestamp) {
+            return;  // Out of order
+        }
+    } else if (state.has_last && timestamp < state.last.timestamp) {
+        return;
+    }
+    state.pending.push_back(Point{timestamp, value});
+}
+
+size_t Resampler::advance(time_point now, const RowHandler& handler) {
+    size_t emitted = 0;
+    while (next_tick_ + delay_ <= now) {
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            row_[i] = sample(columns_[i], group_.columns[i].method, next_tick_);
+        }
+        if (handler) {
+            handler(group_, next_tick_, row_);
+        }
+        next_tick_ += period_;
+        ++emitted;
+    }
+    return emitted;
+}
+
+double Resampler::sample(ColumnState& column, ResampleMethod method, time_point tick) {
+    double sum = 0.0;
+    size_t count = 0;
+    while (!column.pending.empty() && column.pending.front().timestamp <= tick) {
+        const Point& point = column.pending.front();
+        if (!std::isnan(point.value)) {
+            sum += point.value;
+            ++count;
+        }
+        column.last = point;
+        column.has_last = true;
+        column.pending.pop_front();
+    }
+
+    if (method == ResampleMethod::MEAN && count > 0) {
+        return sum / count;
+    }
+    if (!column.has_last) {
+        return kMissing;
+    }
+    if (method == ResampleMethod::LINEAR && !column.pending.empty() && column.last.timestamp < tick) {
+        const Point& next = column.pending.front();
+        double fraction = std::chrono::duration<double>(tick - column.last.timestamp).count() /
+                          std::chrono::duration<double>(next.timestamp - column.last.timestamp).count();
+        // NaN endpoints propagate, marking the tick as missing
+        return column.last.value + fraction * (next.value - column.last.value);
+    }
+    return column.last.value;
+}
+
+} // namespace vssdag
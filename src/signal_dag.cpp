@@ -5,29 +5,75 @@
 namespace vssdag {
 
 bool SignalDAG::build(const std::unordered_map<std::string, SignalMapping>& mappings) {
+    return build(std::make_shared<const MappingSet>(mappings));
+}
+
+bool SignalDAG::build(SharedMappings mappings) {
+    if (!build_nodes(std::move(mappings))) {
+        return false;
+    }
+    
+    // Check for cycles and compute processing order
+    if (!topological_sort()) {
+        LOG(ERROR) << "Dependency cycle detected in signal DAG";
+        return false;
+    }
+    assign_priorities();
+
+    // Dependencies never rank below their dependents, so a stable sort keeps
+    // the order topological
+    priority_order_ = processing_order_;
+    std::stable_sort(priority_order_.begin(), priority_order_.end(),
+                     [](const SignalNode* a, const SignalNode* b) { return a->priority > b->priority; });
+    
+    LOG(INFO) << "Built signal DAG with " << nodes_.size() << " nodes";
+    log_processing_order();
+    return true;
+}
+
+bool SignalDAG::build(SharedMappings mappings, const CompiledPlan& plan) {
+    if (!build_nodes(std::move(mappings))) {
+        return false;
+    }
+    if (!apply_plan_order(plan)) {
+        LOG(ERROR) << "Compiled processing order does not match the signal DAG";
+        return false;
+    }
+    assign_priorities();
+
+    LOG(INFO) << "Built signal DAG with " << nodes_.size() << " nodes from a compiled plan";
+    log_processing_order();
+    return true;
+}
+
+bool SignalDAG::build_nodes(SharedMappings mappings) {
+    // Nodes reference the previous set until they are cleared
     nodes_.clear();
-    signal_map_.clear();
+    nodes_by_symbol_.clear();
     processing_order_.clear();
+    priority_order_.clear();
+    mappings_ = std::move(mappings);
     
     // First pass: Create nodes
-    for (const auto& [signal_name, mapping] : mappings) {
-        auto node = std::make_unique<SignalNode>();
-        node->signal_name = signal_name;
-        node->mapping = mapping;
-        node->depends_on = mapping.depends_on;
+    nodes_.reserve(mappings_->size());
+    for (const auto& [signal_name, mapping] : *mappings_) {
+        auto node = std::make_unique<SignalNode>(signal_name, mapping);
         
         // Determine if this is an input signal (has a source) or derived
         node->is_input_signal = mapping.source.is_input_signal();
         
-        signal_map_[node->signal_name] = node.get();
+        if (node->symbol.id() >= nodes_by_symbol_.size()) {
+            nodes_by_symbol_.resize(node->symbol.id() + 1, nullptr);
+        }
+        nodes_by_symbol_[node->symbol.id()] = node.get();
         nodes_.push_back(std::move(node));
     }
     
     // Second pass: Build dependency edges
     for (auto& node : nodes_) {
-        for (const auto& dep : node->depends_on) {
-            auto it = signal_map_.find(dep);
-            if (it == signal_map_.end()) {
+        for (Symbol dep : node->dependency_symbols) {
+            SignalNode* dependency = get_node(dep);
+            if (!dependency) {
                 LOG(ERROR) << "Signal '" << node->signal_name 
                           << "' depends on '" << dep 
                           << "' which doesn't exist";
@@ -35,19 +81,18 @@ bool SignalDAG::build(const std::unordered_map<std::string, SignalMapping>& mapp
             }
             
             // Add edge from dependency to dependent
-            it->second->dependents.push_back(node.get());
+            dependency->dependents.push_back(node.get());
             node->in_degree++;
         }
     }
-    
-    // Check for cycles and compute processing order
-    if (!topological_sort()) {
-        LOG(ERROR) << "Dependency cycle detected in signal DAG";
-        return false;
+    return true;
+}
+
+void SignalDAG::log_processing_order() const {
+    if (!VLOG_IS_ON(1)) {
+        return;
     }
-    
-    LOG(INFO) << "Built signal DAG with " << nodes_.size() << " nodes";
-    LOG(INFO) << "Processing order:";
+    VLOG(1) << "Processing order:";
     for (const auto* node : processing_order_) {
         std::string deps_str;
         if (!node->depends_on.empty()) {
@@ -58,10 +103,19 @@ bool SignalDAG::build(const std::unordered_map<std::string, SignalMapping>& mapp
             }
             deps_str += "]";
         }
-        LOG(INFO) << "  " << node->signal_name << deps_str;
+        VLOG(1) << "  " << node->signal_name << deps_str;
     }
-    
-    return true;
+}
+
+size_t SignalDAG::memory_bytes() const {
+    size_t bytes = nodes_.capacity() * sizeof(std::unique_ptr<SignalNode>) +
+                   (processing_order_.capacity() + priority_order_.capacity()) * sizeof(SignalNode*) +
+                   nodes_by_symbol_.capacity() * sizeof(SignalNode*);
+    for (const auto& node : nodes_) {
+        bytes += sizeof(SignalNode) + node->dependents.capacity() * sizeof(SignalNode*) +
+                 node->dependency_symbols.capacity() * sizeof(Symbol);
+    }
+    return bytes;
 }
 
 bool SignalDAG::topological_sort() {
@@ -96,6 +150,58 @@ bool SignalDAG::topological_sort() {
     return processing_order_.size() == nodes_.size();
 }
 
+bool SignalDAG::apply_plan_order(const CompiledPlan& plan) {
+    if (plan.processing_order.size() != nodes_.size() ||
+        plan.priority_order.size() != nodes_.size()) {
+        return false;
+    }
+
+    // Every node exactly once, each after all of its dependencies
+    std::unordered_map<const SignalNode*, size_t> positions;
+    processing_order_.reserve(nodes_.size());
+    for (const auto& name : plan.processing_order) {
+        SignalNode* node = get_node(name);
+        if (!node || !positions.emplace(node, processing_order_.size()).second) {
+            return false;
+        }
+        for (Symbol dep : node->dependency_symbols) {
+            if (positions.find(get_node(dep)) == positions.end()) {
+                return false;
+            }
+        }
+        processing_order_.push_back(node);
+    }
+
+    // The priority order is a permutation that must stay topological too
+    std::vector<bool> seen(nodes_.size(), false);
+    priority_order_.reserve(nodes_.size());
+    for (uint32_t index : plan.priority_order) {
+        if (index >= seen.size() || seen[index]) {
+            return false;
+        }
+        seen[index] = true;
+        SignalNode* node = processing_order_[index];
+        for (Symbol dep : node->dependency_symbols) {
+            if (!seen[positions[get_node(dep)]]) {
+                return false;
+            }
+        }
+        priority_order_.push_back(node);
+    }
+    return true;
+}
+
+void SignalDAG::assign_priorities() {
+    // Reverse topological order: dependents are final before their dependencies
+    for (auto it = processing_order_.rbegin(); it != processing_order_.rend(); ++it) {
+        SignalNode* node = *it;
+        node->priority = node->mapping.priority;
+        for (const auto* dependent : node->dependents) {
+            node->priority = std::max(node->priority, dependent->priority);
+        }
+    }
+}
+
 void SignalDAG::propagate_update_flag(SignalNode* node) {
     for (auto* dependent : node->dependents) {
         if (!dependent->has_new_data) {
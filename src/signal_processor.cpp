@@ -1,34 +1,308 @@
 #include "vssdag/signal_processor.h"
+#include "vssdag/window_aggregator.h"
+#include "vssdag/binary_io.h"
 #include <glog/logging.h>
 #include <sstream>
+#include <fstream>
 #include <iomanip>
+#include <iterator>
+#include <cmath>
+#include <new>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <unordered_set>
 
 namespace vssdag {
 
-SignalProcessorDAG::SignalProcessorDAG() 
-    : dag_(std::make_unique<SignalDAG>()),
-      lua_mapper_(std::make_unique<LuaMapper>()) {
+namespace {
+
+// Instructions between budget hook calls (smaller budgets use their own size)
+constexpr uint64_t kBudgetHookInterval = 1000;
+
+// Earliest re-evaluation after mark_pending() of a non-periodic signal
+constexpr std::chrono::milliseconds kMinPendingDelay{10};
+
+// Header of save_sketches() files
+constexpr char kSketchFileMagic[8] = {'V', 'S', 'S', 'D', 'A', 'G', 'Q', '1'};
+
+// Registry key of the processor, for the budget hook
+const char kBudgetRegistryKey = 0;
+
+// Lua sees steady time as seconds (_current_time)
+double lua_time_from_steady(std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(t.time_since_epoch()).count();
+}
+
+// Rounded up to the next microsecond so that _current_time >= seconds once reached
+std::chrono::steady_clock::time_point steady_from_lua_time(double seconds) {
+    auto us = static_cast<int64_t>(std::ceil(seconds * 1e6));
+    return std::chrono::steady_clock::time_point(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::microseconds(us)));
+}
+
+// Integral numbers are stored as int64 and numeric strings as numbers;
+// other strings and tables keep their text / type name
+Value integral_or_double(double d) {
+    if (std::floor(d) == d && d >= std::numeric_limits<int64_t>::min() &&
+        d <= std::numeric_limits<int64_t>::max()) {
+        return static_cast<int64_t>(d);
+    }
+    return d;
+}
+
+Value provided_value_from_lua(lua_State* L, int index) {
+    switch (lua_type(L, index)) {
+        case LUA_TNUMBER:
+            if (lua_isinteger(L, index)) {
+                return static_cast<int64_t>(lua_tointeger(L, index));
+            }
+            return integral_or_double(lua_tonumber(L, index));
+        case LUA_TBOOLEAN:
+            return static_cast<bool>(lua_toboolean(L, index));
+        case LUA_TSTRING: {
+            const char* text = lua_tostring(L, index);
+            char* end = nullptr;
+            double d = std::strtod(text, &end);
+            if (end != text) {
+                return integral_or_double(d);
+            }
+            return std::string(text);
+        }
+        default:
+            return std::string(lua_typename(L, lua_type(L, index)));
+    }
+}
+
+// Window kinds shared with the Lua infrastructure (WINDOW_* constants)
+enum LuaWindowKind {
+    WINDOW_SLIDING_TIME = 0,
+    WINDOW_SLIDING_COUNT = 1,
+    WINDOW_TUMBLING_TIME = 2,
+    WINDOW_TUMBLING_COUNT = 3
+};
+
+constexpr const char* kWindowMetatable = "vssdag.window";
+
+// Full userdata holding a native window, owned by a signal's get_state() table
+struct LuaWindow {
+    std::variant<SlidingWindow, TumblingWindow> window;
+    uint64_t last_sample_evaluation = 0;   // Aggregates sharing a window push once per evaluation
+    uint64_t last_closed_evaluation = 0;   // Evaluation in which a tumbling window last closed
+};
+
+int lua_window_new(lua_State* L) {
+    auto kind = luaL_checkinteger(L, 1);
+    double size = luaL_checknumber(L, 2);
+    auto span = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(size));
+    auto count = static_cast<size_t>(size);
+
+    void* memory = lua_newuserdata(L, sizeof(LuaWindow));
+    switch (kind) {
+        case WINDOW_SLIDING_TIME:
+            new (memory) LuaWindow{std::variant<SlidingWindow, TumblingWindow>(std::in_place_type<SlidingWindow>, span)};
+            break;
+        case WINDOW_SLIDING_COUNT:
+            new (memory) LuaWindow{std::variant<SlidingWindow, TumblingWindow>(std::in_place_type<SlidingWindow>, count)};
+            break;
+        case WINDOW_TUMBLING_TIME:
+            new (memory) LuaWindow{std::variant<SlidingWindow, TumblingWindow>(std::in_place_type<TumblingWindow>, span)};
+            break;
+        case WINDOW_TUMBLING_COUNT:
+            new (memory) LuaWindow{std::variant<SlidingWindow, TumblingWindow>(std::in_place_type<TumblingWindow>, count)};
+            break;
+        default:
+            return luaL_error(L, "unknown window kind %d", static_cast<int>(kind));
+    }
+    luaL_setmetatable(L, kWindowMetatable);
+    return 1;
+}
+
+// Initial variance of Kalman states that are not measured directly (rates)
+constexpr double kUnknownVariance = 1e6;
+
+// One step of kalman()/kalman_cv()/kalman_ca(): args (z, q, r), returns the state
+template <size_t N, typename Model>
+int kalman_step(lua_State* L, TimedFilter<KalmanFilter<N>>& slot,
+                std::chrono::steady_clock::time_point now, Model model) {
+    bool has_z = !lua_isnoneornil(L, 1);
+    double z = has_z ? luaL_checknumber(L, 1) : 0.0;
+    double q = luaL_checknumber(L, 2);
+    double r = luaL_checknumber(L, 3);
+    double dt = slot.step(now);
+    auto& kf = slot.filter;
+
+    if (!kf.initialized()) {
+        if (!has_z) {
+            lua_pushnil(L);
+            return 1;
+        }
+        typename KalmanFilter<N>::Vector x{};
+        typename KalmanFilter<N>::Vector variance;
+        variance.fill(kUnknownVariance);
+        x[0] = z;
+        variance[0] = r;
+        kf.initialize(x, variance);
+    } else {
+        if (dt > 0.0) {
+            typename KalmanFilter<N>::Matrix F, Q;
+            model(dt, q, F, Q);
+            kf.predict(F, Q);
+        }
+        if (has_z) {
+            typename KalmanFilter<N>::Vector h{};
+            h[0] = 1.0;
+            kf.update(h, z, r);
+        }
+    }
+
+    for (double value : kf.state()) {
+        lua_pushnumber(L, value);
+    }
+    return static_cast<int>(N);
+}
+
+int lua_window_gc(lua_State* L) {
+    static_cast<LuaWindow*>(luaL_checkudata(L, 1, kWindowMetatable))->~LuaWindow();
+    return 0;
+}
+
+} // namespace
+
+SignalProcessorDAG::SignalProcessorDAG()
+    : SignalProcessorDAG(default_clock()) {
+}
+
+SignalProcessorDAG::SignalProcessorDAG(std::shared_ptr<IClock> clock,
+                                       std::pmr::memory_resource* lua_memory)
+    : clock_(clock ? std::move(clock) : default_clock()),
+      dag_(std::make_unique<SignalDAG>()),
+      lua_mapper_(std::make_unique<LuaMapper>(lua_memory)) {
+    lua_mapper_->set_clock(clock_);
 }
 
 SignalProcessorDAG::~SignalProcessorDAG() = default;
 
 bool SignalProcessorDAG::initialize(const std::unordered_map<std::string, SignalMapping>& mappings) {
+    return initialize(MappingSet(mappings));
+}
+
+bool SignalProcessorDAG::initialize(std::unordered_map<std::string, SignalMapping>&& mappings) {
+    auto store = std::make_shared<MappingSet>(std::move(mappings));
+    if (!initialize(SharedMappings(store))) {
+        return false;
+    }
+
+    // Transforms now live in Lua; nothing reads their source again
+    for (auto& [name, mapping] : *store) {
+        if (auto* code = std::get_if<CodeTransform>(&mapping.transform)) {
+            std::string().swap(code->expression);
+        } else if (auto* value_map = std::get_if<ValueMapping>(&mapping.transform)) {
+            std::unordered_map<std::string, std::string>().swap(value_map->mappings);
+        }
+    }
+    return true;
+}
+
+bool SignalProcessorDAG::initialize(const std::unordered_map<std::string, SignalMapping>& mappings,
+                                    const CompiledPlan& plan) {
+    plan_ = &plan;
+    bool ok = initialize(mappings);
+    plan_ = nullptr;
+    return ok;
+}
+
+bool SignalProcessorDAG::initialize(std::unordered_map<std::string, SignalMapping>&& mappings,
+                                    const CompiledPlan& plan) {
+    plan_ = &plan;
+    bool ok = initialize(std::move(mappings));
+    plan_ = nullptr;
+    return ok;
+}
+
+bool SignalProcessorDAG::compile_plan(const std::unordered_map<std::string, SignalMapping>& mappings,
+                                      CompiledPlan& plan) {
+    plan.transform_chunks.clear();
+    plan.template_chunks.clear();
+    recorded_plan_ = &plan;
+    bool ok = initialize(mappings);
+    recorded_plan_ = nullptr;
+    if (!ok) {
+        return false;
+    }
+
+    const auto& order = dag_->get_processing_order();
+    std::unordered_map<const SignalNode*, uint32_t> positions;
+    plan.processing_order.clear();
+    for (const auto* node : order) {
+        positions[node] = static_cast<uint32_t>(plan.processing_order.size());
+        plan.processing_order.push_back(node->signal_name);
+    }
+    plan.priority_order.clear();
+    for (const auto* node : dag_->get_priority_order()) {
+        plan.priority_order.push_back(positions[node]);
+    }
+    return true;
+}
+
+bool SignalProcessorDAG::initialize(SharedMappings mappings) {
     
-    // Build the DAG
-    if (!dag_->build(mappings)) {
+    // Build the DAG (in the plan's order when there is one)
+    if (!(plan_ ? dag_->build(std::move(mappings), *plan_) : dag_->build(std::move(mappings)))) {
         LOG(ERROR) << "Failed to build signal DAG";
         return false;
     }
+
+    // Nodes from a previous build are gone; drop their wakeups and filter state
+    timer_queue_ = TimerQueue();
+    integrators_.clear();
+    hysteresis_.clear();
+    sketches_.clear();
+    fusion_states_.clear();
+    setup_joins();
+    histories_.clear();
+    for (const auto* node : dag_->get_processing_order()) {
+        if (node->mapping.history_size > 0) {
+            histories_.emplace(node, SignalHistory(node->mapping.history_size));
+        }
+    }
+    resamplers_.clear();
+    resample_feeds_.clear();
+    current_node_ = nullptr;
+    periodic_nodes_.clear();
+    for (auto* node : dag_->get_processing_order()) {
+        if ((node->mapping.update_trigger == UpdateTrigger::PERIODIC ||
+             node->mapping.update_trigger == UpdateTrigger::BOTH) &&
+            node->mapping.interval_ms > 0) {
+            periodic_nodes_.push_back(node);
+        }
+    }
     
+    // Preprocess calibration tables
+    if (!compile_lookup_tables()) {
+        LOG(ERROR) << "Failed to compile lookup tables";
+        return false;
+    }
+
     // Set up Lua environment
     if (!setup_lua_environment()) {
         LOG(ERROR) << "Failed to setup Lua environment";
         return false;
     }
+    if (plan_) {
+        load_enum_tables();
+    }
     
-    // Generate transform functions for all nodes
+    // Generate transform functions for all nodes. Template instances share
+    // the factory generated once for their template.
+    std::unordered_set<const MappingTemplate*> templates;
     for (const auto* node : dag_->get_processing_order()) {
-        if (!generate_transform_function(node)) {
+        const auto* tmpl = node->mapping.instance_of.get();
+        bool generated = tmpl ? (!templates.insert(tmpl).second || generate_template_factory(node)) &&
+                                    instantiate_template(node)
+                              : generate_transform_function(node);
+        if (!generated) {
             LOG(ERROR) << "Failed to generate transform for signal: " << node->signal_name;
             return false;  // FAIL FAST on Lua compilation errors
         }
@@ -81,6 +355,87 @@ bool SignalProcessorDAG::setup_lua_environment() {
     lua_pushinteger(L, static_cast<int>(ValueType::STRUCT_ARRAY));
     lua_setglobal(L, "TYPE_STRUCT_ARRAY");
 
+    // Deferred evaluation primitive backed by timer_queue_
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_schedule_at, 1);
+    lua_setglobal(L, "schedule_at");
+
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_mark_pending, 1);
+    lua_setglobal(L, "mark_pending");
+
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_arm_budget, 1);
+    lua_setglobal(L, "arm_budget");
+
+    // Native windowed aggregation
+    luaL_newmetatable(L, kWindowMetatable);
+    lua_pushcfunction(L, lua_window_gc);
+    lua_setfield(L, -2, "__gc");
+    lua_pop(L, 1);
+    lua_pushcfunction(L, lua_window_new);
+    lua_setglobal(L, "window_new");
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_window_update, 1);
+    lua_setglobal(L, "window_update");
+
+    // Calibration tables
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_lookup, 1);
+    lua_setglobal(L, "lookup");
+
+    // Integrators
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_integrate, 1);
+    lua_setglobal(L, "integrate");
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_reset_integral, 1);
+    lua_setglobal(L, "reset_integral");
+
+    // Instruction budget hook finds the processor through the registry
+    lua_pushlightuserdata(L, this);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &kBudgetRegistryKey);
+
+    // Threshold events
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_hysteresis, 1);
+    lua_setglobal(L, "hysteresis");
+
+    // Signal history (upvalue 2: true for hist_time)
+    for (bool time : {false, true}) {
+        lua_pushlightuserdata(L, this);
+        lua_pushboolean(L, time);
+        lua_pushcclosure(L, &SignalProcessorDAG::lua_hist, 2);
+        lua_setglobal(L, time ? "hist_time" : "hist");
+    }
+
+    // Quantile sketches
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_sketch_add, 1);
+    lua_setglobal(L, "sketch_add");
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_sketch_quantile, 1);
+    lua_setglobal(L, "sketch_quantile");
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_sketch_reset, 1);
+    lua_setglobal(L, "sketch_reset");
+
+    // Fusion filters
+    const std::pair<const char*, int> kalman_variants[] = {
+        {"kalman", 1}, {"kalman_cv", 2}, {"kalman_ca", 3}};
+    for (const auto& [name, order] : kalman_variants) {
+        lua_pushlightuserdata(L, this);
+        lua_pushinteger(L, order);
+        lua_pushcclosure(L, &SignalProcessorDAG::lua_kalman, 2);
+        lua_setglobal(L, name);
+    }
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_kalman_fuse, 1);
+    lua_setglobal(L, "kalman_fuse");
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, &SignalProcessorDAG::lua_complementary, 1);
+    lua_setglobal(L, "complementary");
+
     const char* dag_lua_infrastructure = R"(
 -- Signal status constants (matching vss::types::SignalQuality enum)
 STATUS_UNKNOWN = 0
@@ -107,9 +462,6 @@ signal_status = {}
 -- Signal states (private to each signal)
 signal_states = {}
 
--- Signals with pending time-based operations (like delayed())
-signals_pending_reevaluation = {}
-
 -- Current signal context
 _current_signal = nil
 _current_provides = nil
@@ -118,32 +470,6 @@ _current_provides = nil
 deps = {}
 deps_status = {}
 
--- Create VSS signal
-function create_vss_signal(path, value, datatype, status)
-    -- datatype is now an integer (ValueType enum value from C++)
-    -- Default status to STATUS_VALID if not provided
-    status = status or STATUS_VALID
-
-    -- If value is nil, set status to invalid if not already set
-    if value == nil and status == STATUS_VALID then
-        status = STATUS_INVALID
-    end
-
-    -- Clean up float values to avoid displaying noise
-    if (datatype == TYPE_FLOAT or datatype == TYPE_DOUBLE) and type(value) == "number" then
-        if math.abs(value) < 1e-6 then
-            value = 0
-        end
-    end
-
-    return {
-        path = path,
-        value = value,
-        type = datatype,  -- Stores integer enum value
-        status = status
-    }
-end
-
 -- Get own state (each signal has private state)
 function get_state()
     if not _current_signal then
@@ -153,19 +479,19 @@ function get_state()
     return signal_states[_current_signal]
 end
 
--- Mark signal as needing re-evaluation (for time-based operations)
-function mark_pending()
-    if not _current_signal then
-        error("mark_pending() called outside signal context")
-    end
-    signals_pending_reevaluation[_current_signal] = true
+-- Deferred evaluation: schedule_at(t) (native) wakes the current signal once
+-- at _current_time t. Wakeups are per evaluation - a pending wakeup is dropped
+-- whenever the signal is evaluated, so helpers that still wait re-request it.
+-- When several are requested, the earliest wins.
+function schedule_in(delay_ms)
+    schedule_at(_current_time + delay_ms / 1000)
 end
 
+-- Kept for compatibility: wakeups are dropped on every evaluation anyway
 function clear_pending()
     if not _current_signal then
         error("clear_pending() called outside signal context")
     end
-    signals_pending_reevaluation[_current_signal] = nil
 end
 
 -- Provide value (only allowed to set own provided value)
@@ -306,7 +632,7 @@ end
 
 function rate_limit(value, max_rate)
     local state = get_state()
-    local t = os.clock()
+    local t = _current_time
     
     if state.rl_last_v == nil then
         state.rl_last_v = value
@@ -349,7 +675,7 @@ end
 
 function sustained_condition(condition, duration_ms)
     local state = get_state()
-    local now = os.clock() * 1000
+    local now = _current_time * 1000
     
     if condition then
         if not state.sc_start then
@@ -376,6 +702,10 @@ function falling_edge(value)
     return edge
 end
 
+function threshold_event(value, limit, debounce_ms)
+    return hysteresis(value, limit, limit, debounce_ms, debounce_ms)
+end
+
 function delayed(value, delay_ms)
     local state = get_state()
     local now = _current_time
@@ -384,22 +714,19 @@ function delayed(value, delay_ms)
     if state.delay_target_value ~= value then
         -- Value changed - start new delay timer
         state.delay_target_value = value
-        state.delay_start_time = now
+        state.delay_due = now + delay_ms / 1000
         state.delay_pending = true
-        mark_pending()  -- Immediately mark for re-evaluation
     end
 
     -- Check if delay has elapsed
     if state.delay_pending then
-        local elapsed_ms = (now - state.delay_start_time) * 1000  -- Convert seconds to milliseconds
-        if elapsed_ms >= delay_ms then
+        if now >= state.delay_due then
             -- Delay elapsed - output the target value
             state.delay_output_value = state.delay_target_value
             state.delay_pending = false
-            clear_pending()  -- No longer needs re-evaluation
         else
-            -- Still waiting - keep marked for re-evaluation
-            mark_pending()
+            -- Still waiting - wake up exactly when due
+            schedule_at(state.delay_due)
         end
     end
 
@@ -407,9 +734,160 @@ function delayed(value, delay_ms)
     return state.delay_output_value
 end
 
+-- Coroutine transforms (code declared with coroutine: true)
+--
+-- The body runs inside a coroutine and may suspend with wait(ms) or
+-- wait_for(dep [, timeout_ms]). While suspended, evaluations triggered by
+-- anything other than the awaited event return without resuming it. A value
+-- passed to emit() is published when the coroutine next suspends; a value
+-- returned from the body is published and the body restarts on the next trigger.
+function resume_transform_coroutine(body)
+    local state = get_state()
+    local w = state.co_wait
+    local dep_changed = false
+
+    if w then
+        if w.dep ~= nil and (deps[w.dep] ~= w.last or deps_status[w.dep] ~= w.last_status) then
+            dep_changed = true
+        elseif w.due == nil or _current_time < w.due then
+            -- Not our event; this evaluation consumed the wakeup, so re-arm it
+            if w.due ~= nil then schedule_at(w.due) end
+            return false
+        end
+    end
+
+    state.co = state.co or coroutine.create(body)
+    state.co_wait = nil
+    state.co_emitted = false
+
+    -- The coroutine may predate the current instruction budget
+    arm_budget(state.co)
+    local ok, result = coroutine.resume(state.co, dep_changed)
+    if not ok then
+        state.co = nil
+        error(result, 0)
+    end
+
+    if coroutine.status(state.co) == "dead" then
+        state.co = nil
+        return true, result
+    end
+    if state.co_emitted then
+        return true, state.co_output
+    end
+    return false
+end
+
+function wait(delay_ms)
+    if not coroutine.isyieldable() then
+        error("wait() called outside a coroutine transform")
+    end
+    local state = get_state()
+    state.co_wait = { due = _current_time + delay_ms / 1000 }
+    schedule_at(state.co_wait.due)
+    coroutine.yield()
+end
+
+-- Suspend until deps[dep] (or its status) changes; returns false on timeout
+function wait_for(dep, timeout_ms)
+    if not coroutine.isyieldable() then
+        error("wait_for() called outside a coroutine transform")
+    end
+    local state = get_state()
+    state.co_wait = { dep = dep, last = deps[dep], last_status = deps_status[dep] }
+    if timeout_ms ~= nil then
+        state.co_wait.due = _current_time + timeout_ms / 1000
+        schedule_at(state.co_wait.due)
+    end
+    return coroutine.yield()
+end
+
+-- Publish value from a coroutine transform at its next suspension
+function emit(value)
+    local state = get_state()
+    state.co_emitted = true
+    state.co_output = value
+end
+
+-- Integration (native trapezoidal integrator, one per signal)
+-- integrate(x [, max_gap_ms]) returns the running integral of x over input time
+-- in x-units * seconds; gaps longer than max_gap_ms (default 1000) and nil inputs
+-- are not integrated. reset_integral([total]) restarts it.
+function odometer(speed_kmh, max_gap_ms)
+    local total = integrate(speed_kmh, max_gap_ms)
+    return total / 3600  -- km
+end
+
+function energy(power_w, max_gap_ms)
+    local total = integrate(power_w, max_gap_ms)
+    return total / 3600  -- Wh
+end
+
+-- Windowed aggregation (native ring buffers, see window_aggregator.h)
+--
+-- window_<agg>(x, ms) / window_<agg>_n(x, n): sliding window by time / count
+-- tumbling_<agg>(x, ms) / tumbling_<agg>_n(x, n): last completed tumbling window
+-- with agg one of mean, min, max, last. Aggregates of the same window in one
+-- transform share its buffer, so apply them to the same value. A transform using
+-- a tumbling window publishes only when the window closes; time-based ones are
+-- woken at each window boundary.
+WINDOW_SLIDING_TIME = 0
+WINDOW_SLIDING_COUNT = 1
+WINDOW_TUMBLING_TIME = 2
+WINDOW_TUMBLING_COUNT = 3
+
+-- Set by helpers that have nothing to publish in this evaluation
+_suppress_output = false
+
+function window_aggregate(value, kind, size, agg)
+    local state = get_state()
+    state.windows = state.windows or {}
+    local by_size = state.windows[kind]
+    if by_size == nil then
+        by_size = {}
+        state.windows[kind] = by_size
+    end
+    local w = by_size[size]
+    if w == nil then
+        w = window_new(kind, size)
+        by_size[size] = w
+    end
+
+    local result, boundary, closed = window_update(w, value, _current_time, agg)
+    if boundary ~= nil then
+        schedule_at(boundary)
+    end
+    if kind >= WINDOW_TUMBLING_TIME and not closed then
+        _suppress_output = true
+    end
+    return result
+end
+
+for _, agg in ipairs({"mean", "min", "max", "last"}) do
+    _G["window_" .. agg] = function(value, window_ms)
+        return window_aggregate(value, WINDOW_SLIDING_TIME, window_ms, agg)
+    end
+    _G["window_" .. agg .. "_n"] = function(value, count)
+        return window_aggregate(value, WINDOW_SLIDING_COUNT, count, agg)
+    end
+    _G["tumbling_" .. agg] = function(value, window_ms)
+        return window_aggregate(value, WINDOW_TUMBLING_TIME, window_ms, agg)
+    end
+    _G["tumbling_" .. agg .. "_n"] = function(value, count)
+        return window_aggregate(value, WINDOW_TUMBLING_COUNT, count, agg)
+    end
+end
+
+-- DBC value descriptions of input signals from compiled artifacts,
+-- e.g. signal_enums['Vehicle.Gear'].DRIVE
+signal_enums = {}
+
 -- Transform functions table
 transform_functions = {}
 
+-- Transform factories of mapping templates: factory(signal_name, index)
+transform_templates = {}
+
 -- Process signal with context
 function process_signal(signal_name, value)
     local transform_func = transform_functions[signal_name]
@@ -417,19 +895,90 @@ function process_signal(signal_name, value)
         if type(transform_func) ~= "function" then
             error("Transform for " .. signal_name .. " is not a function but a " .. type(transform_func))
         end
-        return transform_func(value)
+        _suppress_output = false
+        local result, status = transform_func(value)
+        if _suppress_output then
+            return
+        end
+        return result, status
     end
-    return nil
 end
 )";
 
     return lua_mapper_->execute_lua_string(dag_lua_infrastructure);
 }
 
+void SignalProcessorDAG::load_enum_tables() {
+    // signal_enums[signal][label] = value
+    lua_State* L = lua_mapper_->get_lua_state();
+    lua_getglobal(L, "signal_enums");
+    for (const auto& [signal, values] : plan_->enum_tables) {
+        lua_createtable(L, 0, static_cast<int>(values.size()));
+        for (const auto& [label, value] : values) {
+            lua_pushinteger(L, static_cast<lua_Integer>(value));
+            lua_setfield(L, -2, label.c_str());
+        }
+        lua_setfield(L, -2, signal.c_str());
+    }
+    lua_pop(L, 1);
+}
+
 bool SignalProcessorDAG::generate_transform_function(const SignalNode* node) {
+    if (plan_) {
+        auto chunk = plan_->transform_chunks.find(node->signal_name);
+        if (chunk != plan_->transform_chunks.end()) {
+            return execute_transform_chunk(node, chunk->second);
+        }
+    }
+    std::string name = "'" + node->signal_name + "'";
+    std::string lua = "transform_functions[" + name + "] = (function()\n" +
+                      generate_transform_factory(node, node->mapping.transform, name) + "end)()\n";
+    return execute_transform_code(node, lua);
+}
+
+bool SignalProcessorDAG::generate_template_factory(const SignalNode* node) {
+    const auto& tmpl = *node->mapping.instance_of;
+    if (plan_) {
+        auto chunk = plan_->template_chunks.find(tmpl.name);
+        if (chunk != plan_->template_chunks.end()) {
+            return execute_transform_chunk(node, chunk->second);
+        }
+    }
+    std::string lua = "transform_templates['" + tmpl.name + "'] = function(signal_name, " +
+                      tmpl.variable + ")\n" +
+                      generate_transform_factory(node, tmpl.transform, "signal_name") + "end\n";
+    return execute_transform_code(node, lua);
+}
+
+bool SignalProcessorDAG::instantiate_template(const SignalNode* node) {
+    // transform_functions[name] = transform_templates[template](name, index)
+    lua_State* L = lua_mapper_->get_lua_state();
+    lua_getglobal(L, "transform_functions");
+    lua_getglobal(L, "transform_templates");
+    lua_getfield(L, -1, node->mapping.instance_of->name.c_str());
+    lua_pushstring(L, node->signal_name.c_str());
+    lua_pushinteger(L, static_cast<lua_Integer>(node->mapping.template_index));
+    if (lua_pcall(L, 2, 1, 0) != LUA_OK) {
+        LOG(ERROR) << "Failed to instantiate template for signal " << node->signal_name << ": "
+                   << lua_tostring(L, -1);
+        lua_pop(L, 3);
+        return false;
+    }
+    lua_setfield(L, -3, node->signal_name.c_str());
+    lua_pop(L, 2);
+    return true;
+}
+
+std::string SignalProcessorDAG::generate_transform_factory(const SignalNode* node,
+                                                           const Transform& transform,
+                                                           const std::string& name) {
+    if (const auto* code = std::get_if<CodeTransform>(&transform); code && code->coroutine) {
+        return generate_coroutine_transform(node, *code, name);
+    }
+
     std::stringstream lua;
     
-    lua << "transform_functions['" << node->signal_name << "'] = function(value)\n";
+    lua << "return function(value)\n";
     
     // For derived signals, value parameter is ignored
     if (!node->is_input_signal) {
@@ -437,13 +986,13 @@ bool SignalProcessorDAG::generate_transform_function(const SignalNode* node) {
     }
     
     // Handle different transform types
-    if (std::holds_alternative<CodeTransform>(node->mapping.transform)) {
-        const auto& code = std::get<CodeTransform>(node->mapping.transform);
+    if (std::holds_alternative<CodeTransform>(transform)) {
+        const auto& code = std::get<CodeTransform>(transform);
         
         if (node->is_input_signal) {
             // Check signal status and set x to nil if invalid/NA
             lua << "    local x = value\n";
-            lua << "    local my_status = signal_status['" << node->signal_name << "'] or STATUS_VALID\n";
+            lua << "    local my_status = signal_status[" << name << "] or STATUS_VALID\n";
             lua << "    if my_status ~= STATUS_VALID then\n";
             lua << "        x = nil\n";
             lua << "    end\n";
@@ -475,8 +1024,7 @@ bool SignalProcessorDAG::generate_transform_function(const SignalNode* node) {
             if (!node->is_input_signal) {
                 lua << "    if result == nil then my_status = STATUS_INVALID end\n";
             }
-            lua << "    return create_vss_signal('" << node->signal_name
-                << "', result, " << static_cast<int>(node->mapping.datatype) << ", my_status)\n";
+            lua << "    return result, my_status\n";
         } else {
             // Single-line expression
             lua << "    local result = " << code.expression << "\n";
@@ -488,16 +1036,15 @@ bool SignalProcessorDAG::generate_transform_function(const SignalNode* node) {
             if (!node->is_input_signal) {
                 lua << "    if result == nil then my_status = STATUS_INVALID end\n";
             }
-            lua << "    return create_vss_signal('" << node->signal_name
-                << "', result, " << static_cast<int>(node->mapping.datatype) << ", my_status)\n";
+            lua << "    return result, my_status\n";
         }
             
-    } else if (std::holds_alternative<ValueMapping>(node->mapping.transform)) {
-        const auto& value_map = std::get<ValueMapping>(node->mapping.transform);
+    } else if (std::holds_alternative<ValueMapping>(transform)) {
+        const auto& value_map = std::get<ValueMapping>(transform);
         
         // Set up status tracking
         if (node->is_input_signal) {
-            lua << "    local my_status = signal_status['" << node->signal_name << "'] or STATUS_VALID\n";
+            lua << "    local my_status = signal_status[" << name << "] or STATUS_VALID\n";
         } else {
             lua << "    local my_status = STATUS_VALID\n";
         }
@@ -539,16 +1086,15 @@ bool SignalProcessorDAG::generate_transform_function(const SignalNode* node) {
         
         // For derived signals, set invalid if result is nil
         if (!node->is_input_signal) {
-            lua << "    if result == nil then my_status = 'invalid' end\n";
+            lua << "    if result == nil then my_status = STATUS_INVALID end\n";
         }
-        lua << "    return create_vss_signal('" << node->signal_name
-            << "', result, " << static_cast<int>(node->mapping.datatype) << ", my_status)\n";
+        lua << "    return result, my_status\n";
         
     } else {
         // DirectMapping
         if (node->is_input_signal) {
             lua << "    local result = value\n";
-            lua << "    local my_status = signal_status['" << node->signal_name << "'] or STATUS_VALID\n";
+            lua << "    local my_status = signal_status[" << name << "] or STATUS_VALID\n";
             lua << "    if my_status ~= STATUS_VALID then\n";
             lua << "        result = nil\n";
             lua << "    end\n";
@@ -563,14 +1109,71 @@ bool SignalProcessorDAG::generate_transform_function(const SignalNode* node) {
         if (node->is_input_signal) {
             lua << "    -- Status already set from signal_status table\n";
         }
-        lua << "    return create_vss_signal('" << node->signal_name
-            << "', result, " << static_cast<int>(node->mapping.datatype) << ", my_status)\n";
+        lua << "    return result, my_status\n";
     }
     
     lua << "end\n";
 
-    std::string lua_code = lua.str();
-    if (!lua_mapper_->execute_lua_string(lua_code)) {
+    return lua.str();
+}
+
+std::string SignalProcessorDAG::generate_coroutine_transform(const SignalNode* node,
+                                                             const CodeTransform& code,
+                                                             const std::string& name) {
+    std::stringstream lua;
+
+    // The body is created once per factory call so that the suspended coroutine
+    // keeps running the same closure; x is an upvalue refreshed on every evaluation.
+    lua << "local x\n";
+    lua << "local function body()\n";
+    std::istringstream expr_stream(code.expression);
+    std::string line;
+    while (std::getline(expr_stream, line)) {
+        if (!line.empty()) {
+            lua << "    " << line << "\n";
+        }
+    }
+    lua << "end\n";
+
+    lua << "return function(value)\n";
+    if (node->is_input_signal) {
+        lua << "    x = value\n";
+        lua << "    local my_status = signal_status[" << name << "] or STATUS_VALID\n";
+        lua << "    if my_status ~= STATUS_VALID then\n";
+        lua << "        x = nil\n";
+        lua << "    end\n";
+    } else {
+        lua << "    local my_status = STATUS_VALID\n";
+    }
+
+    // Nothing is published while the coroutine waits for an event that has not fired
+    lua << "    local published, result = resume_transform_coroutine(body)\n";
+    lua << "    if not published then return end\n";
+    lua << "    if result ~= nil then provide(result) end\n";
+    if (!node->is_input_signal) {
+        lua << "    if result == nil then my_status = STATUS_INVALID end\n";
+    }
+    lua << "    return result, my_status\n";
+    lua << "end\n";
+
+    return lua.str();
+}
+
+bool SignalProcessorDAG::execute_transform_code(const SignalNode* node, const std::string& lua_code) {
+    const auto& chunk_name = node->mapping.instance_of ? node->mapping.instance_of->name
+                                                       : node->signal_name;
+    if (recorded_plan_) {
+        // Run the recorded bytecode, as initialize() from the plan will
+        auto& chunks = node->mapping.instance_of ? recorded_plan_->template_chunks
+                                                 : recorded_plan_->transform_chunks;
+        std::string& bytecode = chunks[chunk_name];
+        if (!lua_mapper_->compile_lua_string(lua_code, chunk_name, bytecode)) {
+            LOG(ERROR) << "Failed to compile Lua transform for signal: " << node->signal_name;
+            return false;
+        }
+        return execute_transform_chunk(node, bytecode);
+    }
+    if (!lua_mapper_->execute_lua_string(lua_code, chunk_name)) {
         LOG(ERROR) << "Failed to execute Lua transform for signal: " << node->signal_name;
         return false;
     }
@@ -579,16 +1182,33 @@ bool SignalProcessorDAG::generate_transform_function(const SignalNode* node) {
     return true;
 }
 
+bool SignalProcessorDAG::execute_transform_chunk(const SignalNode* node, const std::string& bytecode) {
+    const auto& chunk_name = node->mapping.instance_of ? node->mapping.instance_of->name
+                                                       : node->signal_name;
+    if (!lua_mapper_->execute_lua_bytecode(bytecode, chunk_name)) {
+        LOG(ERROR) << "Failed to load precompiled Lua transform for signal: " << node->signal_name;
+        return false;
+    }
+
+    VLOG(2) << "Loaded precompiled transform for " << node->signal_name;
+    return true;
+}
+
 // process_can_signals method removed - functionality merged into process_signal_updates
 
 std::optional<VSSSignal> SignalProcessorDAG::process_node(SignalNode* node) {
     // Set up context
     setup_node_context(node);
+
+    // Any pending wakeup is consumed by this evaluation; the transform
+    // re-requests one through schedule_at() if it still needs it
+    timer_queue_.cancel(node);
+    ++evaluation_seq_;
     
     // Get input value - now typed
     std::variant<int64_t, double, std::string> input_value;
     if (node->is_input_signal) {
-        auto it = signal_values_.find(node->signal_name);
+        auto it = signal_values_.find(node->symbol);
         if (it != signal_values_.end() &&
             it->second.quality != vss::types::SignalQuality::VALID) {
             // For invalid/NA signals, we'll pass a special marker value
@@ -658,7 +1278,7 @@ std::optional<VSSSignal> SignalProcessorDAG::process_node(SignalNode* node) {
         if (lua_istable(L, -1)) {
             lua_pushstring(L, node->signal_name.c_str());
 
-            auto it = signal_values_.find(node->signal_name);
+            auto it = signal_values_.find(node->symbol);
             int status_val = 0;  // STATUS_VALID
             if (it != signal_values_.end()) {
                 status_val = static_cast<int>(it->second.quality);
@@ -671,34 +1291,119 @@ std::optional<VSSSignal> SignalProcessorDAG::process_node(SignalNode* node) {
     
     // Call transform function
     lua_mapper_->set_can_signal_value(node->signal_name, lua_input);
-    auto result = lua_mapper_->call_transform_function(node->signal_name, lua_input);
+    current_node_ = node;
+    budget_exceeded_ = false;
+    auto result = call_transform_with_budget(node, lua_input);
+    current_node_ = nullptr;
+
+    // Over budget: the evaluation was aborted, publish the signal as invalid
+    if (budget_exceeded_) {
+        auto& stored = signal_values_[node->symbol];
+        stored.quality = SignalQuality::INVALID;
+        stored.timestamp = clock_->wall_time();
+
+        VSSSignal invalid;
+        invalid.path = node->symbol;
+        invalid.qualified_value.quality = SignalQuality::INVALID;
+        invalid.qualified_value.timestamp = stored.timestamp;
+        return invalid;
+    }
     
     // Update provided value if transform succeeded
     if (result.has_value()) {
-        // Get the provided value from Lua
-        auto provided_value = lua_mapper_->get_lua_variable("signal_values['" + node->signal_name + "']");
-        if (provided_value.has_value()) {
-            // Try to determine the type and store appropriately
-            try {
-                // Check if it's an integer
-                double d = std::stod(provided_value.value());
-                if (std::floor(d) == d && d >= std::numeric_limits<int64_t>::min() && d <= std::numeric_limits<int64_t>::max()) {
-                    signal_values_[node->signal_name].value = static_cast<int64_t>(d);
-                } else {
-                    signal_values_[node->signal_name].value = d;
-                }
-            } catch (...) {
-                // Store as string if conversion fails
-                signal_values_[node->signal_name].value = provided_value.value();
-            }
-            signal_values_[node->signal_name].quality = SignalQuality::VALID;
-            signal_values_[node->signal_name].timestamp = std::chrono::system_clock::now();
+        // Read the provided value straight from the Lua table
+        lua_State* L = lua_mapper_->get_lua_state();
+        lua_getglobal(L, "signal_values");
+        lua_getfield(L, -1, node->signal_name.c_str());
+        if (!lua_isnil(L, -1)) {
+            auto& stored = signal_values_[node->symbol];
+            stored.value = provided_value_from_lua(L, -1);
+            stored.quality = SignalQuality::VALID;
+            stored.timestamp = clock_->wall_time();
         }
+        lua_pop(L, 2);
     }
     
     return result;
 }
 
+std::optional<VSSSignal> SignalProcessorDAG::call_transform_with_budget(SignalNode* node, double input) {
+    uint64_t limit = node->mapping.max_instructions > 0 ? node->mapping.max_instructions
+                                                          : budget_.node_instructions;
+    bool batch_limited = budget_.batch_instructions > 0;
+    if (limit == 0 && !batch_limited) {
+        return lua_mapper_->call_transform_values(node->signal_name, input, node->symbol, node->codec);
+    }
+
+    bool limited_by_batch = false;
+    if (batch_limited) {
+        uint64_t remaining = budget_.batch_instructions > batch_instructions_used_
+            ? budget_.batch_instructions - batch_instructions_used_ : 0;
+        if (limit == 0 || remaining < limit) {
+            limit = remaining;
+            limited_by_batch = true;
+        }
+    }
+
+    ++metrics_.evaluations;
+    if (limit == 0) {
+        // Batch budget already spent: do not run the transform at all
+        budget_exceeded_ = true;
+    } else {
+        lua_State* L = lua_mapper_->get_lua_state();
+        budget_limit_ = limit;
+        budget_used_ = 0;
+        budget_step_ = std::min<uint64_t>(limit, kBudgetHookInterval);
+        lua_sethook(L, &SignalProcessorDAG::lua_budget_hook, LUA_MASKCOUNT, static_cast<int>(budget_step_));
+
+        auto result = lua_mapper_->call_transform_values(node->signal_name, input, node->symbol, node->codec);
+
+        lua_sethook(L, nullptr, 0, 0);
+        budget_limit_ = 0;
+        batch_instructions_used_ += budget_used_;
+        metrics_.instructions += budget_used_;
+        if (!budget_exceeded_) {
+            return result;
+        }
+    }
+
+    if (limited_by_batch) {
+        ++metrics_.batch_budget_exceeded;
+    } else {
+        ++metrics_.node_budget_exceeded;
+    }
+    ++metrics_.exceeded_by_signal[node->signal_name];
+    return std::nullopt;
+}
+
+void SignalProcessorDAG::lua_budget_hook(lua_State* L, lua_Debug* /*ar*/) {
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &kBudgetRegistryKey);
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (!self || self->budget_limit_ == 0) {
+        return;  // Hook inherited by a coroutine, no budget running
+    }
+
+    self->budget_used_ += self->budget_step_;
+    if (self->budget_used_ >= self->budget_limit_) {
+        self->budget_exceeded_ = true;
+        luaL_error(L, "instruction budget exceeded");
+    }
+}
+
+int SignalProcessorDAG::lua_arm_budget(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    luaL_checktype(L, 1, LUA_TTHREAD);
+    lua_State* co = lua_tothread(L, 1);
+    if (self->budget_limit_ > 0) {
+        lua_sethook(co, &SignalProcessorDAG::lua_budget_hook, LUA_MASKCOUNT,
+                    static_cast<int>(self->budget_step_));
+    } else {
+        lua_sethook(co, nullptr, 0, 0);
+    }
+    return 0;
+}
+
 void SignalProcessorDAG::setup_node_context(const SignalNode* node) {
     lua_State* L = lua_mapper_->get_lua_state();
     
@@ -707,19 +1412,44 @@ void SignalProcessorDAG::setup_node_context(const SignalNode* node) {
     lua_setglobal(L, "_current_signal");
     
     // Set current timestamp (seconds since epoch with microsecond precision)
-    auto now = std::chrono::steady_clock::now();
-    auto epoch = now.time_since_epoch();
-    auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(epoch).count();
-    lua_pushnumber(L, seconds);
+    lua_pushnumber(L, lua_time_from_steady(clock_->now()));
     lua_setglobal(L, "_current_time");
     
     // Create deps table
     lua_newtable(L);
+
+    // Time-aligned dependencies come from the join instead of the latest values
+    if (node->mapping.join_policy != JoinPolicy::LATEST) {
+        auto join_it = joins_.find(node);
+        if (join_it != joins_.end()) {
+            const auto& join = join_it->second;
+            for (size_t i = 0; i < node->depends_on.size(); ++i) {
+                const auto& sample = join.aligned(i);
+                lua_pushstring(L, node->depends_on[i].c_str());
+                if (sample.quality == vss::types::SignalQuality::VALID) {
+                    VSSTypeHelper::push_value_to_lua(L, sample.value);
+                } else {
+                    lua_pushnil(L);
+                }
+                lua_settable(L, -3);
+            }
+            lua_setglobal(L, "deps");
+
+            lua_newtable(L);
+            for (size_t i = 0; i < node->depends_on.size(); ++i) {
+                lua_pushstring(L, node->depends_on[i].c_str());
+                lua_pushinteger(L, static_cast<int>(join.aligned(i).quality));
+                lua_settable(L, -3);
+            }
+            lua_setglobal(L, "deps_status");
+            return;
+        }
+    }
     
-    for (const auto& dep : node->depends_on) {
-        auto it = signal_values_.find(dep);
+    for (size_t i = 0; i < node->depends_on.size(); ++i) {
+        auto it = signal_values_.find(node->dependency_symbols[i]);
         // Push key
-        lua_pushstring(L, dep.c_str());
+        lua_pushstring(L, node->depends_on[i].c_str());
 
         if (it != signal_values_.end() && it->second.quality == vss::types::SignalQuality::VALID) {
             // Push typed value only if quality is VALID
@@ -739,10 +1469,10 @@ void SignalProcessorDAG::setup_node_context(const SignalNode* node) {
     // Create deps_status table
     lua_newtable(L);
 
-    for (const auto& dep : node->depends_on) {
-        auto it = signal_values_.find(dep);
+    for (size_t i = 0; i < node->depends_on.size(); ++i) {
+        auto it = signal_values_.find(node->dependency_symbols[i]);
         if (it != signal_values_.end()) {
-            lua_pushstring(L, dep.c_str());
+            lua_pushstring(L, node->depends_on[i].c_str());
 
             // Push status as integer matching Lua constants
             int status_val = static_cast<int>(it->second.quality);
@@ -755,6 +1485,612 @@ void SignalProcessorDAG::setup_node_context(const SignalNode* node) {
     lua_setglobal(L, "deps_status");
 }
 
+std::optional<std::chrono::steady_clock::time_point> SignalProcessorDAG::next_wakeup() const {
+    if (deferred_work_) {
+        return clock_->now();  // Work deferred by the batch deadline
+    }
+
+    auto next = timer_queue_.next_deadline();
+
+    for (const auto* node : periodic_nodes_) {
+        if (node->last_process == std::chrono::steady_clock::time_point::min()) {
+            continue;  // First run happens once its dependencies arrive
+        }
+        auto due = node->last_process + std::chrono::milliseconds(node->mapping.interval_ms);
+        if (!next || due < *next) {
+            next = due;
+        }
+    }
+
+    for (const auto& resampler : resamplers_) {
+        auto due = resampler->next_emit();
+        if (!next || due < *next) {
+            next = due;
+        }
+    }
+
+    return next;
+}
+
+int SignalProcessorDAG::lua_schedule_at(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    double t = luaL_checknumber(L, 1);
+
+    if (!self->current_node_) {
+        return luaL_error(L, "schedule_at() called outside signal context");
+    }
+
+    self->timer_queue_.schedule(self->current_node_, steady_from_lua_time(t));
+    return 0;
+}
+
+int SignalProcessorDAG::lua_mark_pending(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    SignalNode* node = self->current_node_;
+    if (!node) {
+        return luaL_error(L, "mark_pending() called outside signal context");
+    }
+
+    // A wakeup at the current time would be due again right away and keep
+    // the caller's run loop spinning; wait for the next periodic deadline
+    auto delay = node->mapping.interval_ms > 0 ? std::chrono::milliseconds(node->mapping.interval_ms)
+                                                : kMinPendingDelay;
+    self->timer_queue_.schedule(node, self->clock_->now() + delay);
+    return 0;
+}
+
+int SignalProcessorDAG::lua_hysteresis(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    std::optional<double> value;
+    if (!lua_isnoneornil(L, 1)) {
+        value = luaL_checknumber(L, 1);
+    }
+    Hysteresis::Config config;
+    config.on = luaL_checknumber(L, 2);
+    config.off = luaL_checknumber(L, 3);
+    auto on_debounce_ms = luaL_optnumber(L, 4, 0.0);
+    config.on_debounce = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(on_debounce_ms));
+    config.off_debounce = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(luaL_optnumber(L, 5, on_debounce_ms)));
+
+    if (!self->current_node_) {
+        return luaL_error(L, "hysteresis() called outside signal context");
+    }
+
+    auto result = self->hysteresis_[self->current_node_].update(self->clock_->now(), value, config);
+    if (result.wake_at) {
+        // Confirm the transition when the debounce expires, without new input
+        self->timer_queue_.schedule(self->current_node_, *result.wake_at);
+    }
+    if (!result.changed) {
+        lua_pushboolean(L, 1);
+        lua_setglobal(L, "_suppress_output");
+    }
+    lua_pushboolean(L, result.state);
+    return 1;
+}
+
+int SignalProcessorDAG::lua_window_update(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    auto* w = static_cast<LuaWindow*>(luaL_checkudata(L, 1, kWindowMetatable));
+    bool has_value = !lua_isnoneornil(L, 2);
+    double value = has_value ? luaL_checknumber(L, 2) : 0.0;
+    auto now = steady_from_lua_time(luaL_checknumber(L, 3));
+    const char* agg = luaL_checkstring(L, 4);
+
+    // Only the first aggregate of a shared window adds the sample
+    bool push = has_value && w->last_sample_evaluation != self->evaluation_seq_;
+    if (push) {
+        w->last_sample_evaluation = self->evaluation_seq_;
+    }
+
+    std::optional<WindowStats> stats;
+    std::optional<std::chrono::steady_clock::time_point> boundary;
+    if (auto* sliding = std::get_if<SlidingWindow>(&w->window)) {
+        if (push) {
+            sliding->push(now, value);
+        } else {
+            sliding->expire(now);
+        }
+        stats = sliding->stats();
+    } else {
+        auto& tumbling = std::get<TumblingWindow>(w->window);
+        bool closed = push ? tumbling.push(now, value) : tumbling.advance(now);
+        if (closed) {
+            w->last_closed_evaluation = self->evaluation_seq_;
+        }
+        stats = tumbling.completed();
+        boundary = tumbling.next_boundary();
+    }
+
+    if (!stats) {
+        lua_pushnil(L);
+    } else if (std::strcmp(agg, "mean") == 0) {
+        lua_pushnumber(L, stats->mean());
+    } else if (std::strcmp(agg, "min") == 0) {
+        lua_pushnumber(L, stats->min);
+    } else if (std::strcmp(agg, "max") == 0) {
+        lua_pushnumber(L, stats->max);
+    } else if (std::strcmp(agg, "last") == 0) {
+        lua_pushnumber(L, stats->last);
+    } else {
+        return luaL_error(L, "unknown window aggregate '%s'", agg);
+    }
+
+    if (boundary) {
+        lua_pushnumber(L, lua_time_from_steady(*boundary));
+    } else {
+        lua_pushnil(L);
+    }
+    lua_pushboolean(L, w->last_closed_evaluation == self->evaluation_seq_);
+    return 3;
+}
+
+bool SignalProcessorDAG::compile_lookup_tables() {
+    lookup_tables_.clear();
+
+    for (const auto* node : dag_->get_processing_order()) {
+        for (const auto& [name, spec] : node->mapping.lookup_tables) {
+            auto table = LookupTable::compile(name, spec);
+            if (!table) {
+                LOG(ERROR) << "Invalid lookup table '" << name << "' for signal: " << node->signal_name;
+                return false;
+            }
+            lookup_tables_[node].emplace_back(name, std::move(*table));
+        }
+    }
+
+    return true;
+}
+
+int SignalProcessorDAG::lua_integrate(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    if (!self->current_node_) {
+        return luaL_error(L, "integrate() called outside signal context");
+    }
+
+    auto& integrator = self->integrators_[self->current_node_];
+    if (lua_isnoneornil(L, 1)) {
+        integrator.break_chain();
+        lua_pushnumber(L, integrator.total());
+        return 1;
+    }
+
+    double value = luaL_checknumber(L, 1);
+    auto max_gap = Integrator::kDefaultMaxGap;
+    if (!lua_isnoneornil(L, 2)) {
+        max_gap = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(luaL_checknumber(L, 2)));
+    }
+
+    // Integrate over input time, not processing time
+    lua_pushnumber(L, integrator.add(self->current_node_->last_update, value, max_gap));
+    return 1;
+}
+
+int SignalProcessorDAG::lua_reset_integral(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    if (!self->current_node_) {
+        return luaL_error(L, "reset_integral() called outside signal context");
+    }
+    self->integrators_[self->current_node_].reset(luaL_optnumber(L, 1, 0.0));
+    return 0;
+}
+
+void SignalProcessorDAG::setup_joins() {
+    joins_.clear();
+    join_feeds_.clear();
+
+    for (const auto* node : dag_->get_processing_order()) {
+        if (node->mapping.join_policy == JoinPolicy::LATEST || node->depends_on.empty()) {
+            continue;
+        }
+        auto [it, inserted] = joins_.emplace(
+            node, DependencyJoin(node->mapping.join_policy,
+                                 std::chrono::milliseconds(node->mapping.join_tolerance_ms),
+                                 node->depends_on.size()));
+        for (size_t i = 0; i < node->depends_on.size(); ++i) {
+            if (const auto* dep = dag_->get_node(node->dependency_symbols[i])) {
+                join_feeds_[dep].emplace_back(&it->second, i);
+            }
+        }
+    }
+}
+
+void SignalProcessorDAG::record_sample(const SignalNode* node, const Value& value,
+                                       SignalQuality quality) {
+    if (auto it = histories_.find(node); it != histories_.end()) {
+        it->second.push(node->last_update, value, quality);
+    }
+
+    if (auto it = join_feeds_.find(node); it != join_feeds_.end()) {
+        for (auto& [join, index] : it->second) {
+            join->record(index, node->last_update, value, quality);
+        }
+    }
+
+    if (auto it = resample_feeds_.find(node); it != resample_feeds_.end()) {
+        double sample = std::numeric_limits<double>::quiet_NaN();
+        if (quality == SignalQuality::VALID) {
+            std::visit([&sample](auto&& v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_arithmetic_v<T>) {
+                    sample = static_cast<double>(v);
+                }
+            }, value);
+        }
+        for (auto& [resampler, column] : it->second) {
+            resampler->record(column, node->last_update, sample);
+        }
+    }
+}
+
+int SignalProcessorDAG::lua_hist(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    bool time = lua_toboolean(L, lua_upvalueindex(2));
+    const char* name = luaL_checkstring(L, 1);
+    lua_Integer k = luaL_optinteger(L, 2, 0);
+
+    const SignalNode* current = self->current_node_;
+    if (!current) {
+        return luaL_error(L, "hist() called outside signal context");
+    }
+
+    // Only the signal itself and its dependencies are ordered before it
+    const SignalNode* node = nullptr;
+    auto dep = std::find(current->depends_on.begin(), current->depends_on.end(), name);
+    if (current->signal_name == name) {
+        node = current;
+    } else if (dep != current->depends_on.end()) {
+        node = self->dag_->get_node(current->dependency_symbols[dep - current->depends_on.begin()]);
+    }
+    if (!node) {
+        return luaL_error(L, "hist(): %s is not a dependency of %s", name, current->signal_name.c_str());
+    }
+
+    auto it = self->histories_.find(node);
+    if (it == self->histories_.end()) {
+        return luaL_error(L, "hist(): no history configured for %s", name);
+    }
+
+    const SignalHistory::Sample* sample = k >= 0 ? it->second.at(static_cast<size_t>(k)) : nullptr;
+    if (!sample || sample->quality != SignalQuality::VALID) {
+        lua_pushnil(L);
+    } else if (time) {
+        lua_pushnumber(L, lua_time_from_steady(sample->timestamp));
+    } else {
+        VSSTypeHelper::push_value_to_lua(L, sample->value);
+    }
+    return 1;
+}
+
+bool SignalProcessorDAG::add_resample_group(const ResampleGroup& group) {
+    if (group.period_ms <= 0 || group.delay_ms < 0) {
+        LOG(ERROR) << "Resample group '" << group.name << "' needs period_ms > 0 and delay_ms >= 0";
+        return false;
+    }
+    for (const auto& column : group.columns) {
+        if (!dag_->get_node(column.signal)) {
+            LOG(ERROR) << "Resample group '" << group.name << "' references unknown signal: "
+                       << column.signal;
+            return false;
+        }
+    }
+
+    resamplers_.push_back(std::make_unique<Resampler>(group, clock_->now()));
+    auto* resampler = resamplers_.back().get();
+    for (size_t i = 0; i < group.columns.size(); ++i) {
+        resample_feeds_[dag_->get_node(group.columns[i].signal)].emplace_back(resampler, i);
+    }
+    return true;
+}
+
+void SignalProcessorDAG::set_resample_handler(Resampler::RowHandler handler) {
+    resample_handler_ = std::move(handler);
+}
+
+int SignalProcessorDAG::lua_kalman(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    auto order = lua_tointeger(L, lua_upvalueindex(2));
+    if (!self->current_node_) {
+        return luaL_error(L, "kalman() called outside signal context");
+    }
+
+    auto& state = self->fusion_states_[self->current_node_];
+    auto now = self->current_node_->last_update;
+    switch (order) {
+        case 1:
+            return kalman_step(L, state.scalar, now, random_walk_model);
+        case 2:
+            return kalman_step(L, state.velocity, now, constant_velocity_model);
+        default:
+            return kalman_step(L, state.acceleration, now, constant_acceleration_model);
+    }
+}
+
+int SignalProcessorDAG::lua_kalman_fuse(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    if (!self->current_node_) {
+        return luaL_error(L, "kalman_fuse() called outside signal context");
+    }
+
+    // kalman_fuse(rate, q, z1, r1 [, z2, r2 ...]); nil rate / measurements are skipped
+    bool has_rate = !lua_isnoneornil(L, 1);
+    double rate = has_rate ? luaL_checknumber(L, 1) : 0.0;
+    double q = luaL_checknumber(L, 2);
+    int top = lua_gettop(L);
+
+    auto& slot = self->fusion_states_[self->current_node_].fused;
+    double dt = slot.step(self->current_node_->last_update);
+    auto& kf = slot.filter;
+
+    if (kf.initialized() && dt > 0.0) {
+        KalmanFilter<1>::Matrix F, Q;
+        random_walk_model(dt, q, F, Q);
+        kf.predict(F, Q, {rate * dt});
+    }
+
+    for (int i = 3; i + 1 <= top; i += 2) {
+        if (lua_isnil(L, i)) {
+            continue;
+        }
+        double z = luaL_checknumber(L, i);
+        double r = luaL_checknumber(L, i + 1);
+        if (!kf.initialized()) {
+            kf.initialize({z}, {r});
+        } else {
+            kf.update({1.0}, z, r);
+        }
+    }
+
+    if (!kf.initialized()) {
+        lua_pushnil(L);
+    } else {
+        lua_pushnumber(L, kf.state()[0]);
+    }
+    return 1;
+}
+
+int SignalProcessorDAG::lua_complementary(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    if (!self->current_node_) {
+        return luaL_error(L, "complementary() called outside signal context");
+    }
+
+    // complementary(rate, measurement, tau_s)
+    double rate = luaL_optnumber(L, 1, 0.0);
+    bool has_measurement = !lua_isnoneornil(L, 2);
+    double tau = luaL_checknumber(L, 3);
+
+    auto& slot = self->fusion_states_[self->current_node_].complementary;
+    double dt = slot.step(self->current_node_->last_update);
+    auto& filter = slot.filter;
+
+    if (has_measurement) {
+        lua_pushnumber(L, filter.update(dt, rate, luaL_checknumber(L, 2), tau));
+    } else if (filter.initialized()) {
+        lua_pushnumber(L, filter.predict(dt, rate));
+    } else {
+        lua_pushnil(L);
+    }
+    return 1;
+}
+
+std::unordered_map<std::string, double> SignalProcessorDAG::get_accumulator_state() const {
+    std::unordered_map<std::string, double> totals;
+    for (const auto& [node, integrator] : integrators_) {
+        totals[node->signal_name] = integrator.total();
+    }
+    return totals;
+}
+
+void SignalProcessorDAG::restore_accumulator_state(const std::unordered_map<std::string, double>& totals) {
+    for (const auto& [signal_name, total] : totals) {
+        if (auto* node = dag_->get_node(signal_name)) {
+            integrators_[node].reset(total);
+        } else {
+            LOG(WARNING) << "Ignoring accumulator state for unknown signal: " << signal_name;
+        }
+    }
+}
+
+bool SignalProcessorDAG::save_accumulators(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG(ERROR) << "Failed to open accumulator file for writing: " << path;
+        return false;
+    }
+
+    file << std::setprecision(17);
+    for (const auto& [signal_name, total] : get_accumulator_state()) {
+        file << signal_name << " " << total << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool SignalProcessorDAG::load_accumulators(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        LOG(ERROR) << "Failed to open accumulator file: " << path;
+        return false;
+    }
+
+    std::unordered_map<std::string, double> totals;
+    std::string signal_name;
+    double total;
+    while (file >> signal_name >> total) {
+        totals[signal_name] = total;
+    }
+    if (!file.eof()) {
+        LOG(ERROR) << "Malformed accumulator file: " << path;
+        return false;
+    }
+
+    restore_accumulator_state(totals);
+    return true;
+}
+
+std::unordered_map<std::string, std::string> SignalProcessorDAG::get_sketch_state() const {
+    std::unordered_map<std::string, std::string> state;
+    for (const auto& [name, sketch] : sketches_) {
+        state[name] = sketch.serialize();
+    }
+    return state;
+}
+
+bool SignalProcessorDAG::restore_sketch_state(const std::unordered_map<std::string, std::string>& sketches) {
+    for (const auto& [name, text] : sketches) {
+        auto sketch = QuantileSketch::deserialize(text);
+        if (!sketch) {
+            LOG(ERROR) << "Malformed quantile sketch: " << name;
+            return false;
+        }
+        auto it = sketches_.find(name);
+        if (it == sketches_.end()) {
+            sketches_.emplace(name, std::move(*sketch));
+        } else if (!it->second.merge(*sketch)) {
+            LOG(ERROR) << "Cannot merge quantile sketch " << name << " with a different accuracy";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SignalProcessorDAG::save_sketches(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG(ERROR) << "Failed to open sketch file for writing: " << path;
+        return false;
+    }
+
+    BinaryWriter out;
+    for (char c : kSketchFileMagic) {
+        out.put<char>(c);
+    }
+    auto state = get_sketch_state();
+    out.put<uint32_t>(static_cast<uint32_t>(state.size()));
+    for (const auto& [name, text] : state) {
+        out.put(name);
+        out.put(text);
+    }
+    file.write(out.data().data(), static_cast<std::streamsize>(out.data().size()));
+    return static_cast<bool>(file);
+}
+
+bool SignalProcessorDAG::load_sketches(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG(ERROR) << "Failed to open sketch file: " << path;
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    BinaryReader in(data.data(), data.size());
+    char magic[sizeof(kSketchFileMagic)];
+    for (char& c : magic) {
+        c = in.get<char>();
+    }
+    std::unordered_map<std::string, std::string> sketches;
+    bool ok = std::memcmp(magic, kSketchFileMagic, sizeof(magic)) == 0;
+    for (size_t i = 0, n = ok ? in.get_count() : 0; i < n && in.ok(); ++i) {
+        std::string name = in.get_string();
+        sketches[name] = in.get_string();
+    }
+    if (!ok || !in.ok() || in.remaining() != 0) {
+        LOG(ERROR) << "Malformed sketch file: " << path;
+        return false;
+    }
+    return restore_sketch_state(sketches);
+}
+
+int SignalProcessorDAG::lua_sketch_add(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    std::string name = luaL_checkstring(L, 1);
+    double accuracy = luaL_optnumber(L, 3, QuantileSketch::kDefaultRelativeAccuracy);
+    if (!(accuracy > 0.0 && accuracy < 1.0)) {
+        return luaL_error(L, "sketch_add(): accuracy must be in (0, 1)");
+    }
+
+    auto it = self->sketches_.find(name);
+    if (it == self->sketches_.end()) {
+        it = self->sketches_.emplace(name, QuantileSketch(accuracy)).first;
+    }
+
+    // Invalid inputs are skipped
+    if (lua_type(L, 2) == LUA_TNUMBER) {
+        it->second.add(lua_tonumber(L, 2));
+    }
+    lua_pushinteger(L, static_cast<lua_Integer>(it->second.count()));
+    return 1;
+}
+
+int SignalProcessorDAG::lua_sketch_quantile(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    std::string name = luaL_checkstring(L, 1);
+    double q = luaL_checknumber(L, 2);
+
+    auto it = self->sketches_.find(name);
+    std::optional<double> value;
+    if (it != self->sketches_.end()) {
+        value = it->second.quantile(q);
+    }
+    if (value) {
+        lua_pushnumber(L, *value);
+    } else {
+        lua_pushnil(L);
+    }
+    return 1;
+}
+
+int SignalProcessorDAG::lua_sketch_reset(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    auto it = self->sketches_.find(luaL_checkstring(L, 1));
+    if (it != self->sketches_.end()) {
+        it->second.clear();
+    }
+    return 0;
+}
+
+int SignalProcessorDAG::lua_lookup(lua_State* L) {
+    auto* self = static_cast<SignalProcessorDAG*>(lua_touserdata(L, lua_upvalueindex(1)));
+    size_t name_len = 0;
+    const char* name = luaL_checklstring(L, 1, &name_len);
+
+    if (!self->current_node_) {
+        return luaL_error(L, "lookup() called outside signal context");
+    }
+
+    const LookupTable* table = nullptr;
+    auto it = self->lookup_tables_.find(self->current_node_);
+    if (it != self->lookup_tables_.end()) {
+        for (const auto& [table_name, candidate] : it->second) {
+            if (table_name.size() == name_len && table_name.compare(0, name_len, name) == 0) {
+                table = &candidate;
+                break;
+            }
+        }
+    }
+    if (!table) {
+        return luaL_error(L, "lookup table '%s' not declared for %s",
+                          name, self->current_node_->signal_name.c_str());
+    }
+
+    // Invalid inputs propagate as nil
+    if (lua_isnoneornil(L, 2) || (table->is_2d() && lua_isnoneornil(L, 3))) {
+        lua_pushnil(L);
+        return 1;
+    }
+
+    double x = luaL_checknumber(L, 2);
+    if (table->is_2d()) {
+        lua_pushnumber(L, table->evaluate(x, luaL_checknumber(L, 3)));
+    } else {
+        lua_pushnumber(L, table->evaluate(x));
+    }
+    return 1;
+}
+
 std::vector<std::string> SignalProcessorDAG::get_required_input_signals() const {
     std::vector<std::string> signals;
     
@@ -767,29 +2103,71 @@ std::vector<std::string> SignalProcessorDAG::get_required_input_signals() const
     return signals;
 }
 
+MemoryFootprint SignalProcessorDAG::memory_footprint() const {
+    MemoryFootprint footprint;
+    if (const auto& mappings = dag_->get_mappings()) {
+        footprint.mappings = estimate_mapping_bytes(*mappings);
+    }
+    footprint.dag = dag_->memory_bytes();
+
+    lua_State* L = lua_mapper_->get_lua_state();
+    footprint.lua = static_cast<size_t>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 +
+                    static_cast<size_t>(lua_gc(L, LUA_GCCOUNTB, 0));
+
+    // Hash nodes: element plus next pointer; buckets: one pointer each
+    auto hashed = [](const auto& map) {
+        using Entry = typename std::decay_t<decltype(map)>::value_type;
+        return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(Entry) + sizeof(void*));
+    };
+    size_t runtime = hashed(signal_values_) + hashed(histories_) + hashed(lookup_tables_) +
+                     hashed(integrators_) + hashed(hysteresis_) + hashed(fusion_states_) +
+                     hashed(joins_) + hashed(sketches_);
+    for (const auto& [node, history] : histories_) {
+        runtime += history.capacity() * sizeof(SignalHistory::Sample);
+    }
+    for (const auto& [node, tables] : lookup_tables_) {
+        runtime += tables.capacity() * sizeof(tables[0]);
+    }
+    footprint.runtime = runtime;
+    return footprint;
+}
+
 std::vector<VSSSignal> SignalProcessorDAG::process_signal_updates(
     const std::vector<vssdag::SignalUpdate>& updates) {
-    
     std::vector<VSSSignal> vss_signals;
+    process_signal_updates(updates, vss_signals);
+    return vss_signals;
+}
+
+void SignalProcessorDAG::process_signal_updates(const std::vector<vssdag::SignalUpdate>& updates,
+                                                std::vector<VSSSignal>& vss_signals) {
+    batch_instructions_used_ = 0;
     
+    // Simulated clocks advance to the newest input timestamp
+    for (const auto& update : updates) {
+        clock_->observe_input_time(update.timestamp);
+    }
+
     // Update signal values and mark nodes as updated
     for (const auto& update : updates) {
         if (auto* node = dag_->get_node(update.signal_name)) {
             if (node->is_input_signal) {
                 // Store the qualified value (value + quality + timestamp)
-                signal_values_[update.signal_name].value = update.value;
-                signal_values_[update.signal_name].quality = update.status;
+                auto& stored = signal_values_[node->symbol];
+                stored.value = update.value;
+                stored.quality = update.status;
                 // Convert steady_clock to system_clock timestamp
-                auto steady_now = std::chrono::steady_clock::now();
-                auto system_now = std::chrono::system_clock::now();
+                auto steady_now = clock_->now();
+                auto system_now = clock_->wall_time();
                 auto elapsed = steady_now - update.timestamp;
-                signal_values_[update.signal_name].timestamp = system_now - elapsed;
+                stored.timestamp = system_now - elapsed;
 
-                // Log the update
-                if (update.status == vss::types::SignalQuality::VALID) {
-                    // Log with type info
-                    std::string value_str = VSSTypeHelper::to_string(update.value);
-                    VLOG(2) << "Updating input signal " << update.signal_name << " = " << value_str;
+                // Log the update (formatting the value allocates)
+                if (!VLOG_IS_ON(2)) {
+                    // Nothing to log
+                } else if (update.status == vss::types::SignalQuality::VALID) {
+                    VLOG(2) << "Updating input signal " << update.signal_name << " = "
+                            << VSSTypeHelper::to_string(update.value);
                 } else {
                     // Log invalid/not available status
                     VLOG(2) << "Updating input signal " << update.signal_name
@@ -799,7 +2177,7 @@ std::vector<VSSSignal> SignalProcessorDAG::process_signal_updates(
                 node->last_update = update.timestamp;
                 
                 // Mark this node and its dependents as having new data
-                dag_->mark_can_signal_updated(update.signal_name);
+                dag_->mark_node_updated(node);
             }
         } else {
             VLOG(3) << "Ignoring unknown signal: " << update.signal_name;
@@ -807,8 +2185,18 @@ std::vector<VSSSignal> SignalProcessorDAG::process_signal_updates(
     }
     
     // Process nodes (similar to process_can_signals but simplified)
-    auto now = std::chrono::steady_clock::now();
-    std::vector<SignalNode*> nodes_to_process;
+    auto now = clock_->now();
+    auto& nodes_to_process = nodes_to_process_;
+    nodes_to_process.clear();
+
+    // Wake nodes whose scheduled time has come (delayed(), schedule_at())
+    due_nodes_.clear();
+    timer_queue_.pop_due(now, due_nodes_);
+    for (auto* node : due_nodes_) {
+        VLOG(2) << "Timer wakeup for " << node->signal_name;
+        node->timer_wakeup_only = !node->has_new_data;
+        dag_->mark_node_updated(node);
+    }
     
     for (auto* node : dag_->get_processing_order()) {
         bool needs_processing = false;
@@ -823,7 +2211,7 @@ std::vector<VSSSignal> SignalProcessorDAG::process_signal_updates(
             
             if (node->mapping.interval_ms > 0) {
                 bool deps_available = true;
-                for (const auto& dep : node->depends_on) {
+                for (Symbol dep : node->dependency_symbols) {
                     if (signal_values_.find(dep) == signal_values_.end()) {
                         deps_available = false;
                         break;
@@ -851,23 +2239,86 @@ std::vector<VSSSignal> SignalProcessorDAG::process_signal_updates(
             nodes_to_process.push_back(node);
             for (auto* dependent : node->dependents) {
                 dependent->has_new_data = true;
+                dependent->timer_wakeup_only = false;
             }
         }
     }
     
-    // Process nodes
-    for (auto* node : dag_->get_processing_order()) {
-        if (std::find(nodes_to_process.begin(), nodes_to_process.end(), node) != nodes_to_process.end() ||
-            node->has_new_data) {
+    // Process nodes, highest priority class first. Once the batch deadline
+    // has passed, lower classes are left pending for the next call. The
+    // deadline is checked on entering each class, whether or not its first
+    // node has work.
+    deferred_work_ = false;
+    const auto& order = dag_->get_priority_order();
+    Priority current_class = order.empty() ? Priority::CRITICAL : order.front()->priority;
+    for (size_t i = 0; i < order.size(); ++i) {
+        auto* node = order[i];
+        bool class_boundary = node->priority < current_class;
+        current_class = node->priority;
+
+        if (class_boundary && batch_deadline_ && clock_->now() - now >= *batch_deadline_) {
+            for (size_t j = i; j < order.size(); ++j) {
+                if (order[j]->has_new_data || order[j]->needs_periodic_update) {
+                    ++metrics_.deferred_nodes;
+                    deferred_work_ = true;
+                }
+            }
+            VLOG(2) << "Batch deadline passed, deferring priority classes below "
+                    << static_cast<int>(order[i - 1]->priority);
+            break;
+        }
+
+        bool pending = node->has_new_data ||
+            std::find(nodes_to_process.begin(), nodes_to_process.end(), node) != nodes_to_process.end();
+        if (pending) {
+
+            // Aligned joins evaluate once per complete sample set
+            if (node->mapping.join_policy != JoinPolicy::LATEST) {
+                auto join_it = joins_.find(node);
+                if (join_it != joins_.end()) {
+                    if (!join_it->second.align()) {
+                        node->has_new_data = false;
+                        node->needs_periodic_update = false;
+                        node->timer_wakeup_only = false;
+                        continue;
+                    }
+                    node->last_update = join_it->second.aligned_time();
+                }
+            }
             
+            bool woken_only = node->timer_wakeup_only && !node->needs_periodic_update;
+            node->timer_wakeup_only = false;
+
+            // Histories, joins and resamplers see the published value,
+            // for input signals too (not the raw decoded one)
             auto result = process_node(node);
+            if (result.has_value()) {
+                record_sample(node, result->qualified_value.value, result->qualified_value.quality);
+            }
+
+            // Derived signals inherit the newest input time of their dependencies
+            for (auto* dependent : node->dependents) {
+                dependent->last_update = std::max(dependent->last_update, node->last_update);
+            }
             
             if (node->needs_periodic_update) {
                 node->last_process = now;
                 node->needs_periodic_update = false;
             }
             
-            if (result.has_value()) {
+            if (result.has_value() && woken_only) {
+                // A timer wakeup with nothing new upstream (delayed(),
+                // sustained_condition()) publishes only a changed value or status
+                const auto& qualified = result->qualified_value;
+                if (node->last_output == std::chrono::steady_clock::time_point::min() ||
+                    qualified.quality != node->last_output_quality ||
+                    !node->codec.equal(node->last_output_value, qualified.value)) {
+                    node->last_output_value = qualified.value;
+                    node->last_output_quality = qualified.quality;
+                    vss_signals.push_back(std::move(*result));
+                    node->last_output = now;
+                }
+            } else if (result.has_value()) {
                 bool should_output = false;
                 
                 if (node->last_output == std::chrono::steady_clock::time_point::min()) {
@@ -886,69 +2337,20 @@ std::vector<VSSSignal> SignalProcessorDAG::process_signal_updates(
                 }
                 
                 if (should_output) {
-                    vss_signals.push_back(result.value());
+                    node->last_output_value = result->qualified_value.value;
+                    node->last_output_quality = result->qualified_value.quality;
+                    vss_signals.push_back(std::move(*result));
                     node->last_output = now;
-                    node->last_output_value = VSSTypeHelper::to_string(result.value().qualified_value.value);
                 }
             }
             node->has_new_data = false;
         }
     }
 
-    // PHASE 2: Check for signals with pending time-based operations (like delayed())
-    lua_State* L = lua_mapper_->get_lua_state();
-    lua_getglobal(L, "signals_pending_reevaluation");
-    if (lua_istable(L, -1)) {
-        // Iterate through pending signals
-        lua_pushnil(L);  // First key
-        while (lua_next(L, -2) != 0) {
-            // key is at index -2, value at index -1
-            if (lua_isstring(L, -2)) {
-                std::string signal_name = lua_tostring(L, -2);
-                VLOG(2) << "Phase 2: Found pending signal: " << signal_name;
-
-                // Find the node and re-evaluate it
-                auto* node = dag_->get_node(signal_name);
-                if (node && !node->is_input_signal) {
-                    VLOG(2) << "Phase 2: Re-evaluating pending signal: " << signal_name;
-                    auto result = process_node(node);
-
-                    if (result.has_value()) {
-                        // For phase 2 (deferred evaluation), only output if:
-                        // 1. Signal becomes valid (delay elapsed)
-                        // 2. Value changed
-                        bool should_output = false;
-
-                        if (result.value().qualified_value.is_valid()) {
-                            // Signal is now valid - check if it changed
-                            if (node->last_output == std::chrono::steady_clock::time_point::min()) {
-                                // First valid output
-                                should_output = true;
-                                VLOG(1) << "Phase 2: First valid output for " << signal_name;
-                            } else {
-                                std::string new_value_str = VSSTypeHelper::to_string(result.value().qualified_value.value);
-                                if (node->last_output_value != new_value_str) {
-                                    should_output = true;
-                                    VLOG(1) << "Phase 2: Value changed for " << signal_name;
-                                }
-                            }
-
-                            if (should_output) {
-                                vss_signals.push_back(result.value());
-                                node->last_output = now;
-                                node->last_output_value = VSSTypeHelper::to_string(result.value().qualified_value.value);
-                                VLOG(1) << "Phase 2: Publishing output for " << signal_name;
-                            }
-                        }
-                    }
-                }
-            }
-            lua_pop(L, 1);  // Remove value, keep key for next iteration
-        }
+    // Emit resampled rows whose grid ticks are due
+    for (auto& resampler : resamplers_) {
+        resampler->advance(now, resample_handler_);
     }
-    lua_pop(L, 1);  // Pop the table
-
-    return vss_signals;
 }
 
 } // namespace vssdag
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "vssdag/symbol.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace vssdag {
+
+// The deque keeps entry addresses, and so the index keys viewing their
+// names, stable while the table grows
+struct Symbol::Table {
+    Table() {
+        entries.push_back(Entry{std::string(), 0});
+        empty = &entries.back();
+        index.emplace(empty->name, empty);
+    }
+
+    std::mutex mutex;
+    std::deque<Entry> entries;
+    std::unordered_map<std::string_view, const Entry*> index;
+    const Entry* empty;  // ID 0, read without the lock
+};
+
+Symbol::Table& Symbol::table() {
+    static auto* table = new Table();  // Never destroyed, symbols stay valid in static destructors
+    return *table;
+}
+
+const Symbol::Entry* Symbol::intern(std::string_view name, bool insert) {
+    Table& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    auto it = t.index.find(name);
+    if (it != t.index.end()) {
+        return it->second;
+    }
+    if (!insert) {
+        return nullptr;
+    }
+    t.entries.push_back(Entry{std::string(name), static_cast<SymbolId>(t.entries.size())});
+    const Entry* entry = &t.entries.back();
+    t.index.emplace(entry->name, entry);
+    return entry;
+}
+
+Symbol::Symbol() : entry_(table().empty) {}
+
+Symbol::Symbol(std::string_view name) : entry_(intern(name, true)) {}
+
+std::optional<Symbol> Symbol::find(std::string_view name) {
+    const Entry* entry = intern(name, false);
+    return entry ? std::optional<Symbol>(Symbol(entry)) : std::nullopt;
+}
+
+size_t Symbol::count() {
+    Table& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    return t.entries.size();
+}
+
+size_t Symbol::memory_bytes() {
+    Table& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    size_t bytes = t.entries.size() * sizeof(Entry) + t.index.bucket_count() * sizeof(void*) +
+                   t.index.size() * (sizeof(std::pair<const std::string_view, const Entry*>) + sizeof(void*));
+    for (const auto& entry : t.entries) {
+        if (entry.name.capacity() > std::string().capacity()) {
+            bytes += entry.name.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+} // namespace vssdag
@@ -0,0 +1,81 @@
+#include "vssdag/timer_queue.h"
+#include <algorithm>
+#include <functional>
+
+namespace vssdag {
+
+void TimerQueue::schedule(SignalNode* node, time_point due) {
+    if (node->next_wakeup <= due) {
+        return;  // An earlier (or identical) wakeup is already pending
+    }
+    node->next_wakeup = due;
+    if (node->queued_wakeup == due) {
+        return;  // Re-armed to the time of its entry still in the heap
+    }
+    if (node->queued_wakeup == time_point::max()) {
+        ++queued_;
+    }
+    node->queued_wakeup = due;
+    push(Entry{due, node});
+    if (heap_.size() > 2 * queued_ + 16) {
+        compact();
+    }
+}
+
+void TimerQueue::cancel(SignalNode* node) {
+    if (node->next_wakeup == time_point::max()) {
+        return;
+    }
+    node->next_wakeup = time_point::max();
+    prune();
+}
+
+void TimerQueue::pop_due(time_point now, std::vector<SignalNode*>& out) {
+    while (!heap_.empty() && heap_.front().due <= now) {
+        Entry entry = heap_.front();
+        pop();
+        if (entry.node->next_wakeup == entry.due) {
+            entry.node->next_wakeup = time_point::max();
+            out.push_back(entry.node);
+        }
+    }
+    prune();
+}
+
+std::optional<TimerQueue::time_point> TimerQueue::next_deadline() const {
+    if (heap_.empty()) {
+        return std::nullopt;
+    }
+    return heap_.front().due;
+}
+
+void TimerQueue::push(Entry entry) {
+    heap_.push_back(entry);
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+}
+
+void TimerQueue::pop() {
+    std::pop_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+    Entry entry = heap_.back();
+    heap_.pop_back();
+    if (entry.node->queued_wakeup == entry.due) {
+        entry.node->queued_wakeup = time_point::max();
+        --queued_;
+    }
+}
+
+void TimerQueue::prune() {
+    while (!heap_.empty() && heap_.front().node->next_wakeup != heap_.front().due) {
+        pop();
+    }
+}
+
+void TimerQueue::compact() {
+    heap_.erase(std::remove_if(heap_.begin(), heap_.end(),
+                               [](const Entry& entry) { return entry.node->queued_wakeup != entry.due; }),
+                heap_.end());
+    std::make_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+    prune();
+}
+
+} // namespace vssdag
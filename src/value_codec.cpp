@@ -0,0 +1,467 @@
+#include "vssdag/value_codec.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <string_view>
+#include <utility>
+#include <lua.hpp>
+
+namespace vssdag {
+
+namespace {
+
+using StructPtr = std::shared_ptr<StructValue>;
+
+template <typename T>
+struct VectorTraits : std::false_type {};
+
+template <typename E>
+struct VectorTraits<std::vector<E>> : std::true_type {
+    using element = E;
+};
+
+// ValueType whose alternative is T
+template <typename T>
+constexpr ValueType value_type_of() {
+    if constexpr (std::is_same_v<T, std::monostate>) return ValueType::UNSPECIFIED;
+    else if constexpr (std::is_same_v<T, std::string>) return ValueType::STRING;
+    else if constexpr (std::is_same_v<T, bool>) return ValueType::BOOL;
+    else if constexpr (std::is_same_v<T, int8_t>) return ValueType::INT8;
+    else if constexpr (std::is_same_v<T, int16_t>) return ValueType::INT16;
+    else if constexpr (std::is_same_v<T, int32_t>) return ValueType::INT32;
+    else if constexpr (std::is_same_v<T, int64_t>) return ValueType::INT64;
+    else if constexpr (std::is_same_v<T, uint8_t>) return ValueType::UINT8;
+    else if constexpr (std::is_same_v<T, uint16_t>) return ValueType::UINT16;
+    else if constexpr (std::is_same_v<T, uint32_t>) return ValueType::UINT32;
+    else if constexpr (std::is_same_v<T, uint64_t>) return ValueType::UINT64;
+    else if constexpr (std::is_same_v<T, float>) return ValueType::FLOAT;
+    else if constexpr (std::is_same_v<T, double>) return ValueType::DOUBLE;
+    else if constexpr (std::is_same_v<T, std::vector<std::string>>) return ValueType::STRING_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<bool>>) return ValueType::BOOL_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<int8_t>>) return ValueType::INT8_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<int16_t>>) return ValueType::INT16_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<int32_t>>) return ValueType::INT32_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<int64_t>>) return ValueType::INT64_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) return ValueType::UINT8_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<uint16_t>>) return ValueType::UINT16_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<uint32_t>>) return ValueType::UINT32_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<uint64_t>>) return ValueType::UINT64_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<float>>) return ValueType::FLOAT_ARRAY;
+    else if constexpr (std::is_same_v<T, std::vector<double>>) return ValueType::DOUBLE_ARRAY;
+    else if constexpr (std::is_same_v<T, StructPtr>) return ValueType::STRUCT;
+    else {
+        static_assert(std::is_same_v<T, std::vector<StructPtr>>, "Value alternative without a ValueType");
+        return ValueType::STRUCT_ARRAY;
+    }
+}
+
+// ---- Lua ----
+
+// Lua number at index as T. Integer types go through lua_tointeger, which
+// yields 0 for numbers without an integer representation.
+template <typename T>
+T number_as(lua_State* L, int index) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return lua_tointeger(L, index) != 0;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(lua_tonumber(L, index));
+    } else {
+        return static_cast<T>(lua_tointeger(L, index));
+    }
+}
+
+// Array element at index; elements of another Lua type read as E{}
+template <typename E>
+E element_as(lua_State* L, int index) {
+    int type = lua_type(L, index);
+    if constexpr (std::is_same_v<E, std::string>) {
+        if (type != LUA_TSTRING && type != LUA_TNUMBER) {
+            return {};
+        }
+        size_t len = 0;
+        const char* text = lua_tolstring(L, index, &len);
+        return std::string(text, len);
+    } else if constexpr (std::is_same_v<E, bool>) {
+        return type == LUA_TNUMBER ? number_as<bool>(L, index) : static_cast<bool>(lua_toboolean(L, index));
+    } else {
+        return type == LUA_TNUMBER ? number_as<E>(L, index) : E{};
+    }
+}
+
+template <typename T>
+Value table_as(lua_State* L, int index) {
+    if constexpr (std::is_same_v<T, StructPtr>) {
+        return VSSTypeHelper::from_lua_table_typed(L, index, ValueType::STRUCT);
+    } else if constexpr (std::is_same_v<T, std::vector<StructPtr>>) {
+        return VSSTypeHelper::from_lua_table_typed(L, index, ValueType::STRUCT_ARRAY);
+    } else if constexpr (VectorTraits<T>::value) {
+        using E = typename VectorTraits<T>::element;
+        index = lua_absindex(L, index);
+        size_t len = lua_rawlen(L, index);
+        T items;
+        items.reserve(len);
+        for (size_t i = 1; i <= len; ++i) {
+            lua_rawgeti(L, index, static_cast<lua_Integer>(i));
+            items.push_back(element_as<E>(L, -1));
+            lua_pop(L, 1);
+        }
+        return items;
+    } else {
+        return std::monostate{};
+    }
+}
+
+template <typename T>
+Value pull_lua(lua_State* L, int index) {
+    switch (lua_type(L, index)) {
+        case LUA_TNUMBER:
+            if constexpr (std::is_arithmetic_v<T>) {
+                return number_as<T>(L, index);
+            } else {
+                return lua_tonumber(L, index);
+            }
+        case LUA_TBOOLEAN:
+            return static_cast<bool>(lua_toboolean(L, index));
+        case LUA_TSTRING: {
+            size_t len = 0;
+            const char* text = lua_tolstring(L, index, &len);
+            return std::string(text, len);
+        }
+        case LUA_TTABLE:
+            return table_as<T>(L, index);
+        default:
+            return std::monostate{};
+    }
+}
+
+template <typename T>
+void push_item(lua_State* L, const T& item) {
+    if constexpr (std::is_same_v<T, std::monostate>) {
+        lua_pushnil(L);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        lua_pushboolean(L, item);
+    } else if constexpr (std::is_integral_v<T>) {
+        lua_pushinteger(L, static_cast<lua_Integer>(item));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        lua_pushnumber(L, static_cast<lua_Number>(item));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        lua_pushlstring(L, item.data(), item.size());
+    } else if constexpr (std::is_same_v<T, StructPtr>) {
+        if (!item) {
+            lua_pushnil(L);
+            return;
+        }
+        lua_createtable(L, 0, static_cast<int>(item->fields().size()));
+        for (const auto& [key, field] : item->fields()) {
+            lua_pushlstring(L, key.data(), key.size());
+            value_codec_of(field).push_lua(L, field);
+            lua_rawset(L, -3);
+        }
+    } else {
+        // Arrays become 1-indexed sequences
+        lua_createtable(L, static_cast<int>(item.size()), 0);
+        for (size_t i = 0; i < item.size(); ++i) {
+            if constexpr (std::is_same_v<T, std::vector<bool>>) {
+                lua_pushboolean(L, item[i]);
+            } else {
+                push_item(L, item[i]);
+            }
+            lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+        }
+    }
+}
+
+template <typename T>
+void push_lua(lua_State* L, const Value& value) {
+    if (const T* item = std::get_if<T>(&value)) {
+        push_item(L, *item);
+    } else {
+        value_codec_of(value).push_lua(L, value);
+    }
+}
+
+// ---- JSON ----
+
+// Near-zero as 0, otherwise six decimals; trim drops trailing zeros
+void append_number(std::string& out, double value, bool trim) {
+    if (std::abs(value) < 1e-6) {
+        out += '0';
+        return;
+    }
+    char buffer[512];
+    int written = std::snprintf(buffer, sizeof(buffer), "%.6f", value);
+    std::string_view text(buffer, std::min<size_t>(std::max(written, 0), sizeof(buffer) - 1));
+    if (trim && text.find('.') != std::string_view::npos) {
+        text = text.substr(0, text.find_last_not_of('0') + 1);
+        if (text.back() == '.') {
+            text.remove_suffix(1);
+        }
+    }
+    out.append(text);
+}
+
+void append_json_string(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    out += escaped;
+                } else {
+                    out += c;  // UTF-8 passes through
+                }
+        }
+    }
+    out += '"';
+}
+
+template <typename T>
+void append_item(std::string& out, const T& item) {
+    if constexpr (std::is_same_v<T, std::monostate>) {
+        out += "null";
+    } else if constexpr (std::is_same_v<T, bool>) {
+        out += item ? "true" : "false";
+    } else if constexpr (std::is_integral_v<T>) {
+        out += std::to_string(item);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        append_number(out, item, true);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        append_json_string(out, item);
+    } else if constexpr (std::is_same_v<T, StructPtr>) {
+        if (!item) {
+            out += "null";
+            return;
+        }
+        out += '{';
+        bool first = true;
+        for (const auto& [key, field] : item->fields()) {
+            if (!first) out += ',';
+            append_json_string(out, key);
+            out += ':';
+            value_codec_of(field).append_json(out, field);
+            first = false;
+        }
+        out += '}';
+    } else {
+        out += '[';
+        for (size_t i = 0; i < item.size(); ++i) {
+            if (i > 0) out += ',';
+            if constexpr (std::is_same_v<T, std::vector<bool>>) {
+                out += item[i] ? "true" : "false";
+            } else if constexpr (std::is_floating_point_v<typename T::value_type>) {
+                append_number(out, item[i], false);  // Array elements keep their six decimals
+            } else {
+                append_item(out, item[i]);
+            }
+        }
+        out += ']';
+    }
+}
+
+template <typename T>
+void append_json(std::string& out, const Value& value) {
+    if (const T* item = std::get_if<T>(&value)) {
+        append_item(out, *item);
+    } else {
+        value_codec_of(value).append_json(out, value);
+    }
+}
+
+// ---- Binary ----
+
+template <typename T>
+void write_item(BinaryWriter& out, const T& item) {
+    if constexpr (std::is_same_v<T, std::monostate>) {
+        // No payload
+    } else if constexpr (std::is_same_v<T, bool>) {
+        out.put<uint8_t>(item ? 1 : 0);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        out.put<T>(item);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        out.put(item);
+    } else if constexpr (std::is_same_v<T, StructPtr>) {
+        out.put<uint8_t>(item ? 1 : 0);
+        if (!item) {
+            return;
+        }
+        out.put(item->type_name());
+        out.put<uint32_t>(static_cast<uint32_t>(item->fields().size()));
+        for (const auto& [key, field] : item->fields()) {
+            out.put(key);
+            write_value(out, field);
+        }
+    } else {
+        out.put<uint32_t>(static_cast<uint32_t>(item.size()));
+        for (size_t i = 0; i < item.size(); ++i) {
+            if constexpr (std::is_same_v<T, std::vector<bool>>) {
+                out.put<uint8_t>(item[i] ? 1 : 0);
+            } else {
+                write_item(out, item[i]);
+            }
+        }
+    }
+}
+
+template <typename T>
+T read_item(BinaryReader& in) {
+    if constexpr (std::is_same_v<T, std::monostate>) {
+        return {};
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return in.get<uint8_t>() != 0;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return in.get<T>();
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return in.get_string();
+    } else if constexpr (std::is_same_v<T, StructPtr>) {
+        if (in.get<uint8_t>() == 0) {
+            return nullptr;
+        }
+        auto item = std::make_shared<StructValue>(in.get_string());
+        size_t fields = in.get_count();
+        for (size_t i = 0; i < fields && in.ok(); ++i) {
+            std::string key = in.get_string();
+            item->set_field(key, read_value(in));
+        }
+        return item;
+    } else {
+        T items;
+        size_t count = in.get_count();
+        items.reserve(count);
+        for (size_t i = 0; i < count && in.ok(); ++i) {
+            items.push_back(read_item<typename T::value_type>(in));
+        }
+        return items;
+    }
+}
+
+template <typename T>
+void write_binary(BinaryWriter& out, const Value& value) {
+    if (const T* item = std::get_if<T>(&value)) {
+        write_item(out, *item);
+    } else {
+        value_codec_of(value).write_binary(out, value);
+    }
+}
+
+template <typename T>
+Value read_binary(BinaryReader& in) {
+    return read_item<T>(in);
+}
+
+// ---- Equality ----
+
+template <typename T>
+bool same_item(const T& a, const T& b) {
+    if constexpr (std::is_same_v<T, StructPtr>) {
+        if (!a || !b) {
+            return a == b;
+        }
+        if (a->type_name() != b->type_name() || a->fields().size() != b->fields().size()) {
+            return false;
+        }
+        return std::equal(a->fields().begin(), a->fields().end(), b->fields().begin(),
+                          [](const auto& x, const auto& y) {
+                              return x.first == y.first && values_equal(x.second, y.second);
+                          });
+    } else if constexpr (std::is_same_v<T, std::vector<StructPtr>>) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), &same_item<StructPtr>);
+    } else {
+        return a == b;
+    }
+}
+
+template <typename T>
+bool equal(const Value& a, const Value& b) {
+    const T* x = std::get_if<T>(&a);
+    if (!x) {
+        return value_codec_of(a).equal(a, b);
+    }
+    const T* y = std::get_if<T>(&b);
+    return y && same_item(*x, *y);
+}
+
+// ---- Tables ----
+
+template <typename T>
+constexpr ValueCodec make_codec() {
+    return {value_type_of<T>(), &pull_lua<T>, &push_lua<T>, &append_json<T>,
+            &write_binary<T>, &read_binary<T>, &equal<T>};
+}
+
+template <typename T>
+constexpr ValueCodec kCodec = make_codec<T>();
+
+// A variant left empty by a throwing assignment: nil, null, no payload,
+// equal to nothing. Keeps the fallbacks above from recursing.
+const ValueCodec kValuelessCodec = {
+    ValueType::UNSPECIFIED,
+    &pull_lua<std::monostate>,
+    [](lua_State* L, const Value&) { lua_pushnil(L); },
+    [](std::string& out, const Value&) { out += "null"; },
+    [](BinaryWriter&, const Value&) {},
+    &read_binary<std::monostate>,
+    [](const Value&, const Value&) { return false; },
+};
+
+template <size_t... I>
+constexpr std::array<const ValueCodec*, sizeof...(I)> codecs_by_index(std::index_sequence<I...>) {
+    return {&kCodec<std::variant_alternative_t<I, Value>>...};
+}
+
+constexpr auto kCodecsByIndex = codecs_by_index(std::make_index_sequence<std::variant_size_v<Value>>());
+
+} // namespace
+
+const ValueCodec& value_codec(ValueType type) {
+    for (const ValueCodec* codec : kCodecsByIndex) {
+        if (codec->type == type) {
+            return *codec;
+        }
+    }
+    return kCodec<std::monostate>;
+}
+
+const ValueCodec& value_codec_of(const Value& value) {
+    if (value.valueless_by_exception()) {
+        return kValuelessCodec;
+    }
+    return *kCodecsByIndex[value.index()];
+}
+
+std::string value_to_json(const Value& value) {
+    std::string out;
+    value_codec_of(value).append_json(out, value);
+    return out;
+}
+
+void write_value(BinaryWriter& out, const Value& value) {
+    const ValueCodec& codec = value_codec_of(value);
+    out.put<uint8_t>(static_cast<uint8_t>(codec.type));
+    codec.write_binary(out, value);
+}
+
+Value read_value(BinaryReader& in) {
+    auto type = static_cast<ValueType>(in.get<uint8_t>());
+    const ValueCodec& codec = value_codec(type);
+    if (codec.type != type) {
+        in.fail();  // Unknown tag, the payload cannot be skipped
+        return std::monostate{};
+    }
+    return codec.read_binary(in);
+}
+
+bool values_equal(const Value& a, const Value& b) {
+    return value_codec_of(a).equal(a, b);
+}
+
+} // namespace vssdag
@@ -0,0 +1,326 @@
+#include "vssdag/vss_catalogue.h"
+#include <glog/logging.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <unordered_set>
+#include "vssdag/binary_io.h"
+
+namespace vssdag {
+
+namespace {
+
+constexpr char kCatalogueMagic[8] = {'V', 'S', 'S', 'C', 'A', 'T', 'L', '1'};
+constexpr uint32_t kCatalogueVersion = 1;
+
+bool parse_node_type(const std::string& text, VSSNodeType& type) {
+    if (text == "branch") {
+        type = VSSNodeType::BRANCH;
+    } else if (text == "sensor") {
+        type = VSSNodeType::SENSOR;
+    } else if (text == "actuator") {
+        type = VSSNodeType::ACTUATOR;
+    } else if (text == "attribute") {
+        type = VSSNodeType::ATTRIBUTE;
+    } else if (text == "struct") {
+        type = VSSNodeType::STRUCT;
+    } else if (text == "property") {
+        type = VSSNodeType::PROPERTY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool path_less(const VSSNode& a, const VSSNode& b) {
+    return a.path < b.path;
+}
+
+// Collect every node of a YAML map. Keys may be full dotted paths (flattened
+// export) or names relative to prefix (nested "children" layout).
+bool parse_entries(const YAML::Node& entries, const std::string& prefix,
+                   std::vector<VSSNode>& nodes) {
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        const YAML::Node& entry = it->second;
+        if (!entry.IsMap() || !entry["type"]) {
+            continue;  // Not a node definition
+        }
+        VSSNode node;
+        node.path = prefix.empty() ? it->first.as<std::string>()
+                                   : prefix + "." + it->first.as<std::string>();
+        std::string type = entry["type"].as<std::string>();
+        if (!parse_node_type(type, node.type)) {
+            LOG(ERROR) << "Unknown VSS node type '" << type << "' for " << node.path;
+            return false;
+        }
+        node.datatype = entry["datatype"].as<std::string>("");
+        node.description = entry["description"].as<std::string>("");
+        node.unit = entry["unit"].as<std::string>("");
+        if (entry["min"]) node.min = entry["min"].as<double>();
+        if (entry["max"]) node.max = entry["max"].as<double>();
+
+        // Array defaults have no scalar representation and are ignored
+        if (const auto& def = entry["default"]; def && def.IsScalar()) {
+            if (node.datatype == "boolean") {
+                node.default_value = def.as<bool>();
+            } else if (node.datatype == "string") {
+                node.default_value = def.as<std::string>();
+            } else {
+                node.default_value = def.as<double>();
+            }
+        }
+
+        if (const auto& children = entry["children"]; children && children.IsMap()) {
+            if (!parse_entries(children, node.path, nodes)) {
+                return false;
+            }
+        }
+        nodes.push_back(std::move(node));
+    }
+    return true;
+}
+
+void write_optional(BinaryWriter& out, const std::optional<double>& value) {
+    out.put<uint8_t>(value ? 1 : 0);
+    out.put<double>(value.value_or(0.0));
+}
+
+std::optional<double> read_optional(BinaryReader& in) {
+    bool present = in.get<uint8_t>() != 0;
+    double value = in.get<double>();
+    return present ? std::optional<double>(value) : std::nullopt;
+}
+
+} // namespace
+
+bool VSSCatalogue::parse_yaml(const std::string& yaml) {
+    std::vector<VSSNode> nodes;
+    try {
+        YAML::Node root = YAML::Load(yaml);
+        if (root && !root.IsMap()) {
+            LOG(ERROR) << "VSS spec is not a map of nodes";
+            return false;
+        }
+        if (!parse_entries(root, "", nodes)) {
+            return false;
+        }
+    } catch (const std::exception& e) {
+        LOG(ERROR) << "Error parsing VSS spec: " << e.what();
+        return false;
+    }
+    return build_index(std::move(nodes));
+}
+
+bool VSSCatalogue::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        LOG(ERROR) << "Failed to open VSS spec file: " << path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string data = buffer.str();
+
+    if (data.size() >= sizeof(kCatalogueMagic) &&
+        std::memcmp(data.data(), kCatalogueMagic, sizeof(kCatalogueMagic)) == 0) {
+        if (!decode(data)) {
+            LOG(ERROR) << "VSS catalogue is corrupt or truncated: " << path;
+            return false;
+        }
+        return true;
+    }
+    return parse_yaml(data);
+}
+
+bool VSSCatalogue::save(const std::string& path) const {
+    BinaryWriter out;
+    for (char c : kCatalogueMagic) {
+        out.put<char>(c);
+    }
+    out.put<uint32_t>(kCatalogueVersion);
+    out.put<uint32_t>(static_cast<uint32_t>(nodes_.size()));
+    for (const auto& node : nodes_) {
+        out.put(node.path);
+        out.put<uint8_t>(static_cast<uint8_t>(node.type));
+        out.put<uint8_t>(node.implicit ? 1 : 0);
+        out.put(node.datatype);
+        out.put(node.description);
+        out.put(node.unit);
+        write_optional(out, node.min);
+        write_optional(out, node.max);
+
+        // 0 = no default, otherwise variant index + 1
+        out.put<uint8_t>(node.default_value ? node.default_value->index() + 1 : 0);
+        if (node.default_value) {
+            std::visit([&out](const auto& v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, bool>) {
+                    out.put<uint8_t>(v ? 1 : 0);
+                } else {
+                    out.put(v);
+                }
+            }, *node.default_value);
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG(ERROR) << "Failed to open VSS catalogue for writing: " << path;
+        return false;
+    }
+    file.write(out.data().data(), static_cast<std::streamsize>(out.data().size()));
+    return static_cast<bool>(file);
+}
+
+bool VSSCatalogue::is_catalogue_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(kCatalogueMagic)] = {};
+    return file.read(magic, sizeof(magic)) &&
+           std::memcmp(magic, kCatalogueMagic, sizeof(magic)) == 0;
+}
+
+bool VSSCatalogue::decode(const std::string& data) {
+    BinaryReader in(data.data() + sizeof(kCatalogueMagic), data.size() - sizeof(kCatalogueMagic));
+    if (uint32_t version = in.get<uint32_t>(); version != kCatalogueVersion) {
+        LOG(ERROR) << "Unsupported VSS catalogue version " << version;
+        return false;
+    }
+
+    std::vector<VSSNode> nodes;
+    for (size_t i = 0, n = in.get_count(); i < n && in.ok(); ++i) {
+        VSSNode node;
+        node.path = in.get_string();
+        uint8_t type = in.get<uint8_t>();
+        if (type > static_cast<uint8_t>(VSSNodeType::PROPERTY)) {
+            return false;
+        }
+        node.type = static_cast<VSSNodeType>(type);
+        node.implicit = in.get<uint8_t>() != 0;
+        node.datatype = in.get_string();
+        node.description = in.get_string();
+        node.unit = in.get_string();
+        node.min = read_optional(in);
+        node.max = read_optional(in);
+        switch (in.get<uint8_t>()) {
+            case 0:
+                break;
+            case 1:
+                node.default_value = in.get<double>();
+                break;
+            case 2:
+                node.default_value = in.get_string();
+                break;
+            case 3:
+                node.default_value = in.get<uint8_t>() != 0;
+                break;
+            default:
+                return false;
+        }
+        nodes.push_back(std::move(node));
+    }
+    return in.ok() && in.remaining() == 0 && build_index(std::move(nodes));
+}
+
+bool VSSCatalogue::build_index(std::vector<VSSNode> nodes) {
+    std::sort(nodes.begin(), nodes.end(), path_less);
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        if (nodes[i].path == nodes[i - 1].path) {
+            LOG(ERROR) << "Duplicate VSS node " << nodes[i].path;
+            return false;
+        }
+    }
+
+    // Ancestors the spec does not declare become implicit branches
+    std::vector<VSSNode> implicit;
+    std::unordered_set<std::string> added;
+    auto declared = [&nodes](const std::string& path) {
+        VSSNode probe;
+        probe.path = path;
+        return std::binary_search(nodes.begin(), nodes.end(), probe, path_less);
+    };
+    for (const auto& node : nodes) {
+        for (auto dot = node.path.rfind('.'); dot != std::string::npos && dot > 0;
+             dot = node.path.rfind('.', dot - 1)) {
+            std::string ancestor = node.path.substr(0, dot);
+            if (declared(ancestor) || !added.insert(ancestor).second) {
+                break;  // Its own ancestors are covered already
+            }
+            VSSNode branch;
+            branch.path = std::move(ancestor);
+            branch.implicit = true;
+            implicit.push_back(std::move(branch));
+        }
+    }
+    if (!implicit.empty()) {
+        std::sort(implicit.begin(), implicit.end(), path_less);
+        size_t declared_count = nodes.size();
+        std::move(implicit.begin(), implicit.end(), std::back_inserter(nodes));
+        std::inplace_merge(nodes.begin(), nodes.begin() + declared_count, nodes.end(), path_less);
+    }
+
+    nodes_ = std::move(nodes);
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        auto dot = nodes_[i].path.rfind('.');
+        if (dot == std::string::npos) {
+            continue;
+        }
+        const VSSNode* parent = find(std::string_view(nodes_[i].path).substr(0, dot));
+        if (parent) {
+            nodes_[i].parent = static_cast<int32_t>(parent - nodes_.data());
+            nodes_[nodes_[i].parent].children.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return true;
+}
+
+const VSSNode* VSSCatalogue::find(std::string_view path) const {
+    auto it = std::lower_bound(nodes_.begin(), nodes_.end(), path,
+                               [](const VSSNode& node, std::string_view p) { return node.path < p; });
+    return (it != nodes_.end() && it->path == path) ? &*it : nullptr;
+}
+
+std::pair<size_t, size_t> VSSCatalogue::descendants(std::string_view path) const {
+    // '/' sorts directly after '.', so "P." <= descendant < "P/"
+    std::string first = std::string(path) + ".";
+    std::string last = std::string(path) + "/";
+    auto less = [](const VSSNode& node, const std::string& p) { return node.path < p; };
+    auto begin = std::lower_bound(nodes_.begin(), nodes_.end(), first, less);
+    auto end = std::lower_bound(begin, nodes_.end(), last, less);
+    return {static_cast<size_t>(begin - nodes_.begin()), static_cast<size_t>(end - nodes_.begin())};
+}
+
+std::vector<StructType> VSSCatalogue::struct_types() const {
+    std::vector<StructType> types;
+    for (const auto& node : nodes_) {
+        if (node.type != VSSNodeType::STRUCT) {
+            continue;
+        }
+        StructType type;
+        type.type_path = node.path;
+        type.description = node.description;
+        for (uint32_t child : node.children) {
+            const VSSNode& prop_node = nodes_[child];
+            if (prop_node.type != VSSNodeType::PROPERTY) {
+                continue;
+            }
+            StructProperty prop;
+            prop.name = std::string(prop_node.name());
+            prop.datatype = prop_node.datatype;
+            prop.description = prop_node.description;
+            prop.unit = prop_node.unit;
+            prop.min = prop_node.min;
+            prop.max = prop_node.max;
+            prop.default_value = prop_node.default_value;
+            type.properties.push_back(std::move(prop));
+        }
+        if (!type.properties.empty()) {
+            types.push_back(std::move(type));
+        }
+    }
+    return types;
+}
+
+} // namespace vssdag
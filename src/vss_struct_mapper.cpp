@@ -8,8 +8,10 @@
 namespace vssdag {
 
 // StructBuffer Implementation
-StructBuffer::StructBuffer(const StructType& type, const StructSignalMapping& mapping)
-    : type_(type), mapping_(mapping), creation_time_(std::chrono::steady_clock::now()) {
+StructBuffer::StructBuffer(const StructType& type, const StructSignalMapping& mapping,
+                           std::shared_ptr<IClock> clock)
+    : type_(type), mapping_(mapping), clock_(clock ? std::move(clock) : default_clock()),
+      creation_time_(clock_->now()) {
     // Initialize field values map
     for (const auto& prop : type_.properties) {
         field_values_[prop.name] = FieldValue{};
@@ -25,7 +27,7 @@ bool StructBuffer::update_field(const std::string& property_name,
     }
     
     it->second.value = value;
-    it->second.timestamp = std::chrono::steady_clock::now();
+    it->second.timestamp = clock_->now();
     it->second.is_set = true;
     
     VLOG(2) << "Updated struct field " << property_name << " in " << mapping_.vss_path;
@@ -42,7 +44,7 @@ bool StructBuffer::is_complete() const {
 }
 
 bool StructBuffer::is_expired() const {
-    auto now = std::chrono::steady_clock::now();
+    auto now = clock_->now();
     auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - creation_time_).count();
     return age > mapping_.max_wait_ms;
 }
@@ -73,11 +75,11 @@ void StructBuffer::clear() {
     for (auto& [name, field] : field_values_) {
         field.is_set = false;
     }
-    creation_time_ = std::chrono::steady_clock::now();
+    creation_time_ = clock_->now();
 }
 
 int StructBuffer::get_age_ms() const {
-    auto now = std::chrono::steady_clock::now();
+    auto now = clock_->now();
     auto oldest_time = creation_time_;
     
     for (const auto& [name, field] : field_values_) {
@@ -96,93 +98,23 @@ VSSStructMapper::VSSStructMapper()
 
 VSSStructMapper::~VSSStructMapper() = default;
 
+void VSSStructMapper::set_clock(std::shared_ptr<IClock> clock) {
+    clock_ = clock ? std::move(clock) : default_clock();
+    lua_mapper_->set_clock(clock_);
+}
+
 bool VSSStructMapper::load_struct_types(const std::string& vss_spec_file) {
-    try {
-        std::ifstream file(vss_spec_file);
-        if (!file) {
-            LOG(ERROR) << "Failed to open VSS spec file: " << vss_spec_file;
-            return false;
-        }
-        
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return parse_vss_struct_types(buffer.str());
-    } catch (const std::exception& e) {
-        LOG(ERROR) << "Error loading struct types: " << e.what();
-        return false;
-    }
+    VSSCatalogue catalogue;
+    return catalogue.load(vss_spec_file) && load_struct_types(catalogue);
 }
 
-bool VSSStructMapper::parse_vss_struct_types(const std::string& vss_content) {
-    try {
-        YAML::Node root = YAML::Load(vss_content);
-        
-        // Iterate through all top-level nodes
-        for (auto it = root.begin(); it != root.end(); ++it) {
-            std::string node_name = it->first.as<std::string>();
-            YAML::Node node = it->second;
-            
-            // Check if this is a struct type definition (e.g., "Types.Location")
-            if (node_name.find("Types.") == 0 && node["type"] && 
-                node["type"].as<std::string>() == "struct") {
-                
-                StructType struct_type;
-                struct_type.type_path = node_name;
-                struct_type.description = node["description"].as<std::string>("");
-                
-                // Now look for properties of this struct (e.g., "Types.Location.Latitude")
-                std::string prefix = node_name + ".";
-                for (auto prop_it = root.begin(); prop_it != root.end(); ++prop_it) {
-                    std::string prop_full_name = prop_it->first.as<std::string>();
-                    
-                    // Check if this node is a property of our struct
-                    if (prop_full_name.find(prefix) == 0) {
-                        YAML::Node prop_node = prop_it->second;
-                        
-                        if (prop_node["type"] && prop_node["type"].as<std::string>() == "property") {
-                            StructProperty prop;
-                            // Extract property name (part after the last dot)
-                            size_t last_dot = prop_full_name.rfind('.');
-                            prop.name = (last_dot != std::string::npos) 
-                                ? prop_full_name.substr(last_dot + 1)
-                                : prop_full_name;
-                            
-                            prop.datatype = prop_node["datatype"].as<std::string>("");
-                            prop.description = prop_node["description"].as<std::string>("");
-                            prop.unit = prop_node["unit"].as<std::string>("");
-                            
-                            if (prop_node["min"]) prop.min = prop_node["min"].as<double>();
-                            if (prop_node["max"]) prop.max = prop_node["max"].as<double>();
-                            
-                            if (prop_node["default"]) {
-                                // Handle different default value types
-                                if (prop.datatype == "boolean") {
-                                    prop.default_value = prop_node["default"].as<bool>();
-                                } else if (prop.datatype == "string") {
-                                    prop.default_value = prop_node["default"].as<std::string>();
-                                } else {
-                                    prop.default_value = prop_node["default"].as<double>();
-                                }
-                            }
-                            
-                            struct_type.properties.push_back(prop);
-                        }
-                    }
-                }
-                
-                if (!struct_type.properties.empty()) {
-                    struct_types_[struct_type.type_path] = struct_type;
-                    LOG(INFO) << "Loaded struct type: " << struct_type.type_path 
-                             << " with " << struct_type.properties.size() << " properties";
-                }
-            }
-        }
-        
-        return true;
-    } catch (const std::exception& e) {
-        LOG(ERROR) << "Error parsing VSS struct types: " << e.what();
-        return false;
+bool VSSStructMapper::load_struct_types(const VSSCatalogue& catalogue) {
+    for (auto& struct_type : catalogue.struct_types()) {
+        LOG(INFO) << "Loaded struct type: " << struct_type.type_path
+                  << " with " << struct_type.properties.size() << " properties";
+        struct_types_[struct_type.type_path] = std::move(struct_type);
     }
+    return true;
 }
 
 bool VSSStructMapper::load_struct_mappings(const std::string& mapping_file) {
@@ -231,6 +163,10 @@ bool VSSStructMapper::load_struct_mappings(const std::string& mapping_file) {
                      it != signal_node["struct_mapping"].end(); ++it) {
                     StructPropertyMapping prop_mapping;
                     prop_mapping.property_path = it->first.as<std::string>();
+                    size_t last_dot = prop_mapping.property_path.rfind('.');
+                    prop_mapping.property_name = (last_dot != std::string::npos)
+                        ? prop_mapping.property_path.substr(last_dot + 1)
+                        : prop_mapping.property_path;
                     
                     YAML::Node prop_node = it->second;
                     prop_mapping.can_signal = prop_node["can_signal"].as<std::string>();
@@ -273,7 +209,7 @@ bool VSSStructMapper::load_struct_mappings(const std::string& mapping_file) {
             auto* struct_type = get_struct_type(mapping.struct_type);
             if (struct_type) {
                 struct_buffers_.push_back(
-                    std::make_unique<StructBuffer>(*struct_type, struct_mappings_.back()));
+                    std::make_unique<StructBuffer>(*struct_type, struct_mappings_.back(), clock_));
             } else {
                 LOG(ERROR) << "Unknown struct type: " << mapping.struct_type;
                 return false;
@@ -292,9 +228,15 @@ bool VSSStructMapper::load_struct_mappings(const std::string& mapping_file) {
 
 std::vector<VSSSignal> VSSStructMapper::process_struct_signals(
     const std::vector<std::pair<std::string, double>>& can_signals) {
-    
     std::vector<VSSSignal> vss_signals;
-    auto now = std::chrono::steady_clock::now();
+    process_struct_signals(can_signals, vss_signals);
+    return vss_signals;
+}
+
+void VSSStructMapper::process_struct_signals(
+    const std::vector<std::pair<std::string, double>>& can_signals,
+    std::vector<VSSSignal>& vss_signals) {
+    auto now = clock_->now();
     
     // Process each CAN signal
     for (const auto& [can_signal, value] : can_signals) {
@@ -313,16 +255,10 @@ std::vector<VSSSignal> VSSStructMapper::process_struct_signals(
                 // Apply transformation
                 auto transformed = apply_transform(value, prop_mapping.transform, can_signal);
                 
-                // Extract property name from path (e.g., "Types.Location.Latitude" -> "Latitude")
-                size_t last_dot = prop_mapping.property_path.rfind('.');
-                std::string prop_name = (last_dot != std::string::npos) 
-                    ? prop_mapping.property_path.substr(last_dot + 1)
-                    : prop_mapping.property_path;
-                
                 // Update buffer
-                buffer->update_field(prop_name, transformed);
+                buffer->update_field(prop_mapping.property_name, transformed);
                 
-                VLOG(3) << "Updated " << prop_name << " in struct " << mapping.vss_path;
+                VLOG(3) << "Updated " << prop_mapping.property_name << " in struct " << mapping.vss_path;
                 break;
             }
         }
@@ -366,15 +302,15 @@ std::vector<VSSSignal> VSSStructMapper::process_struct_signals(
                     vss_signal.path = mapping.vss_path;
                     vss_signal.qualified_value.value = struct_value;
                     vss_signal.qualified_value.quality = vss::types::SignalQuality::VALID;
-                    vss_signal.qualified_value.timestamp = std::chrono::system_clock::now();
+                    vss_signal.qualified_value.timestamp = clock_->wall_time();
 
-                    vss_signals.push_back(vss_signal);
+                    vss_signals.push_back(std::move(vss_signal));
                     last_time = now;
 
                     // Clear buffer after emission
                     buffer->clear();
 
-                    LOG(INFO) << "Emitted struct signal: " << mapping.vss_path;
+                    VLOG(1) << "Emitted struct signal: " << mapping.vss_path;
                 }
             }
         }
@@ -403,17 +339,15 @@ std::vector<VSSSignal> VSSStructMapper::process_struct_signals(
                 vss_signal.path = mapping.vss_path;
                 vss_signal.qualified_value.value = struct_value;
                 vss_signal.qualified_value.quality = vss::types::SignalQuality::VALID;
-                vss_signal.qualified_value.timestamp = std::chrono::system_clock::now();
+                vss_signal.qualified_value.timestamp = clock_->wall_time();
 
-                vss_signals.push_back(vss_signal);
+                vss_signals.push_back(std::move(vss_signal));
                 buffer->clear();
 
-                LOG(INFO) << "Emitted partial struct signal: " << mapping.vss_path;
+                VLOG(1) << "Emitted partial struct signal: " << mapping.vss_path;
             }
         }
     }
-    
-    return vss_signals;
 }
 
 const StructType* VSSStructMapper::get_struct_type(const std::string& type_path) const {
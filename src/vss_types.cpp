@@ -1,7 +1,5 @@
 #include "vssdag/vss_types.h"
-#include <sstream>
-#include <iomanip>
-#include <cmath>
+#include "vssdag/value_codec.h"
 #include <lua.hpp>
 
 namespace vssdag {
@@ -266,243 +264,20 @@ Value VSSTypeHelper::from_lua_table_typed(void* lua_state, int table_index, Valu
 
 // Push VSS value to Lua stack preserving type information
 void VSSTypeHelper::push_value_to_lua(void* lua_state, const Value& value) {
-    lua_State* L = static_cast<lua_State*>(lua_state);
-
-    std::visit([L](auto&& val) {
-        using T = std::decay_t<decltype(val)>;
-
-        if constexpr (std::is_same_v<T, std::monostate>) {
-            // Push nil for empty value
-            lua_pushnil(L);
-        } else if constexpr (std::is_same_v<T, bool>) {
-            lua_pushboolean(L, val);
-        } else if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
-                             std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>) {
-            // Push as integer
-            lua_pushinteger(L, static_cast<lua_Integer>(val));
-        } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-            // Push as number
-            lua_pushnumber(L, static_cast<lua_Number>(val));
-        } else if constexpr (std::is_same_v<T, std::string>) {
-            // Push as string
-            lua_pushstring(L, val.c_str());
-        } else if constexpr (std::is_same_v<T, std::shared_ptr<StructValue>>) {
-            // Push struct as table
-            lua_newtable(L);
-            for (const auto& [key, field_value] : val->fields()) {
-                lua_pushstring(L, key.c_str());
-                push_value_to_lua(L, field_value);
-                lua_settable(L, -3);
-            }
-        } else if constexpr (std::is_same_v<T, std::vector<bool>>) {
-            // Push bool array as table (1-indexed in Lua)
-            lua_newtable(L);
-            for (size_t i = 0; i < val.size(); ++i) {
-                lua_pushinteger(L, i + 1);
-                lua_pushboolean(L, val[i]);
-                lua_settable(L, -3);
-            }
-        } else if constexpr (std::is_same_v<T, std::vector<int32_t>> ||
-                             std::is_same_v<T, std::vector<int64_t>> ||
-                             std::is_same_v<T, std::vector<uint32_t>> ||
-                             std::is_same_v<T, std::vector<uint64_t>>) {
-            // Push integer array as table (1-indexed in Lua)
-            lua_newtable(L);
-            for (size_t i = 0; i < val.size(); ++i) {
-                lua_pushinteger(L, i + 1);
-                lua_pushinteger(L, static_cast<lua_Integer>(val[i]));
-                lua_settable(L, -3);
-            }
-        } else if constexpr (std::is_same_v<T, std::vector<float>> ||
-                             std::is_same_v<T, std::vector<double>>) {
-            // Push float array as table (1-indexed in Lua)
-            lua_newtable(L);
-            for (size_t i = 0; i < val.size(); ++i) {
-                lua_pushinteger(L, i + 1);
-                lua_pushnumber(L, static_cast<lua_Number>(val[i]));
-                lua_settable(L, -3);
-            }
-        } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
-            // Push string array as table (1-indexed in Lua)
-            lua_newtable(L);
-            for (size_t i = 0; i < val.size(); ++i) {
-                lua_pushinteger(L, i + 1);
-                lua_pushstring(L, val[i].c_str());
-                lua_settable(L, -3);
-            }
-        } else if constexpr (std::is_same_v<T, std::vector<std::shared_ptr<StructValue>>>) {
-            // Push struct array as table (1-indexed in Lua)
-            lua_newtable(L);
-            for (size_t i = 0; i < val.size(); ++i) {
-                lua_pushinteger(L, i + 1);
-                push_value_to_lua(L, val[i]);
-                lua_settable(L, -3);
-            }
-        }
-    }, value);
+    value_codec_of(value).push_lua(static_cast<lua_State*>(lua_state), value);
 }
 
 // Format VSS value as string for output
 std::string VSSTypeHelper::to_string(const Value& value) {
-    return std::visit([](const auto& v) -> std::string {
-        using T = std::decay_t<decltype(v)>;
-
-        if constexpr (std::is_same_v<T, std::monostate>) {
-            return "null";
-        } else if constexpr (std::is_same_v<T, bool>) {
-            return v ? "true" : "false";
-        } else if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
-                             std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>) {
-            return std::to_string(v);
-        } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-            // Clean up floating point display
-            if (std::abs(v) < 1e-6) {
-                return "0";
-            }
-            std::stringstream ss;
-            ss << std::fixed << std::setprecision(6) << v;
-            std::string result = ss.str();
-            // Remove trailing zeros
-            result.erase(result.find_last_not_of('0') + 1, std::string::npos);
-            if (result.back() == '.') {
-                result.pop_back();
-            }
-            return result;
-        } else if constexpr (std::is_same_v<T, std::string>) {
-            return v;
-        } else if constexpr (std::is_same_v<T, std::shared_ptr<StructValue>>) {
-            return to_json(v);  // Use JSON format for structs
-        } else if constexpr (std::is_same_v<T, std::vector<bool>> ||
-                             std::is_same_v<T, std::vector<int32_t>> ||
-                             std::is_same_v<T, std::vector<int64_t>> ||
-                             std::is_same_v<T, std::vector<uint32_t>> ||
-                             std::is_same_v<T, std::vector<uint64_t>> ||
-                             std::is_same_v<T, std::vector<float>> ||
-                             std::is_same_v<T, std::vector<double>> ||
-                             std::is_same_v<T, std::vector<std::string>> ||
-                             std::is_same_v<T, std::vector<std::shared_ptr<StructValue>>>) {
-            return to_json(v);  // Use JSON format for arrays
-        }
-        return "";
-    }, value);
+    if (const auto* text = std::get_if<std::string>(&value)) {
+        return *text;
+    }
+    return value_to_json(value);
 }
 
 // Format VSS value as JSON string
 std::string VSSTypeHelper::to_json(const Value& value) {
-    return std::visit([](const auto& v) -> std::string {
-        using T = std::decay_t<decltype(v)>;
-
-        if constexpr (std::is_same_v<T, std::monostate>) {
-            return "null";
-        } else if constexpr (std::is_same_v<T, bool>) {
-            return v ? "true" : "false";
-        } else if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
-                             std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>) {
-            return std::to_string(v);
-        } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-            // Clean up floating point display
-            if (std::abs(v) < 1e-6) {
-                return "0";
-            }
-            std::stringstream ss;
-            ss << std::fixed << std::setprecision(6) << v;
-            std::string result = ss.str();
-            // Remove trailing zeros
-            result.erase(result.find_last_not_of('0') + 1, std::string::npos);
-            if (result.back() == '.') {
-                result.pop_back();
-            }
-            return result;
-        } else if constexpr (std::is_same_v<T, std::string>) {
-            // Escape string for JSON
-            std::stringstream ss;
-            ss << "\"";
-            for (char c : v) {
-                switch (c) {
-                    case '"': ss << "\\\""; break;
-                    case '\\': ss << "\\\\"; break;
-                    case '\b': ss << "\\b"; break;
-                    case '\f': ss << "\\f"; break;
-                    case '\n': ss << "\\n"; break;
-                    case '\r': ss << "\\r"; break;
-                    case '\t': ss << "\\t"; break;
-                    default:
-                        if (c >= 0x20 && c <= 0x7E) {
-                            ss << c;
-                        } else {
-                            ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c;
-                        }
-                }
-            }
-            ss << "\"";
-            return ss.str();
-        } else if constexpr (std::is_same_v<T, std::shared_ptr<StructValue>>) {
-            std::stringstream ss;
-            ss << "{";
-            bool first = true;
-            for (const auto& [key, field_value] : v->fields()) {
-                if (!first) ss << ",";
-                ss << "\"" << key << "\":" << to_json(field_value);
-                first = false;
-            }
-            ss << "}";
-            return ss.str();
-        } else if constexpr (std::is_same_v<T, std::vector<bool>>) {
-            std::stringstream ss;
-            ss << "[";
-            for (size_t i = 0; i < v.size(); ++i) {
-                if (i > 0) ss << ",";
-                ss << (v[i] ? "true" : "false");
-            }
-            ss << "]";
-            return ss.str();
-        } else if constexpr (std::is_same_v<T, std::vector<int32_t>> ||
-                             std::is_same_v<T, std::vector<int64_t>> ||
-                             std::is_same_v<T, std::vector<uint32_t>> ||
-                             std::is_same_v<T, std::vector<uint64_t>>) {
-            std::stringstream ss;
-            ss << "[";
-            for (size_t i = 0; i < v.size(); ++i) {
-                if (i > 0) ss << ",";
-                ss << v[i];
-            }
-            ss << "]";
-            return ss.str();
-        } else if constexpr (std::is_same_v<T, std::vector<float>> ||
-                             std::is_same_v<T, std::vector<double>>) {
-            std::stringstream ss;
-            ss << "[";
-            for (size_t i = 0; i < v.size(); ++i) {
-                if (i > 0) ss << ",";
-                if (std::abs(v[i]) < 1e-6) {
-                    ss << "0";
-                } else {
-                    ss << std::fixed << std::setprecision(6) << v[i];
-                }
-            }
-            ss << "]";
-            return ss.str();
-        } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
-            std::stringstream ss;
-            ss << "[";
-            for (size_t i = 0; i < v.size(); ++i) {
-                if (i > 0) ss << ",";
-                ss << to_json(v[i]);
-            }
-            ss << "]";
-            return ss.str();
-        } else if constexpr (std::is_same_v<T, std::vector<std::shared_ptr<StructValue>>>) {
-            std::stringstream ss;
-            ss << "[";
-            for (size_t i = 0; i < v.size(); ++i) {
-                if (i > 0) ss << ",";
-                ss << to_json(v[i]);
-            }
-            ss << "]";
-            return ss.str();
-        }
-        return "null";
-    }, value);
+    return value_to_json(value);
 }
 
 } // namespace vssdag
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "vssdag/window_aggregator.h"
+#include <algorithm>
+
+namespace vssdag {
+
+SlidingWindow::SlidingWindow(std::chrono::steady_clock::duration span)
+    : span_(span) {
+}
+
+SlidingWindow::SlidingWindow(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)) {
+}
+
+void SlidingWindow::push(time_point timestamp, double value) {
+    Sample sample{timestamp, value, next_seq_++};
+
+    samples_.push_back(sample);
+    sum_ += value;
+
+    while (!min_deque_.empty() && min_deque_.back().value >= value) {
+        min_deque_.pop_back();
+    }
+    min_deque_.push_back(sample);
+
+    while (!max_deque_.empty() && max_deque_.back().value <= value) {
+        max_deque_.pop_back();
+    }
+    max_deque_.push_back(sample);
+
+    if (capacity_ > 0) {
+        while (samples_.size() > capacity_) {
+            evict_front();
+        }
+    } else {
+        expire(timestamp);
+    }
+}
+
+void SlidingWindow::expire(time_point now) {
+    if (capacity_ > 0) {
+        return;
+    }
+    while (!samples_.empty() && samples_.front().timestamp <= now - span_) {
+        evict_front();
+    }
+}
+
+std::optional<WindowStats> SlidingWindow::stats() const {
+    if (samples_.empty()) {
+        return std::nullopt;
+    }
+
+    WindowStats stats;
+    stats.min = min_deque_.front().value;
+    stats.max = max_deque_.front().value;
+    stats.sum = sum_;
+    stats.last = samples_.back().value;
+    stats.count = samples_.size();
+    return stats;
+}
+
+void SlidingWindow::evict_front() {
+    const Sample& oldest = samples_.front();
+    if (!min_deque_.empty() && min_deque_.front().seq == oldest.seq) {
+        min_deque_.pop_front();
+    }
+    if (!max_deque_.empty() && max_deque_.front().seq == oldest.seq) {
+        max_deque_.pop_front();
+    }
+    samples_.pop_front();
+
+    if (samples_.empty()) {
+        sum_ = 0.0;  // Drop accumulated rounding error
+    } else {
+        sum_ -= oldest.value;
+    }
+}
+
+TumblingWindow::TumblingWindow(std::chrono::steady_clock::duration span)
+    : span_(span) {
+}
+
+TumblingWindow::TumblingWindow(size_t count)
+    : count_(std::max<size_t>(count, 1)) {
+}
+
+bool TumblingWindow::push(time_point timestamp, double value) {
+    bool closed = advance(timestamp);
+
+    if (count_ == 0 && !boundary_) {
+        // First sample after start or an idle period: align to span
+        auto since_epoch = timestamp.time_since_epoch();
+        boundary_ = time_point(since_epoch - since_epoch % span_ + span_);
+    }
+
+    add(value);
+
+    if (count_ > 0 && current_.count >= count_) {
+        completed_ = current_;
+        current_ = WindowStats{};
+        closed = true;
+    }
+    return closed;
+}
+
+bool TumblingWindow::advance(time_point now) {
+    if (!boundary_ || now < *boundary_) {
+        return false;
+    }
+
+    if (now < *boundary_ + span_ && current_.count > 0) {
+        completed_ = current_;
+    } else {
+        completed_.reset();  // Most recent full window had no samples
+    }
+
+    // Stop ticking while idle; the next sample re-aligns the boundary
+    if (current_.count > 0) {
+        auto since_epoch = now.time_since_epoch();
+        boundary_ = time_point(since_epoch - since_epoch % span_ + span_);
+    } else {
+        boundary_.reset();
+    }
+    current_ = WindowStats{};
+    return true;
+}
+
+std::optional<TumblingWindow::time_point> TumblingWindow::next_boundary() const {
+    return boundary_;
+}
+
+void TumblingWindow::add(double value) {
+    if (current_.count == 0) {
+        current_.min = value;
+        current_.max = value;
+    } else {
+        current_.min = std::min(current_.min, value);
+        current_.max = std::max(current_.max, value);
+    }
+    current_.sum += value;
+    current_.last = value;
+    ++current_.count;
+}
+
+} // namespace vssdag
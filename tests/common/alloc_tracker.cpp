@@ -0,0 +1,118 @@
+#include "alloc_tracker.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Trivially initialised, so reading them never allocates
+thread_local uint64_t t_allocations = 0;
+thread_local uint64_t t_bytes = 0;
+
+inline void count(size_t bytes) {
+    ++t_allocations;
+    t_bytes += bytes;
+}
+
+} // namespace
+
+#if defined(__GLIBC__)
+// glibc lets a program replace malloc; forward to its implementation and
+// route operator new there directly so each allocation is counted once
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) noexcept {
+    count(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size) noexcept {
+    count(n * size);
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    count(size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept {
+    __libc_free(ptr);
+}
+}
+
+namespace {
+inline void* raw_malloc(size_t size) { return __libc_malloc(size); }
+inline void raw_free(void* ptr) { __libc_free(ptr); }
+} // namespace
+#else
+namespace {
+inline void* raw_malloc(size_t size) { return std::malloc(size); }
+inline void raw_free(void* ptr) { std::free(ptr); }
+} // namespace
+#endif
+
+void* operator new(size_t size) {
+    count(size);
+    if (void* p = raw_malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    count(size);
+    return raw_malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    count(size);
+    size_t align = static_cast<size_t>(alignment);
+    // aligned_alloc wants a multiple of the alignment
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void* p) noexcept { raw_free(p); }
+void operator delete[](void* p) noexcept { raw_free(p); }
+void operator delete(void* p, size_t) noexcept { raw_free(p); }
+void operator delete[](void* p, size_t) noexcept { raw_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { raw_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { raw_free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { raw_free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { raw_free(p); }
+
+namespace vssdag::test {
+
+AllocCounts thread_alloc_counts() {
+    return {t_allocations, t_bytes};
+}
+
+void report_allocs(const std::string& operation, const AllocCounts& counts, uint64_t ops) {
+    double per_op = ops ? static_cast<double>(counts.allocations) / ops : 0.0;
+    double bytes_per_op = ops ? static_cast<double>(counts.bytes) / ops : 0.0;
+    std::printf("[ALLOCS] %s: %.2f allocations (%.0f bytes) per op over %llu ops\n",
+                operation.c_str(), per_op, bytes_per_op, static_cast<unsigned long long>(ops));
+    ::testing::Test::RecordProperty(operation + "_allocs_per_op", std::to_string(per_op));
+}
+
+} // namespace vssdag::test
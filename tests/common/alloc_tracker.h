@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Heap allocation counting for tests. Linking alloc_tracker.cpp replaces the
+// global operator new (and, on glibc, malloc/calloc/realloc) with versions
+// that count per thread, so work done by other threads is not attributed to
+// the code under measurement.
+namespace vssdag::test {
+
+struct AllocCounts {
+    uint64_t allocations = 0;  // operator new and malloc-family calls
+    uint64_t bytes = 0;        // Bytes requested by those calls
+};
+
+// Totals for the calling thread since it started
+AllocCounts thread_alloc_counts();
+
+// Counts the calling thread's allocations from construction on
+class AllocScope {
+public:
+    AllocScope() : start_(thread_alloc_counts()) {}
+
+    AllocCounts counts() const {
+        AllocCounts now = thread_alloc_counts();
+        return {now.allocations - start_.allocations, now.bytes - start_.bytes};
+    }
+
+private:
+    AllocCounts start_;
+};
+
+// Print "[ALLOCS] operation: N allocations (B bytes) per op over M ops" and
+// record it as a gtest property of the current test
+void report_allocs(const std::string& operation, const AllocCounts& counts, uint64_t ops);
+
+} // namespace vssdag::test
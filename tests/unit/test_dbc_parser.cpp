@@ -129,6 +129,12 @@ TEST_F(DBCParserTest, GetMessageIdForSignal) {
     
     msg_id = parser.get_message_id_for_signal("NonExistentSignal");
     EXPECT_FALSE(msg_id.has_value());
+
+    // Lookups take views, e.g. into a larger buffer
+    std::string_view buffer = "VoltageSpeed";
+    EXPECT_EQ(parser.get_message_id_for_signal(buffer.substr(0, 7)), 512u);
+    EXPECT_EQ(parser.get_message_id_for_signal(buffer.substr(7)), 256u);
+    EXPECT_FALSE(parser.get_message_id_for_signal(buffer).has_value());
 }
 
 // Test decoding CAN frame with decode_message
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "vssdag/dependency_join.h"
+
+using namespace vssdag;
+using namespace std::chrono_literals;
+
+class DependencyJoinTest : public ::testing::Test {
+protected:
+    std::chrono::steady_clock::time_point t0{std::chrono::seconds(1000)};
+
+    static double value_of(const DependencyJoin::Sample& sample) {
+        return std::get<double>(sample.value);
+    }
+};
+
+// Test that WAIT_ALL evaluates once per set of samples within tolerance
+TEST_F(DependencyJoinTest, WaitAllWithinTolerance) {
+    DependencyJoin join(JoinPolicy::WAIT_ALL, 20ms, 2);
+
+    join.record(0, t0, 1.0, SignalQuality::VALID);
+    EXPECT_FALSE(join.align());  // Second dependency missing
+
+    join.record(1, t0 + 50ms, 10.0, SignalQuality::VALID);
+    EXPECT_FALSE(join.align());  // 50ms apart
+
+    join.record(0, t0 + 45ms, 2.0, SignalQuality::VALID);
+    ASSERT_TRUE(join.align());
+    EXPECT_DOUBLE_EQ(value_of(join.aligned(0)), 2.0);
+    EXPECT_DOUBLE_EQ(value_of(join.aligned(1)), 10.0);
+    EXPECT_EQ(join.aligned_time(), t0 + 50ms);
+
+    // Only one dependency updated since: no new set
+    join.record(0, t0 + 60ms, 3.0, SignalQuality::VALID);
+    EXPECT_FALSE(join.align());
+
+    join.record(1, t0 + 65ms, 11.0, SignalQuality::VALID);
+    ASSERT_TRUE(join.align());
+    EXPECT_DOUBLE_EQ(value_of(join.aligned(0)), 3.0);
+}
+
+// Test INTERPOLATE aligns dependencies to the latest common time
+TEST_F(DependencyJoinTest, InterpolatesToCommonTime) {
+    DependencyJoin join(JoinPolicy::INTERPOLATE, 0ms, 2);
+
+    join.record(0, t0, 0.0, SignalQuality::VALID);
+    join.record(0, t0 + 100ms, 100.0, SignalQuality::VALID);
+    join.record(1, t0 + 40ms, 5.0, SignalQuality::VALID);
+
+    ASSERT_TRUE(join.align());
+    EXPECT_EQ(join.aligned_time(), t0 + 40ms);
+    EXPECT_DOUBLE_EQ(value_of(join.aligned(0)), 40.0);
+    EXPECT_DOUBLE_EQ(value_of(join.aligned(1)), 5.0);
+
+    // Nothing new for the slow dependency
+    join.record(0, t0 + 110ms, 110.0, SignalQuality::VALID);
+    EXPECT_FALSE(join.align());
+}
+
+// Test INTERPOLATE holds a dependency that lags beyond the tolerance
+TEST_F(DependencyJoinTest, InterpolateHoldsStaleDependency) {
+    DependencyJoin join(JoinPolicy::INTERPOLATE, 100ms, 2);
+
+    join.record(0, t0, 1.0, SignalQuality::VALID);
+    join.record(1, t0, 2.0, SignalQuality::VALID);
+    ASSERT_TRUE(join.align());
+
+    join.record(0, t0 + 500ms, 3.0, SignalQuality::VALID);
+    ASSERT_TRUE(join.align());
+    EXPECT_EQ(join.aligned_time(), t0 + 400ms);
+    EXPECT_DOUBLE_EQ(value_of(join.aligned(0)), 2.6);
+    EXPECT_DOUBLE_EQ(value_of(join.aligned(1)), 2.0);
+}
+
+// Test that non-numeric or invalid samples are held, not interpolated
+TEST_F(DependencyJoinTest, HoldsNonNumericAndInvalid) {
+    DependencyJoin join(JoinPolicy::INTERPOLATE, 0ms, 2);
+
+    join.record(0, t0, std::string("P"), SignalQuality::VALID);
+    join.record(0, t0 + 100ms, std::string("D"), SignalQuality::VALID);
+    join.record(1, t0, 0.0, SignalQuality::INVALID);
+    join.record(1, t0 + 100ms, 8.0, SignalQuality::VALID);
+    ASSERT_TRUE(join.align());  // t0 + 100ms
+    EXPECT_EQ(std::get<std::string>(join.aligned(0).value), "D");
+
+    join.record(0, t0 + 200ms, std::string("R"), SignalQuality::VALID);
+    join.record(1, t0 + 150ms, 9.0, SignalQuality::VALID);
+    ASSERT_TRUE(join.align());  // t0 + 150ms
+    EXPECT_EQ(std::get<std::string>(join.aligned(0).value), "D");
+    EXPECT_DOUBLE_EQ(value_of(join.aligned(1)), 9.0);
+}
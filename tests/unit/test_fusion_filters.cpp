@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "vssdag/fusion_filters.h"
+
+using namespace vssdag;
+
+// Test that a scalar Kalman filter averages noisy measurements
+TEST(FusionFiltersTest, ScalarKalmanConverges) {
+    KalmanFilter<1> kf;
+    kf.initialize({0.0}, {100.0});
+
+    KalmanFilter<1>::Matrix F, Q;
+    random_walk_model(0.1, 1e-6, F, Q);
+    for (int i = 0; i < 200; ++i) {
+        kf.predict(F, Q);
+        kf.update({1.0}, (i % 2 == 0) ? 11.0 : 9.0, 1.0);
+    }
+    EXPECT_NEAR(kf.state()[0], 10.0, 0.05);
+    EXPECT_LT(kf.covariance()[0][0], 0.05);
+}
+
+// Test that the constant velocity model recovers the rate of a ramp
+TEST(FusionFiltersTest, ConstantVelocityEstimatesRate) {
+    KalmanFilter<2> kf;
+    kf.initialize({0.0, 0.0}, {1.0, 1e6});
+
+    KalmanFilter<2>::Matrix F, Q;
+    constant_velocity_model(0.1, 0.01, F, Q);
+    for (int i = 1; i <= 100; ++i) {
+        kf.predict(F, Q);
+        kf.update({1.0, 0.0}, 2.0 * 0.1 * i, 0.01);
+    }
+    EXPECT_NEAR(kf.state()[0], 20.0, 0.05);
+    EXPECT_NEAR(kf.state()[1], 2.0, 0.05);
+}
+
+// Test sequential fusion of two sensors weighted by their variance
+TEST(FusionFiltersTest, SequentialUpdatesWeightByVariance) {
+    KalmanFilter<1> kf;
+    kf.initialize({0.0}, {1e6});
+    kf.update({1.0}, 10.0, 1.0);   // Precise sensor
+    kf.update({1.0}, 20.0, 100.0); // Noisy sensor
+    EXPECT_NEAR(kf.state()[0], 10.0 + 10.0 / 101.0, 1e-3);
+}
+
+// Test complementary filter blending of rate and absolute measurement
+TEST(FusionFiltersTest, ComplementaryFilter) {
+    ComplementaryFilter filter;
+    EXPECT_DOUBLE_EQ(filter.update(0.0, 0.0, 5.0, 1.0), 5.0);
+
+    // Rate integration dominates over short horizons
+    double value = filter.update(0.1, 10.0, 5.0, 1.0);
+    EXPECT_NEAR(value, 5.0 + 1.0 / 1.1, 1e-9);
+
+    // Constant measurement wins in the long run
+    for (int i = 0; i < 200; ++i) {
+        value = filter.update(0.1, 0.0, 7.0, 1.0);
+    }
+    EXPECT_NEAR(value, 7.0, 1e-6);
+
+    EXPECT_DOUBLE_EQ(filter.predict(0.5, 2.0), value + 1.0);
+}
@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+#include <linux/can.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include "alloc_tracker.h"
+#include "vssdag/can/can_reader.h"
+#include "vssdag/can/can_source.h"
+#include "vssdag/can/dbc_parser.h"
+#include "vssdag/mapping_loader.h"
+#include "vssdag/signal_processor.h"
+
+// Allocation budgets for the per-frame and per-batch hot paths. A failure
+// here means new allocations crept into a path that used to be free of them;
+// the [ALLOCS] lines report the measured counts per operation.
+
+using namespace vssdag;
+using vssdag::test::AllocScope;
+using vssdag::test::report_allocs;
+
+namespace {
+
+const std::string kModel3Dir = std::string(VSSDAG_EXAMPLES_DIR) + "/tesla_model3/";
+
+// Frames of the recorded Model 3 candump, "(time) iface ID#DATA" per line
+std::vector<CANFrame> load_candump(const std::string& path, size_t max_frames) {
+    std::vector<CANFrame> frames;
+    std::ifstream file(path);
+    std::string line;
+    while (frames.size() < max_frames && std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string time, iface, payload;
+        fields >> time >> iface >> payload;
+        auto hash = payload.find('#');
+        if (hash == std::string::npos) {
+            continue;
+        }
+        CANFrame frame;
+        frame.id = std::stoul(payload.substr(0, hash), nullptr, 16);
+        for (size_t i = hash + 1; i + 1 < payload.size(); i += 2) {
+            frame.data.push_back(static_cast<uint8_t>(std::stoul(payload.substr(i, 2), nullptr, 16)));
+        }
+        frame.timestamp_us = 0;
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+// Reader driven from the test thread instead of a socket
+class ManualCANReader : public CANReader {
+public:
+    bool open(const std::string&) override { return true; }
+    void close() override {}
+    bool is_open() const override { return true; }
+    void read_loop() override {
+        while (!stopped_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    void stop() override { stopped_ = true; }
+
+    void deliver(const CANFrame& frame) { frame_handler_(frame); }
+
+private:
+    std::atomic<bool> stopped_{false};
+};
+
+constexpr int kBatches = 200;
+
+// Allocations of kBatches process_signal_updates() calls after a warm-up.
+// Every input changes in every 10 ms batch, so throttled and periodic nodes
+// run as well.
+vssdag::test::AllocCounts measure_batches(const std::unordered_map<std::string, SignalMapping>& mappings) {
+    std::vector<SignalUpdate> updates;
+    for (const auto& [name, mapping] : mappings) {
+        if (mapping.source.type == "dbc") {
+            SignalUpdate update;
+            update.signal_name = name;
+            updates.push_back(update);
+        }
+    }
+
+    auto clock = std::make_shared<SimulatedClock>();
+    SignalProcessorDAG processor(clock);
+    EXPECT_TRUE(processor.initialize(mappings));
+
+    std::vector<VSSSignal> out;
+    size_t outputs = 0;
+    auto batch = [&](int i) {
+        clock->advance_by(std::chrono::milliseconds(10));
+        for (size_t k = 0; k < updates.size(); ++k) {
+            updates[k].value = static_cast<double>((i + static_cast<int>(k) * 7) % 40);
+            updates[k].timestamp = clock->now();
+        }
+        out.clear();
+        processor.process_signal_updates(updates, out);
+        outputs += out.size();
+    };
+    for (int i = 0; i < 1000; ++i) {
+        batch(i);
+    }
+
+    AllocScope scope;
+    for (int i = 0; i < kBatches; ++i) {
+        batch(1000 + i);
+    }
+    auto counts = scope.counts();
+    EXPECT_GT(outputs, 0u);
+    return counts;
+}
+
+// Adds the allocations seen by scope to total
+void accumulate(vssdag::test::AllocCounts& total, const AllocScope& scope) {
+    auto counts = scope.counts();
+    total.allocations += counts.allocations;
+    total.bytes += counts.bytes;
+}
+
+} // namespace
+
+TEST(HotPathAllocationsTest, SocketCANReaderFrame) {
+    SocketCANReader reader;
+    if (!reader.open("vcan0")) {
+        GTEST_SKIP() << "vcan0 not available";
+    }
+
+    int writer = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    ASSERT_GE(writer, 0);
+    struct ifreq ifr;
+    std::strncpy(ifr.ifr_name, "vcan0", IFNAMSIZ - 1);
+    ifr.ifr_name[IFNAMSIZ - 1] = '\0';
+    ASSERT_EQ(ioctl(writer, SIOCGIFINDEX, &ifr), 0);
+    struct sockaddr_can addr = {};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    ASSERT_EQ(bind(writer, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)), 0);
+
+    constexpr int kWarmup = 10;
+    constexpr int kFrames = 200;
+    for (int i = 0; i < kFrames; ++i) {
+        struct can_frame frame = {};
+        frame.can_id = 0x100 + i % 4;
+        frame.can_dlc = 8;
+        frame.data[0] = static_cast<uint8_t>(i);
+        ASSERT_EQ(write(writer, &frame, sizeof(frame)), static_cast<ssize_t>(sizeof(frame)));
+    }
+
+    // Everything between the warm-up frame and the last frame handler call
+    // is the reader's per-frame work
+    int received = 0;
+    std::optional<AllocScope> scope;
+    vssdag::test::AllocCounts counts;
+    reader.set_frame_handler([&](const CANFrame&) {
+        if (++received == kWarmup) {
+            scope.emplace();
+        } else if (received == kFrames) {
+            counts = scope->counts();
+            reader.stop();
+        }
+    });
+    reader.read_loop();
+    close(writer);
+
+    ASSERT_EQ(received, kFrames);
+    report_allocs("socketcan_frame", counts, kFrames - kWarmup);
+    EXPECT_EQ(counts.allocations, 0u);
+}
+
+TEST(HotPathAllocationsTest, DBCParserDecode) {
+    DBCParser parser(kModel3Dir + "Model3CAN.dbc");
+    ASSERT_TRUE(parser.parse());
+    auto frames = load_candump(kModel3Dir + "candump.log", 2000);
+    ASSERT_FALSE(frames.empty());
+
+    std::vector<DBCSignalUpdate> updates;
+    size_t decoded = 0;
+    for (const auto& frame : frames) {
+        updates.clear();
+        parser.decode_message_as_updates(frame.id, frame.data.data(), frame.data.size(), updates);
+    }
+
+    AllocScope scope;
+    for (const auto& frame : frames) {
+        updates.clear();
+        parser.decode_message_as_updates(frame.id, frame.data.data(), frame.data.size(), updates);
+        decoded += updates.size();
+    }
+    auto counts = scope.counts();
+    report_allocs("dbc_decode", counts, frames.size());
+    EXPECT_GT(decoded, 0u);
+    EXPECT_EQ(counts.allocations, 0u);
+
+    // The map-returning decode allocates by design; reported for comparison
+    AllocScope map_scope;
+    for (const auto& frame : frames) {
+        parser.decode_message(frame.id, frame.data.data(), frame.data.size());
+    }
+    report_allocs("dbc_decode_map", map_scope.counts(), frames.size());
+}
+
+TEST(HotPathAllocationsTest, CANSignalSourceFrame) {
+    MappingConfig config;
+    ASSERT_TRUE(load_mapping_file(kModel3Dir + "model3_mappings_dag.yaml", config));
+    auto frames = load_candump(kModel3Dir + "candump.log", 2000);
+    ASSERT_FALSE(frames.empty());
+
+    // Decoding on the reader thread (queue of updates), then in poll_into()
+    // from a ring of raw frames
+    for (bool poll_decode : {false, true}) {
+        SCOPED_TRACE(poll_decode ? "poll decode" : "reader decode");
+        auto reader = std::make_unique<ManualCANReader>();
+        ManualCANReader* manual = reader.get();
+        CANSignalSource source("manual", kModel3Dir + "Model3CAN.dbc", config.mappings, std::move(reader));
+        if (poll_decode) {
+            source.enable_poll_decode(16);  // Small, so the warm-up pass fills every slot
+        }
+        ASSERT_TRUE(source.initialize());
+
+        // Frames are handled on this thread, then drained as the pipeline would
+        std::vector<SignalUpdate> updates;
+        vssdag::test::AllocCounts frame_counts, poll_counts;
+        for (int pass = 0; pass < 2; ++pass) {
+            bool measure = pass == 1;  // The first pass warms up queue and buffers
+            for (const auto& frame : frames) {
+                AllocScope frame_scope;
+                manual->deliver(frame);
+                if (measure) {
+                    accumulate(frame_counts, frame_scope);
+                }
+
+                AllocScope poll_scope;
+                updates.clear();
+                source.poll_into(updates);
+                if (measure) {
+                    accumulate(poll_counts, poll_scope);
+                }
+            }
+        }
+        source.stop();
+
+        std::string mode = poll_decode ? "can_source_poll_decode" : "can_source";
+        report_allocs(mode + "_frame", frame_counts, frames.size());
+        report_allocs(mode + "_poll", poll_counts, frames.size());
+        EXPECT_EQ(frame_counts.allocations, 0u);
+        EXPECT_EQ(poll_counts.allocations, 0u);
+    }
+}
+
+TEST(HotPathAllocationsTest, Model3ProcessBatch) {
+    MappingConfig config;
+    ASSERT_TRUE(load_mapping_file(kModel3Dir + "model3_mappings_dag.yaml", config));
+
+    auto with_structs = measure_batches(config.mappings);
+    report_allocs("model3_batch", with_structs, kBatches);
+
+    // Struct outputs build a vss-types StructValue per evaluation, which
+    // allocates by design; every other Model 3 signal must not allocate
+    for (auto it = config.mappings.begin(); it != config.mappings.end();) {
+        it = it->second.datatype == ValueType::STRUCT ? config.mappings.erase(it) : std::next(it);
+    }
+    auto without_structs = measure_batches(config.mappings);
+    report_allocs("model3_batch_no_structs", without_structs, kBatches);
+    EXPECT_EQ(without_structs.allocations, 0u);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "vssdag/hysteresis.h"
+
+using namespace vssdag;
+using namespace std::chrono_literals;
+
+class HysteresisTest : public ::testing::Test {
+protected:
+    std::chrono::steady_clock::time_point t0{std::chrono::seconds(1000)};
+    Hysteresis hysteresis;
+};
+
+// Test switching between the two thresholds
+TEST_F(HysteresisTest, SwitchesAtThresholds) {
+    Hysteresis::Config config{100.0, 90.0, {}, {}};
+
+    auto r = hysteresis.update(t0, 50.0, config);
+    EXPECT_FALSE(r.state);
+    EXPECT_TRUE(r.changed);  // Initial state
+
+    EXPECT_FALSE(hysteresis.update(t0, 99.0, config).changed);
+    r = hysteresis.update(t0, 100.0, config);
+    EXPECT_TRUE(r.state);
+    EXPECT_TRUE(r.changed);
+
+    // Within the band the state holds
+    r = hysteresis.update(t0, 92.0, config);
+    EXPECT_TRUE(r.state);
+    EXPECT_FALSE(r.changed);
+
+    r = hysteresis.update(t0, 89.0, config);
+    EXPECT_FALSE(r.state);
+    EXPECT_TRUE(r.changed);
+}
+
+// Test inverted thresholds for low-side events
+TEST_F(HysteresisTest, InvertedThresholds) {
+    Hysteresis::Config config{10.0, 15.0, {}, {}};
+
+    EXPECT_FALSE(hysteresis.update(t0, 50.0, config).state);
+    EXPECT_TRUE(hysteresis.update(t0, 9.0, config).state);
+    EXPECT_TRUE(hysteresis.update(t0, 14.0, config).state);
+    EXPECT_FALSE(hysteresis.update(t0, 16.0, config).state);
+}
+
+// Test that transitions wait for the debounce time
+TEST_F(HysteresisTest, Debounce) {
+    Hysteresis::Config config{100.0, 90.0, 200ms, 50ms};
+
+    hysteresis.update(t0, 50.0, config);
+    auto r = hysteresis.update(t0 + 100ms, 120.0, config);
+    EXPECT_FALSE(r.state);
+    ASSERT_TRUE(r.wake_at.has_value());
+    EXPECT_EQ(*r.wake_at, t0 + 300ms);
+
+    // A dip restarts the debounce
+    EXPECT_FALSE(hysteresis.update(t0 + 200ms, 95.0, config).wake_at.has_value());
+    r = hysteresis.update(t0 + 250ms, 120.0, config);
+    EXPECT_EQ(*r.wake_at, t0 + 450ms);
+    r = hysteresis.update(t0 + 450ms, 120.0, config);
+    EXPECT_TRUE(r.state);
+    EXPECT_TRUE(r.changed);
+
+    // Release uses its own debounce
+    r = hysteresis.update(t0 + 500ms, 80.0, config);
+    EXPECT_EQ(*r.wake_at, t0 + 550ms);
+    EXPECT_FALSE(hysteresis.update(t0 + 550ms, 80.0, config).state);
+}
+
+// Test that invalid input holds the state and cancels pending transitions
+TEST_F(HysteresisTest, InvalidInputHolds) {
+    Hysteresis::Config config{100.0, 90.0, 100ms, 100ms};
+
+    hysteresis.update(t0, 120.0, config);
+    auto r = hysteresis.update(t0 + 50ms, std::nullopt, config);
+    EXPECT_FALSE(r.state);
+    EXPECT_FALSE(r.wake_at.has_value());
+
+    r = hysteresis.update(t0 + 100ms, 120.0, config);
+    EXPECT_FALSE(r.state);
+    EXPECT_EQ(*r.wake_at, t0 + 200ms);
+}
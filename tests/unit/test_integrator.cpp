@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "vssdag/integrator.h"
+
+using namespace vssdag;
+using namespace std::chrono_literals;
+
+class IntegratorTest : public ::testing::Test {
+protected:
+    Integrator integrator;
+    std::chrono::steady_clock::time_point t0{std::chrono::seconds(1000)};
+};
+
+// Test trapezoidal integration of a ramp
+TEST_F(IntegratorTest, TrapezoidalRule) {
+    EXPECT_DOUBLE_EQ(integrator.add(t0, 0), 0);
+    EXPECT_DOUBLE_EQ(integrator.add(t0 + 500ms, 10), 2.5);
+    EXPECT_DOUBLE_EQ(integrator.add(t0 + 1000ms, 10), 7.5);
+}
+
+// Test that long gaps and broken chains are not integrated
+TEST_F(IntegratorTest, GapHandling) {
+    integrator.add(t0, 10);
+    integrator.add(t0 + 100ms, 10);
+    EXPECT_DOUBLE_EQ(integrator.total(), 1);
+
+    // 5s without data: re-anchor only
+    integrator.add(t0 + 5100ms, 10);
+    EXPECT_DOUBLE_EQ(integrator.total(), 1);
+
+    // Invalid input in between
+    integrator.break_chain();
+    integrator.add(t0 + 5200ms, 10);
+    EXPECT_DOUBLE_EQ(integrator.total(), 1);
+    integrator.add(t0 + 5300ms, 10);
+    EXPECT_DOUBLE_EQ(integrator.total(), 2);
+
+    // Larger gap allowed explicitly
+    integrator.add(t0 + 8300ms, 10, 5s);
+    EXPECT_DOUBLE_EQ(integrator.total(), 32);
+}
+
+// Test reset and out-of-order samples
+TEST_F(IntegratorTest, ResetAndOutOfOrder) {
+    integrator.add(t0, 1);
+    integrator.add(t0 + 1s, 1);
+    integrator.add(t0 + 500ms, 100);  // Ignored
+    EXPECT_DOUBLE_EQ(integrator.total(), 1);
+
+    integrator.reset(42);
+    EXPECT_DOUBLE_EQ(integrator.total(), 42);
+    integrator.add(t0 + 2s, 1);  // Anchor only
+    integrator.add(t0 + 3s, 1);
+    EXPECT_DOUBLE_EQ(integrator.total(), 43);
+}
+
+// Test that compensated summation keeps small increments on a large total
+TEST_F(IntegratorTest, KeepsPrecisionOnLargeTotals) {
+    integrator.reset(1e9);
+    integrator.add(t0, 1e-7);
+    for (int i = 1; i <= 100000; ++i) {
+        integrator.add(t0 + i * 1ms, 1e-7);
+    }
+    // Each step adds 1e-10, far below the spacing of doubles near 1e9
+    EXPECT_NEAR(integrator.total() - 1e9, 1e-5, 1e-6);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "vssdag/lookup_table.h"
+
+using namespace vssdag;
+
+// Test 1D interpolation on a non-uniform axis
+TEST(LookupTableTest, Interpolates1D) {
+    LookupTableSpec spec;
+    spec.x = {0, 10, 50, 100};
+    spec.y = {0, 5, 25, 60};
+
+    auto table = LookupTable::compile("fuel", spec);
+    ASSERT_TRUE(table.has_value());
+    EXPECT_FALSE(table->is_2d());
+
+    EXPECT_DOUBLE_EQ(table->evaluate(5), 2.5);
+    EXPECT_DOUBLE_EQ(table->evaluate(30), 15);
+    EXPECT_DOUBLE_EQ(table->evaluate(100), 60);
+
+    // Clamped outside the table
+    EXPECT_DOUBLE_EQ(table->evaluate(-20), 0);
+    EXPECT_DOUBLE_EQ(table->evaluate(500), 60);
+}
+
+// Test that uniform axes are detected and give the same results
+TEST(LookupTableTest, UniformAxis) {
+    LookupAxis axis;
+    ASSERT_TRUE(axis.build({-40, -20, 0, 20, 40}));
+    EXPECT_TRUE(axis.is_uniform());
+
+    size_t index;
+    double fraction;
+    axis.locate(10, index, fraction);
+    EXPECT_EQ(index, 2);
+    EXPECT_DOUBLE_EQ(fraction, 0.5);
+
+    LookupAxis irregular;
+    ASSERT_TRUE(irregular.build({0, 1, 3}));
+    EXPECT_FALSE(irregular.is_uniform());
+    irregular.locate(2, index, fraction);
+    EXPECT_EQ(index, 1);
+    EXPECT_DOUBLE_EQ(fraction, 0.5);
+}
+
+// Test 2D bilinear interpolation
+TEST(LookupTableTest, Interpolates2D) {
+    LookupTableSpec spec;
+    spec.x = {0, 10};
+    spec.y = {0, 100, 200};
+    spec.z = {{0, 10},
+              {100, 110},
+              {300, 310}};
+
+    auto table = LookupTable::compile("map", spec);
+    ASSERT_TRUE(table.has_value());
+    EXPECT_TRUE(table->is_2d());
+
+    EXPECT_DOUBLE_EQ(table->evaluate(5, 0), 5);
+    EXPECT_DOUBLE_EQ(table->evaluate(5, 50), 55);
+    EXPECT_DOUBLE_EQ(table->evaluate(0, 150), 200);
+    EXPECT_DOUBLE_EQ(table->evaluate(20, 500), 310);
+}
+
+// Test that malformed tables are rejected
+TEST(LookupTableTest, RejectsMalformedTables) {
+    LookupTableSpec unsorted;
+    unsorted.x = {0, 10, 5};
+    unsorted.y = {1, 2, 3};
+    EXPECT_FALSE(LookupTable::compile("unsorted", unsorted).has_value());
+
+    LookupTableSpec mismatched;
+    mismatched.x = {0, 10};
+    mismatched.y = {1, 2, 3};
+    EXPECT_FALSE(LookupTable::compile("mismatched", mismatched).has_value());
+
+    LookupTableSpec ragged;
+    ragged.x = {0, 10};
+    ragged.y = {0, 1};
+    ragged.z = {{1, 2}, {3}};
+    EXPECT_FALSE(LookupTable::compile("ragged", ragged).has_value());
+}
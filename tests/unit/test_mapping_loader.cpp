@@ -0,0 +1,324 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "vssdag/mapping_loader.h"
+#include "vssdag/signal_processor.h"
+
+using namespace vssdag;
+
+namespace {
+
+const char* kMappings = R"(
+mappings:
+  - signal: Vehicle.Speed
+    source: {type: dbc, name: VehicleSpeed}
+    datatype: float
+    history: 4
+    priority: critical
+  - signal: Vehicle.Gear
+    source: {type: dbc, name: Gear}
+    datatype: string
+    transform:
+      mapping:
+        - {from: 1, to: P}
+        - {from: 2, to: D}
+  - signal: Vehicle.Derived
+    datatype: double
+    depends_on: [Vehicle.Speed]
+    interval_ms: 100
+    update_trigger: both
+    join: {policy: wait_all, tolerance_ms: 20}
+    lookup_tables:
+      gain: {x: [0, 100], y: [1, 2]}
+    transform:
+      code: lookup('gain', deps['Vehicle.Speed']) * 2
+execution_budget:
+  node_instructions: 5000
+batch_deadline_us: 250
+pipeline: {evaluate_cpu: 2, max_batch: 64, frame_capacity: 1024}
+resample:
+  - name: grid
+    period_ms: 50
+    signals:
+      - {signal: Vehicle.Speed, method: linear}
+)";
+
+std::string temp_path(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+} // namespace
+
+TEST(MappingLoaderTest, LoadsYaml) {
+    MappingConfig config;
+    ASSERT_TRUE(load_mapping_yaml(kMappings, config));
+    ASSERT_EQ(config.mappings.size(), 3u);
+
+    const auto& speed = config.mappings.at("Vehicle.Speed");
+    EXPECT_EQ(speed.source.name, "VehicleSpeed");
+    EXPECT_EQ(speed.history_size, 4);
+    EXPECT_EQ(speed.priority, Priority::CRITICAL);
+
+    const auto& derived = config.mappings.at("Vehicle.Derived");
+    EXPECT_EQ(derived.update_trigger, UpdateTrigger::BOTH);
+    EXPECT_EQ(derived.join_policy, JoinPolicy::WAIT_ALL);
+    EXPECT_EQ(derived.join_tolerance_ms, 20);
+    EXPECT_EQ(derived.lookup_tables.count("gain"), 1u);
+    EXPECT_TRUE(std::holds_alternative<CodeTransform>(derived.transform));
+
+    EXPECT_EQ(config.execution_budget.node_instructions, 5000u);
+    ASSERT_TRUE(config.batch_deadline.has_value());
+    EXPECT_EQ(config.batch_deadline->count(), 250);
+    ASSERT_EQ(config.resample_groups.size(), 1u);
+    EXPECT_EQ(config.resample_groups[0].columns[0].method, ResampleMethod::LINEAR);
+    ASSERT_TRUE(config.pipeline.has_value());
+    EXPECT_EQ(config.pipeline->evaluate_cpu, 2);
+    EXPECT_EQ(config.pipeline->update_capacity, PipelineConfig().update_capacity);
+
+    ASSERT_TRUE(load_mapping_yaml(R"(
+mappings:
+  - {signal: Vehicle.Speed, source: {type: dbc, name: VehicleSpeed}}
+pipeline: {enabled: false, decode_cpu: 1}
+)", config));
+    EXPECT_FALSE(config.pipeline.has_value());
+}
+
+TEST(MappingLoaderTest, RejectsInvalidMappings) {
+    MappingConfig config;
+    EXPECT_FALSE(load_mapping_yaml("other: 1", config));
+    EXPECT_FALSE(load_mapping_yaml(R"(
+mappings:
+  - {signal: A, datatype: float, priority: urgent}
+)", config));
+    EXPECT_FALSE(load_mapping_yaml(R"(
+mappings:
+  - {signal: A, datatype: float, depends_on: [Missing]}
+)", config));
+    EXPECT_FALSE(load_mapping_yaml(R"(
+mappings:
+  - {signal: A, datatype: float}
+  - {signal: A, datatype: float}
+)", config));
+    EXPECT_FALSE(load_mapping_yaml(R"(
+mappings:
+  - signal: A
+    datatype: float
+    lookup_tables:
+      bad: {x: [2, 1], y: [0, 1]}
+)", config));
+    EXPECT_TRUE(config.mappings.empty());  // Left untouched on failure
+}
+
+TEST(MappingLoaderTest, ExpandsTemplates) {
+    MappingConfig config;
+    ASSERT_TRUE(load_mapping_yaml(R"(
+mappings:
+  - signal: Cell{n}.Raw
+    for: n in 1..3
+    source: {type: dbc, name: "Cell{n}_Voltage"}
+    datatype: float
+    transform:
+      code: x * n
+  - signal: Cell{n}.Filtered
+    for: n in 1..3
+    datatype: float
+    depends_on: ["Cell{n}.Raw"]
+    transform:
+      code: deps['Cell' .. n .. '.Raw']
+)", config));
+    ASSERT_EQ(config.mappings.size(), 6u);
+
+    const auto& raw2 = config.mappings.at("Cell2.Raw");
+    EXPECT_EQ(raw2.source.name, "Cell2_Voltage");
+    EXPECT_EQ(raw2.template_index, 2);
+    ASSERT_NE(raw2.instance_of, nullptr);
+    EXPECT_EQ(raw2.instance_of->variable, "n");
+    EXPECT_EQ(std::get<CodeTransform>(raw2.effective_transform()).expression, "x * n");
+    EXPECT_EQ(raw2.instance_of, config.mappings.at("Cell3.Raw").instance_of);  // Shared
+    EXPECT_EQ(config.mappings.at("Cell3.Filtered").depends_on,
+              std::vector<std::string>{"Cell3.Raw"});
+
+    EXPECT_FALSE(load_mapping_yaml(R"(
+mappings:
+  - {signal: Cell.Raw, for: n in 1..3, datatype: float}
+)", config));
+    EXPECT_FALSE(load_mapping_yaml(R"(
+mappings:
+  - {signal: "Cell{n}", for: n from 1 to 3, datatype: float}
+)", config));
+}
+
+TEST(MappingLoaderTest, CompiledRoundTrip) {
+    MappingConfig config;
+    ASSERT_TRUE(load_mapping_yaml(kMappings, config));
+
+    std::string path = temp_path("mappings.vssdagc");
+    ASSERT_TRUE(save_compiled_mappings(config, path));
+    EXPECT_TRUE(is_compiled_mapping_file(path));
+
+    MappingConfig loaded;
+    ASSERT_TRUE(load_compiled_mappings(path, loaded));
+    ASSERT_EQ(loaded.mappings.size(), 3u);
+
+    const auto& derived = loaded.mappings.at("Vehicle.Derived");
+    EXPECT_EQ(derived.depends_on, std::vector<std::string>{"Vehicle.Speed"});
+    EXPECT_EQ(derived.interval_ms, 100);
+    EXPECT_EQ(derived.join_policy, JoinPolicy::WAIT_ALL);
+    EXPECT_EQ(derived.lookup_tables.at("gain").y, (std::vector<double>{1, 2}));
+    EXPECT_EQ(std::get<CodeTransform>(derived.transform).expression,
+              std::get<CodeTransform>(config.mappings.at("Vehicle.Derived").transform).expression);
+    EXPECT_EQ(std::get<ValueMapping>(loaded.mappings.at("Vehicle.Gear").transform).mappings.at("2"), "D");
+    EXPECT_EQ(loaded.mappings.at("Vehicle.Speed").priority, Priority::CRITICAL);
+
+    EXPECT_EQ(loaded.execution_budget.node_instructions, 5000u);
+    EXPECT_EQ(loaded.batch_deadline, config.batch_deadline);
+    EXPECT_EQ(loaded.resample_groups[0].period_ms, 50);
+    ASSERT_TRUE(loaded.pipeline.has_value());
+    EXPECT_EQ(loaded.pipeline->evaluate_cpu, 2);
+    EXPECT_EQ(loaded.pipeline->decode_cpu, -1);
+    EXPECT_EQ(loaded.pipeline->max_batch, 64u);
+    EXPECT_EQ(loaded.pipeline_frame_capacity, 1024u);
+    std::remove(path.c_str());
+
+    // Template instances keep sharing one transform
+    ASSERT_TRUE(load_mapping_yaml(R"(
+mappings:
+  - {signal: "Cell{i}", for: i in 1..4, source: {type: dbc, name: "C{i}"}, transform: {code: x * i}}
+)", config));
+    ASSERT_TRUE(save_compiled_mappings(config, path));
+    ASSERT_TRUE(load_compiled_mappings(path, loaded));
+    ASSERT_EQ(loaded.mappings.size(), 4u);
+    ASSERT_NE(loaded.mappings.at("Cell1").instance_of, nullptr);
+    EXPECT_EQ(loaded.mappings.at("Cell1").instance_of, loaded.mappings.at("Cell4").instance_of);
+    EXPECT_EQ(loaded.mappings.at("Cell4").template_index, 4);
+    EXPECT_EQ(loaded.mappings.at("Cell4").source.name, "C4");
+    EXPECT_FALSE(loaded.pipeline.has_value());
+    std::remove(path.c_str());
+}
+
+// The compiled plan survives the artifact and stands in for the DAG sort and
+// Lua compilation at initialize()
+TEST(MappingLoaderTest, CompiledPlan) {
+    MappingConfig config;
+    ASSERT_TRUE(load_mapping_yaml(R"(
+mappings:
+  - {signal: Vehicle.Gear, source: {type: dbc, name: Gear}, datatype: boolean,
+     transform: {code: "x == signal_enums['Vehicle.Gear'].D"}}
+  - {signal: "Cell{i}", for: i in 1..2, source: {type: dbc, name: "C{i}"}, datatype: double,
+     transform: {code: x * i}}
+  - {signal: Pack, depends_on: [Cell1, Cell2], datatype: double,
+     transform: {code: "deps['Cell1'] + deps['Cell2']"}}
+)", config));
+    CompiledPlan plan;
+    SignalProcessorDAG compiler;
+    ASSERT_TRUE(compiler.compile_plan(config.mappings, plan));
+    EXPECT_EQ(plan.processing_order.size(), 4u);
+    EXPECT_EQ(plan.priority_order.size(), 4u);
+    EXPECT_EQ(plan.transform_chunks.size(), 2u);  // The cells share their template's
+    EXPECT_EQ(plan.template_chunks.count("Cell{i}"), 1u);
+    plan.decode_plan[0x101] = {"C1", "C2"};
+    plan.enum_tables["Vehicle.Gear"] = {{"P", 1}, {"D", 2}};
+    config.plan = plan;
+
+    std::string path = temp_path("plan.vssdagc");
+    ASSERT_TRUE(save_compiled_mappings(config, path));
+    MappingConfig loaded;
+    ASSERT_TRUE(load_compiled_mappings(path, loaded));
+    std::remove(path.c_str());
+    ASSERT_TRUE(loaded.plan.has_value());
+    EXPECT_EQ(loaded.plan->processing_order, plan.processing_order);
+    EXPECT_EQ(loaded.plan->priority_order, plan.priority_order);
+    EXPECT_EQ(loaded.plan->decode_plan, plan.decode_plan);
+    EXPECT_EQ(loaded.plan->enum_tables, plan.enum_tables);
+    EXPECT_EQ(loaded.plan->transform_chunks, plan.transform_chunks);
+    EXPECT_EQ(loaded.plan->template_chunks, plan.template_chunks);
+
+    // Transforms are loaded from the bytecode, so their source is not compiled again
+    auto broken = loaded.mappings;
+    std::get<CodeTransform>(broken.at("Pack").transform).expression = "deps[";
+    SignalProcessorDAG from_source;
+    EXPECT_FALSE(from_source.initialize(broken));
+    SignalProcessorDAG processor;
+    ASSERT_TRUE(processor.initialize(std::move(broken), *loaded.plan));
+
+    auto now = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, Value> values;
+    for (const auto& signal : processor.process_signal_updates({
+             SignalUpdate{Symbol("Vehicle.Gear"), int64_t{2}, now},
+             SignalUpdate{Symbol("Cell1"), 1.5, now},
+             SignalUpdate{Symbol("Cell2"), 2.0, now}})) {
+        values[signal.path.str()] = signal.qualified_value.value;
+    }
+    EXPECT_EQ(std::get<bool>(values.at("Vehicle.Gear")), true);
+    EXPECT_DOUBLE_EQ(std::get<double>(values.at("Cell2")), 4.0);
+    EXPECT_DOUBLE_EQ(std::get<double>(values.at("Pack")), 5.5);
+
+    // Chunks must be bytecode
+    CompiledPlan text = *loaded.plan;
+    text.transform_chunks["Pack"] = "return 1";
+    SignalProcessorDAG rejecting;
+    EXPECT_FALSE(rejecting.initialize(loaded.mappings, text));
+}
+
+TEST(MappingLoaderTest, RejectsCorruptArtifact) {
+    MappingConfig config;
+    ASSERT_TRUE(load_mapping_yaml(kMappings, config));
+    std::string path = temp_path("truncated.vssdagc");
+    ASSERT_TRUE(save_compiled_mappings(config, path));
+
+    // Truncate the artifact halfway through
+    std::ifstream in(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(), data.size() / 2);
+
+    MappingConfig loaded;
+    EXPECT_FALSE(load_compiled_mappings(path, loaded));
+    EXPECT_TRUE(loaded.mappings.empty());
+
+    std::ofstream(path, std::ios::trunc) << "mappings: []\n";
+    EXPECT_FALSE(is_compiled_mapping_file(path));
+    EXPECT_FALSE(load_compiled_mappings(path, loaded));
+    std::remove(path.c_str());
+}
+
+TEST(MappingLoaderTest, RejectsInvalidArtifactContents) {
+    MappingConfig config;
+    ASSERT_TRUE(load_mapping_yaml(R"(
+mappings:
+  - {signal: Vehicle.Speed, source: {type: dbc, name: VehicleSpeed}, datatype: double, priority: critical}
+)", config));
+    std::string path = temp_path("invalid.vssdagc");
+    MappingConfig loaded;
+
+    ASSERT_TRUE(save_compiled_mappings(config, path));
+    std::ifstream in(path, std::ios::binary);
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    auto load_patched = [&](size_t offset, char tag) {
+        std::string patched = data;
+        patched[offset] = tag;
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(patched.data(), patched.size());
+        return load_compiled_mappings(path, loaded);
+    };
+
+    // Unknown enum tags: the datatype follows the signal name, the priority
+    // the source name, the (empty) dependency count and the trigger
+    auto name = data.find("Vehicle.Speed");
+    auto source = data.find("VehicleSpeed");
+    ASSERT_NE(name, std::string::npos);
+    ASSERT_NE(source, std::string::npos);
+    size_t priority = source + 12 + 4 + 1;
+    ASSERT_EQ(data[priority], static_cast<char>(Priority::CRITICAL));
+    EXPECT_TRUE(load_patched(priority, static_cast<char>(Priority::LOW)));
+    EXPECT_FALSE(load_patched(priority, 9));
+    EXPECT_FALSE(load_patched(name + 13, 0x7f));
+
+    // Cross-mapping checks run on artifacts too
+    config.mappings["Vehicle.Derived"].depends_on = {"Vehicle.Missing"};
+    ASSERT_TRUE(save_compiled_mappings(config, path));
+    MappingConfig unchanged;
+    EXPECT_FALSE(load_compiled_mappings(path, unchanged));
+    EXPECT_TRUE(unchanged.mappings.empty());
+    std::remove(path.c_str());
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include "vssdag/pipeline.h"
+
+using namespace vssdag;
+
+namespace {
+
+// Source handing out a fixed number of speed updates
+class CountingSource : public ISignalSource {
+public:
+    explicit CountingSource(int count) : remaining_(count) {}
+
+    bool initialize() override { return true; }
+
+    std::vector<SignalUpdate> poll() override {
+        std::vector<SignalUpdate> updates;
+        for (int i = 0; i < 10 && remaining_ > 0; ++i, --remaining_) {
+            SignalUpdate update;
+            update.signal_name = "Vehicle.Speed";
+            update.value = static_cast<double>(remaining_);
+            update.timestamp = std::chrono::steady_clock::now();
+            updates.push_back(update);
+        }
+        return updates;
+    }
+
+    std::vector<std::string> get_exported_signals() const override { return {"Vehicle.Speed"}; }
+
+private:
+    int remaining_;
+};
+
+template <typename Predicate>
+bool wait_until(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+class PipelineTest : public ::testing::Test {
+protected:
+    SignalProcessorDAG processor;
+
+    void SetUp() override {
+        std::unordered_map<std::string, SignalMapping> mappings;
+        SignalMapping speed_mapping;
+        speed_mapping.source.type = "dbc";
+        speed_mapping.source.name = "VehicleSpeed";
+        speed_mapping.datatype = ValueType::DOUBLE;
+        mappings["Vehicle.Speed"] = speed_mapping;
+
+        SignalMapping kmh_mapping;
+        kmh_mapping.depends_on = {"Vehicle.Speed"};
+        kmh_mapping.datatype = ValueType::DOUBLE;
+        kmh_mapping.transform = CodeTransform{"deps['Vehicle.Speed'] * 3.6"};
+        mappings["Vehicle.SpeedKmh"] = kmh_mapping;
+
+        ASSERT_TRUE(processor.initialize(mappings));
+    }
+};
+
+// Test that updates flow through all three stages to the sink
+TEST_F(PipelineTest, DeliversOutputs) {
+    CountingSource source(500);
+    std::mutex mutex;
+    size_t kmh_outputs = 0;
+    double last_kmh = 0.0;
+
+    Pipeline pipeline(source, processor, [&](const VSSSignal& signal) {
+        if (signal.path == "Vehicle.SpeedKmh") {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++kmh_outputs;
+            last_kmh = std::get<double>(signal.qualified_value.value);
+        }
+    });
+    pipeline.start();
+
+    // Updates of one batch are coalesced, the last one (speed 1) always comes through
+    ASSERT_TRUE(wait_until([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return last_kmh == 3.6;
+    }));
+    pipeline.stop();
+
+    auto stats = pipeline.stats();
+    EXPECT_EQ(stats.updates, 500u);
+    EXPECT_EQ(stats.outputs_dropped, 0u);
+    EXPECT_GE(stats.outputs, stats.batches);
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GT(kmh_outputs, 0u);
+}
+
+// Test that a slow sink drops outputs instead of stalling evaluation
+TEST_F(PipelineTest, SlowSinkDoesNotBlockEvaluation) {
+    CountingSource source(2000);
+    PipelineConfig config;
+    config.output_capacity = 4;
+
+    Pipeline pipeline(source, processor, [](const VSSSignal&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }, config);
+    pipeline.start();
+
+    // All updates are evaluated long before the sink could consume 4000 outputs
+    ASSERT_TRUE(wait_until([&] { return pipeline.stats().updates == 2000; }));
+    pipeline.stop();
+    EXPECT_GT(pipeline.stats().outputs_dropped, 0u);
+}
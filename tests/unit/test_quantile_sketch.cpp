@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "vssdag/quantile_sketch.h"
+
+using namespace vssdag;
+
+// Test that quantiles stay within the relative accuracy
+TEST(QuantileSketchTest, RelativeAccuracy) {
+    QuantileSketch sketch(0.01);
+    for (int i = 1; i <= 10000; ++i) {
+        sketch.add(i);
+    }
+
+    EXPECT_EQ(sketch.count(), 10000u);
+    EXPECT_DOUBLE_EQ(*sketch.quantile(0.0), 1.0);
+    EXPECT_DOUBLE_EQ(*sketch.quantile(1.0), 10000.0);
+    for (double q : {0.5, 0.95, 0.99}) {
+        double expected = 1.0 + q * 9999.0;
+        EXPECT_NEAR(*sketch.quantile(q), expected, expected * 0.011) << "q=" << q;
+    }
+}
+
+// Test negative, zero and positive values together
+TEST(QuantileSketchTest, MixedSigns) {
+    QuantileSketch sketch;
+    for (int i = -50; i <= 50; ++i) {
+        sketch.add(i);
+    }
+    EXPECT_NEAR(*sketch.quantile(0.5), 0.0, 1e-9);
+    EXPECT_NEAR(*sketch.quantile(0.25), -25.0, 0.25);
+    EXPECT_NEAR(*sketch.quantile(0.75), 25.0, 0.25);
+    EXPECT_DOUBLE_EQ(sketch.min(), -50.0);
+    EXPECT_FALSE(QuantileSketch().quantile(0.5).has_value());
+}
+
+// Test that merging equals sketching the combined stream
+TEST(QuantileSketchTest, MergeMatchesCombinedStream) {
+    QuantileSketch a, b, combined;
+    for (int i = 0; i < 1000; ++i) {
+        a.add(20.0 + i * 0.01);
+        b.add(80.0 + i * 0.02);
+        combined.add(20.0 + i * 0.01);
+        combined.add(80.0 + i * 0.02);
+    }
+    ASSERT_TRUE(a.merge(b));
+    EXPECT_EQ(a.count(), combined.count());
+    for (double q : {0.1, 0.5, 0.9, 0.99}) {
+        EXPECT_DOUBLE_EQ(*a.quantile(q), *combined.quantile(q));
+    }
+    EXPECT_FALSE(a.merge(QuantileSketch(0.05)));
+}
+
+// Test serialization round trip
+TEST(QuantileSketchTest, SerializeRoundTrip) {
+    QuantileSketch sketch(0.02);
+    for (int i = 0; i < 500; ++i) {
+        sketch.add(std::sin(i) * 100.0);
+    }
+
+    auto restored = QuantileSketch::deserialize(sketch.serialize());
+    ASSERT_TRUE(restored.has_value());
+    EXPECT_EQ(restored->count(), sketch.count());
+    EXPECT_DOUBLE_EQ(restored->sum(), sketch.sum());
+    for (double q : {0.05, 0.5, 0.95}) {
+        EXPECT_DOUBLE_EQ(*restored->quantile(q), *sketch.quantile(q));
+    }
+
+    EXPECT_FALSE(QuantileSketch::deserialize("").has_value());
+    EXPECT_FALSE(QuantileSketch::deserialize("ddsketch1 0.01 2048 3").has_value());
+}
+
+// Test that memory stays bounded and high quantiles keep their accuracy
+TEST(QuantileSketchTest, BoundedBins) {
+    QuantileSketch sketch(0.01, 64);
+    for (int i = 0; i < 100000; ++i) {
+        sketch.add(std::pow(10.0, (i % 1000) / 100.0));  // 1 .. 1e10
+    }
+    double p99 = *sketch.quantile(0.99);
+    EXPECT_GE(p99, std::pow(10.0, 9.89) * 0.99);
+    EXPECT_LE(p99, std::pow(10.0, 9.90) * 1.01);
+    EXPECT_LE(sketch.serialize().size(), 64u * 2 * 8 + 200);
+}
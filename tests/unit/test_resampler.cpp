@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "vssdag/resampler.h"
+
+using namespace vssdag;
+using namespace std::chrono_literals;
+
+class ResamplerTest : public ::testing::Test {
+protected:
+    std::chrono::steady_clock::time_point t0{std::chrono::seconds(1000)};
+    std::vector<std::vector<double>> rows;
+    std::vector<std::chrono::steady_clock::time_point> ticks;
+
+    Resampler::RowHandler collect() {
+        return [this](const ResampleGroup&, std::chrono::steady_clock::time_point tick,
+                      const std::vector<double>& row) {
+            ticks.push_back(tick);
+            rows.push_back(row);
+        };
+    }
+
+    static ResampleGroup make_group(ResampleMethod method, int delay_ms = 0) {
+        ResampleGroup group;
+        group.name = "test";
+        group.period_ms = 100;
+        group.delay_ms = delay_ms;
+        group.columns = {{"A", method}};
+        return group;
+    }
+};
+
+// Test that ticks are aligned to the grid and missing columns are NaN
+TEST_F(ResamplerTest, AlignedTicksAndMissingValues) {
+    Resampler resampler(make_group(ResampleMethod::HOLD), t0 + 30ms);
+    EXPECT_EQ(resampler.next_emit(), t0 + 100ms);
+
+    EXPECT_EQ(resampler.advance(t0 + 250ms, collect()), 2u);
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0], t0 + 100ms);
+    EXPECT_EQ(ticks[1], t0 + 200ms);
+    EXPECT_TRUE(std::isnan(rows[0][0]));
+}
+
+// Test hold-last sampling
+TEST_F(ResamplerTest, HoldLast) {
+    Resampler resampler(make_group(ResampleMethod::HOLD), t0);
+    resampler.record(0, t0 + 10ms, 1.0);
+    resampler.record(0, t0 + 90ms, 2.0);
+    resampler.record(0, t0 + 150ms, 3.0);
+
+    resampler.advance(t0 + 300ms, collect());
+    ASSERT_EQ(rows.size(), 4u);  // t0, +100, +200, +300
+    EXPECT_TRUE(std::isnan(rows[0][0]));
+    EXPECT_DOUBLE_EQ(rows[1][0], 2.0);
+    EXPECT_DOUBLE_EQ(rows[2][0], 3.0);
+    EXPECT_DOUBLE_EQ(rows[3][0], 3.0);
+}
+
+// Test linear interpolation with an emission delay
+TEST_F(ResamplerTest, LinearWithDelay) {
+    Resampler resampler(make_group(ResampleMethod::LINEAR, 50), t0 + 1ms);
+    resampler.record(0, t0 + 50ms, 0.0);
+    resampler.record(0, t0 + 150ms, 10.0);
+
+    EXPECT_EQ(resampler.advance(t0 + 140ms, collect()), 0u);  // Tick +100 due at +150
+    EXPECT_EQ(resampler.advance(t0 + 150ms, collect()), 1u);
+    EXPECT_DOUBLE_EQ(rows[0][0], 5.0);
+
+    // No sample after +200 yet: hold
+    resampler.advance(t0 + 250ms, collect());
+    EXPECT_DOUBLE_EQ(rows[1][0], 10.0);
+}
+
+// Test window mean over the samples since the previous tick
+TEST_F(ResamplerTest, WindowMean) {
+    Resampler resampler(make_group(ResampleMethod::MEAN), t0 + 1ms);
+    resampler.record(0, t0 + 10ms, 1.0);
+    resampler.record(0, t0 + 20ms, 2.0);
+    resampler.record(0, t0 + 30ms, std::nan(""));  // Invalid, skipped
+    resampler.record(0, t0 + 100ms, 6.0);
+
+    resampler.advance(t0 + 200ms, collect());
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_DOUBLE_EQ(rows[0][0], 3.0);
+    EXPECT_DOUBLE_EQ(rows[1][0], 6.0);  // No samples: hold
+}
+
+// Test that the row buffer is reused across ticks
+TEST_F(ResamplerTest, ReusesRowBuffer) {
+    Resampler resampler(make_group(ResampleMethod::HOLD), t0);
+    const double* data = resampler.row().data();
+    for (int i = 0; i < 100; ++i) {
+        resampler.record(0, t0 + std::chrono::milliseconds(i * 10), i);
+        resampler.advance(t0 + std::chrono::milliseconds(i * 10), nullptr);
+    }
+    EXPECT_EQ(resampler.row().data(), data);
+    EXPECT_DOUBLE_EQ(resampler.row()[0], 90.0);
+}
@@ -224,4 +224,101 @@ TEST_F(SignalDAGTest, ComplexDAGMultiplePaths) {
     EXPECT_LT(a_idx, c_idx);
     EXPECT_LT(b_idx, d_idx);
     EXPECT_LT(c_idx, d_idx);
-}
\ No newline at end of file
+}
+
+// Test that dependencies inherit the priority of their dependents
+TEST_F(SignalDAGTest, PriorityInheritance) {
+    SignalMapping input;
+    input.source.type = "dbc";
+    input.source.name = "Raw";
+    mappings["Input"] = input;
+
+    SignalMapping low;
+    low.source.type = "dbc";
+    low.source.name = "Other";
+    low.priority = Priority::LOW;
+    mappings["Low"] = low;
+
+    SignalMapping critical;
+    critical.depends_on = {"Input"};
+    critical.priority = Priority::CRITICAL;
+    mappings["Critical"] = critical;
+
+    ASSERT_TRUE(dag.build(mappings));
+    EXPECT_EQ(dag.get_node("Input")->priority, Priority::CRITICAL);
+
+    const auto& order = dag.get_priority_order();
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0]->signal_name, "Input");
+    EXPECT_EQ(order[1]->signal_name, "Critical");
+    EXPECT_EQ(order[2]->signal_name, "Low");
+}
+
+// Nodes reference the shared mapping set instead of copying it
+TEST_F(SignalDAGTest, SharedMappingSet) {
+    SignalMapping input;
+    input.source.type = "dbc";
+    input.source.name = "Raw";
+    mappings["Input"] = input;
+
+    SignalMapping derived;
+    derived.depends_on = {"Input"};
+    mappings["Derived"] = derived;
+
+    auto shared = std::make_shared<const MappingSet>(mappings);
+    ASSERT_TRUE(dag.build(shared));
+    EXPECT_EQ(dag.get_mappings(), shared);
+
+    const auto* node = dag.get_node("Derived");
+    ASSERT_NE(node, nullptr);
+    EXPECT_EQ(&node->mapping, &shared->at("Derived"));
+    EXPECT_EQ(&node->depends_on, &shared->at("Derived").depends_on);
+    EXPECT_GT(dag.memory_bytes(), 0u);
+}
+
+// A compiled plan supplies both orders; inconsistent plans are rejected
+TEST_F(SignalDAGTest, BuildsFromCompiledPlan) {
+    SignalMapping input;
+    input.source.type = "dbc";
+    input.source.name = "Raw";
+    mappings["Input"] = input;
+
+    SignalMapping low;
+    low.source.type = "dbc";
+    low.source.name = "Other";
+    low.priority = Priority::LOW;
+    mappings["Low"] = low;
+
+    SignalMapping critical;
+    critical.depends_on = {"Input"};
+    critical.priority = Priority::CRITICAL;
+    mappings["Critical"] = critical;
+
+    auto shared = std::make_shared<const MappingSet>(mappings);
+    CompiledPlan plan;
+    plan.processing_order = {"Low", "Input", "Critical"};
+    plan.priority_order = {1, 2, 0};
+    ASSERT_TRUE(dag.build(shared, plan));
+    EXPECT_EQ(dag.get_processing_order()[0]->signal_name, "Low");
+    EXPECT_EQ(dag.get_priority_order()[0]->signal_name, "Input");
+    EXPECT_EQ(dag.get_priority_order()[2]->signal_name, "Low");
+    EXPECT_EQ(dag.get_node("Input")->priority, Priority::CRITICAL);
+
+    // Dependency after its dependent, in either order
+    plan.priority_order = {2, 1, 0};
+    EXPECT_FALSE(dag.build(shared, plan));
+    plan.processing_order = {"Critical", "Input", "Low"};
+    plan.priority_order = {1, 0, 2};
+    EXPECT_FALSE(dag.build(shared, plan));
+
+    // Unknown, repeated or missing signals
+    plan.processing_order = {"Input", "Critical", "Other"};
+    EXPECT_FALSE(dag.build(shared, plan));
+    plan.processing_order = {"Input", "Input", "Critical"};
+    EXPECT_FALSE(dag.build(shared, plan));
+    plan.processing_order = {"Input", "Critical"};
+    EXPECT_FALSE(dag.build(shared, plan));
+    plan.processing_order = {"Input", "Critical", "Low"};
+    plan.priority_order = {0, 1, 3};
+    EXPECT_FALSE(dag.build(shared, plan));
+}
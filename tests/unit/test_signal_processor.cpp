@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "vssdag/signal_processor.h"
 #include "vssdag/mapping_types.h"
+#include <cstdio>
+#include <fstream>
+#include <map>
 
 using namespace vssdag;
 
@@ -612,4 +615,1097 @@ TEST_F(SignalProcessorTest, LowpassWithInvalidSignals) {
     vss_signals = processor->process_signal_updates(updates);
     EXPECT_EQ(vss_signals.size(), 1);
     EXPECT_EQ(vss_signals[0].qualified_value.quality, vss::types::SignalQuality::VALID);
-}
\ No newline at end of file
+}
+
+// Test that a simulated clock drives time-based helpers from input timestamps
+TEST_F(SignalProcessorTest, SimulatedClockDrivesTimeHelpers) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping temp_mapping;
+    temp_mapping.source.type = "dbc";
+    temp_mapping.source.name = "CoolantTemp";
+    temp_mapping.datatype = ValueType::DOUBLE;
+    mappings["Engine.Temperature"] = temp_mapping;
+
+    SignalMapping overheat_mapping;
+    overheat_mapping.depends_on.push_back("Engine.Temperature");
+    overheat_mapping.datatype = ValueType::BOOL;
+    overheat_mapping.transform = CodeTransform{
+        "sustained_condition(deps['Engine.Temperature'] > 100, 500)"};
+    mappings["Engine.Overheat"] = overheat_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    auto overheat_at = [&](std::chrono::milliseconds offset) -> std::optional<bool> {
+        SignalUpdate update = MakeUpdate("Engine.Temperature", 120.0);
+        update.timestamp = t0 + offset;
+        auto vss_signals = processor->process_signal_updates({update});
+        for (const auto& s : vss_signals) {
+            if (s.path == "Engine.Overheat") {
+                if (auto* b = std::get_if<bool>(&s.qualified_value.value)) return *b;
+            }
+        }
+        return std::nullopt;
+    };
+
+    // Replay runs at full speed, but the condition only holds after 500ms of input time
+    EXPECT_EQ(overheat_at(std::chrono::milliseconds(0)), false);
+    EXPECT_EQ(overheat_at(std::chrono::milliseconds(200)), false);
+    EXPECT_EQ(overheat_at(std::chrono::milliseconds(600)), true);
+    EXPECT_EQ(clock->now(), t0 + std::chrono::milliseconds(600));
+}
+
+// Test that output timestamps come from the injected clock
+TEST_F(SignalProcessorTest, SimulatedClockStampsOutputs) {
+    auto wall_origin = std::chrono::system_clock::time_point(std::chrono::hours(24 * 365 * 50));
+    auto clock = std::make_shared<SimulatedClock>(wall_origin);
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    SignalUpdate update = MakeUpdate("Vehicle.Speed", 10.0);
+    update.timestamp = std::chrono::steady_clock::time_point(std::chrono::seconds(5));
+    auto vss_signals = processor->process_signal_updates({update});
+    ASSERT_EQ(vss_signals.size(), 1);
+    EXPECT_EQ(vss_signals[0].qualified_value.timestamp, wall_origin + std::chrono::seconds(5));
+}
+
+// Test that delayed() wakes its node exactly once, when the delay is due
+TEST_F(SignalProcessorTest, DelayedWakesOnceWhenDue) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping target_mapping;
+    target_mapping.source.type = "dbc";
+    target_mapping.source.name = "LockTarget";
+    target_mapping.datatype = ValueType::BOOL;
+    mappings["Door.IsLocked.Target"] = target_mapping;
+
+    SignalMapping locked_mapping;
+    locked_mapping.depends_on.push_back("Door.IsLocked.Target");
+    locked_mapping.datatype = ValueType::BOOL;
+    locked_mapping.transform = CodeTransform{"delayed(deps['Door.IsLocked.Target'], 200)"};
+    mappings["Door.IsLocked"] = locked_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+    EXPECT_FALSE(processor->next_wakeup().has_value());
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    SignalUpdate update = MakeUpdate("Door.IsLocked.Target", true);
+    update.timestamp = t0;
+    processor->process_signal_updates({update});
+
+    // The caller's run loop learns when to come back
+    ASSERT_TRUE(processor->next_wakeup().has_value());
+    EXPECT_EQ(*processor->next_wakeup(), t0 + std::chrono::milliseconds(200));
+
+    // Not due yet: nothing is re-evaluated
+    clock->advance_to(t0 + std::chrono::milliseconds(100));
+    EXPECT_TRUE(processor->process_signal_updates({}).empty());
+
+    // Due: the delayed value is published once
+    clock->advance_to(t0 + std::chrono::milliseconds(200));
+    auto vss_signals = processor->process_signal_updates({});
+    ASSERT_EQ(vss_signals.size(), 1);
+    EXPECT_EQ(vss_signals[0].path, "Door.IsLocked");
+    EXPECT_TRUE(vss_signals[0].qualified_value.is_valid());
+    EXPECT_EQ(std::get<bool>(vss_signals[0].qualified_value.value), true);
+
+    // No further wakeups
+    EXPECT_FALSE(processor->next_wakeup().has_value());
+    clock->advance_to(t0 + std::chrono::milliseconds(500));
+    EXPECT_TRUE(processor->process_signal_updates({}).empty());
+}
+
+// Test that a timer wakeup publishes only values that changed
+TEST_F(SignalProcessorTest, TimerWakeupSkipsUnchangedValue) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping input_mapping;
+    input_mapping.source.type = "dbc";
+    input_mapping.source.name = "Input";
+    input_mapping.datatype = ValueType::DOUBLE;
+    mappings["Input"] = input_mapping;
+
+    // Re-checks itself every 100 ms; the value changes only on the third wakeup
+    SignalMapping poll_mapping;
+    poll_mapping.depends_on = {"Input"};
+    poll_mapping.datatype = ValueType::DOUBLE;
+    poll_mapping.transform = CodeTransform{R"(
+local state = get_state()
+state.wakeups = (state.wakeups or -1) + 1
+schedule_in(100)
+if state.wakeups >= 3 then return deps['Input'] + 1 end
+return deps['Input']
+)"};
+    mappings["Poll"] = poll_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    SignalUpdate update = MakeUpdate("Input", 5.0);
+    update.timestamp = t0;
+    auto poll_values = [&](std::vector<VSSSignal> signals) {
+        std::vector<double> values;
+        for (const auto& s : signals) {
+            if (s.path == "Poll") values.push_back(std::get<double>(s.qualified_value.value));
+        }
+        return values;
+    };
+    EXPECT_EQ(poll_values(processor->process_signal_updates({update})), std::vector<double>{5.0});
+    EXPECT_EQ(processor->next_wakeup(), t0 + std::chrono::milliseconds(100));
+
+    // Each step is a little past the wakeup requested by the previous one
+    auto step = [&](int i) {
+        clock->advance_to(t0 + std::chrono::milliseconds(101 * i));
+        return poll_values(processor->process_signal_updates({}));
+    };
+    EXPECT_TRUE(step(1).empty());
+    EXPECT_TRUE(step(2).empty());
+    EXPECT_EQ(step(3), std::vector<double>{6.0});
+    EXPECT_TRUE(step(4).empty());
+
+    // An input update publishes as usual, even when the value is unchanged
+    update.timestamp = t0 + std::chrono::milliseconds(450);
+    EXPECT_EQ(poll_values(processor->process_signal_updates({update})), std::vector<double>{6.0});
+}
+
+// Test that mark_pending() asks for a later evaluation, never one already due
+TEST_F(SignalProcessorTest, MarkPendingIsNotImmediatelyDue) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping input_mapping;
+    input_mapping.source.type = "dbc";
+    input_mapping.source.name = "Input";
+    input_mapping.datatype = ValueType::DOUBLE;
+    mappings["Input"] = input_mapping;
+
+    SignalMapping retry_mapping;
+    retry_mapping.depends_on = {"Input"};
+    retry_mapping.datatype = ValueType::DOUBLE;
+    retry_mapping.transform = CodeTransform{"local v = deps['Input']\nmark_pending()\nreturn v"};
+    mappings["Retry"] = retry_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    SignalUpdate update = MakeUpdate("Input", 1.0);
+    update.timestamp = t0;
+    processor->process_signal_updates({update});
+    EXPECT_EQ(processor->next_wakeup(), t0 + std::chrono::milliseconds(10));
+
+    // A run loop polling at the same time finds no due work
+    EXPECT_TRUE(processor->process_signal_updates({}).empty());
+    EXPECT_EQ(processor->next_wakeup(), t0 + std::chrono::milliseconds(10));
+}
+
+// Test that a coroutine transform resumes only when its wait() timer fires
+TEST_F(SignalProcessorTest, CoroutineWaitResumesOnTimer) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping target_mapping;
+    target_mapping.source.type = "dbc";
+    target_mapping.source.name = "LockTarget";
+    target_mapping.datatype = ValueType::BOOL;
+    mappings["Door.IsLocked.Target"] = target_mapping;
+
+    SignalMapping locked_mapping;
+    locked_mapping.depends_on.push_back("Door.IsLocked.Target");
+    locked_mapping.datatype = ValueType::BOOL;
+    locked_mapping.transform = CodeTransform{R"(
+local target = deps['Door.IsLocked.Target']
+wait(200)
+return target
+)", true};
+    mappings["Door.IsLocked"] = locked_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    auto locked_at = [&](std::chrono::milliseconds offset, bool with_input) -> std::optional<bool> {
+        std::vector<SignalUpdate> updates;
+        if (with_input) {
+            updates.push_back(MakeUpdate("Door.IsLocked.Target", true));
+            updates.back().timestamp = t0 + offset;
+        } else {
+            clock->advance_to(t0 + offset);
+        }
+        for (const auto& s : processor->process_signal_updates(updates)) {
+            if (s.path == "Door.IsLocked") {
+                if (auto* b = std::get_if<bool>(&s.qualified_value.value)) return *b;
+            }
+        }
+        return std::nullopt;
+    };
+
+    EXPECT_EQ(locked_at(std::chrono::milliseconds(0), true), std::nullopt);
+    // Dependency updates while waiting on the timer do not resume the coroutine
+    EXPECT_EQ(locked_at(std::chrono::milliseconds(100), true), std::nullopt);
+    EXPECT_EQ(processor->next_wakeup(), t0 + std::chrono::milliseconds(200));
+    EXPECT_EQ(locked_at(std::chrono::milliseconds(200), false), true);
+    EXPECT_FALSE(processor->next_wakeup().has_value());
+}
+
+// Test wait_for() on a dependency change with a timeout
+TEST_F(SignalProcessorTest, CoroutineWaitForDependency) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping input_mapping;
+    input_mapping.source.type = "dbc";
+    input_mapping.source.name = "Input";
+    input_mapping.datatype = ValueType::DOUBLE;
+    mappings["In.Value"] = input_mapping;
+
+    SignalMapping counter_mapping;
+    counter_mapping.depends_on.push_back("In.Value");
+    counter_mapping.datatype = ValueType::DOUBLE;
+    counter_mapping.transform = CodeTransform{R"(
+local n = 0
+while true do
+    if wait_for('In.Value', 500) then n = n + 1 else n = -1 end
+    emit(n)
+end
+)", true};
+    mappings["In.Changes"] = counter_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    auto changes_at = [&](std::chrono::milliseconds offset, std::optional<double> input) -> std::optional<double> {
+        std::vector<SignalUpdate> updates;
+        if (input) {
+            updates.push_back(MakeUpdate("In.Value", *input));
+            updates.back().timestamp = t0 + offset;
+        } else {
+            clock->advance_to(t0 + offset);
+        }
+        for (const auto& s : processor->process_signal_updates(updates)) {
+            if (s.path == "In.Changes") {
+                return std::stod(VSSTypeHelper::to_string(s.qualified_value.value));
+            }
+        }
+        return std::nullopt;
+    };
+
+    EXPECT_EQ(changes_at(std::chrono::milliseconds(0), 1.0), std::nullopt);
+    EXPECT_EQ(changes_at(std::chrono::milliseconds(100), 1.0), std::nullopt);  // Same value
+    EXPECT_EQ(changes_at(std::chrono::milliseconds(200), 2.0), 1.0);
+    EXPECT_EQ(changes_at(std::chrono::milliseconds(700), std::nullopt), -1.0);  // Timed out
+}
+
+// Test native window aggregates from Lua transforms
+TEST_F(SignalProcessorTest, WindowAggregates) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    SignalMapping max_mapping;
+    max_mapping.depends_on.push_back("Vehicle.Speed");
+    max_mapping.datatype = ValueType::DOUBLE;
+    max_mapping.transform = CodeTransform{"window_max(deps['Vehicle.Speed'], 1000)"};
+    mappings["Vehicle.Speed.Max1s"] = max_mapping;
+
+    SignalMapping mean_mapping;
+    mean_mapping.depends_on.push_back("Vehicle.Speed");
+    mean_mapping.datatype = ValueType::DOUBLE;
+    mean_mapping.transform = CodeTransform{"tumbling_mean(deps['Vehicle.Speed'], 1000)"};
+    mappings["Vehicle.Speed.Mean"] = mean_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    std::map<std::string, double> outputs;
+    auto run = [&](std::chrono::milliseconds offset, std::optional<double> speed) {
+        std::vector<SignalUpdate> updates;
+        if (speed) {
+            updates.push_back(MakeUpdate("Vehicle.Speed", *speed));
+            updates.back().timestamp = t0 + offset;
+        } else {
+            clock->advance_to(t0 + offset);
+        }
+        outputs.clear();
+        for (const auto& s : processor->process_signal_updates(updates)) {
+            if (auto* d = std::get_if<double>(&s.qualified_value.value)) outputs[s.path] = *d;
+        }
+    };
+
+    run(std::chrono::milliseconds(100), 10.0);
+    EXPECT_DOUBLE_EQ(outputs["Vehicle.Speed.Max1s"], 10.0);
+    EXPECT_EQ(outputs.count("Vehicle.Speed.Mean"), 0);  // Window still open
+
+    run(std::chrono::milliseconds(500), 30.0);
+    EXPECT_DOUBLE_EQ(outputs["Vehicle.Speed.Max1s"], 30.0);
+    EXPECT_EQ(outputs.count("Vehicle.Speed.Mean"), 0);
+
+    // Woken at the window boundary without new input
+    EXPECT_EQ(processor->next_wakeup(), t0 + std::chrono::milliseconds(1000));
+    run(std::chrono::milliseconds(1000), std::nullopt);
+    EXPECT_DOUBLE_EQ(outputs["Vehicle.Speed.Mean"], 20.0);
+    EXPECT_EQ(outputs.count("Vehicle.Speed.Max1s"), 0);
+}
+
+// Test calibration tables declared on a mapping
+TEST_F(SignalProcessorTest, LookupTableTransform) {
+    SignalMapping level_mapping;
+    level_mapping.source.type = "dbc";
+    level_mapping.source.name = "FuelLevelRaw";
+    level_mapping.datatype = ValueType::DOUBLE;
+    level_mapping.lookup_tables["volume"] = LookupTableSpec{{0, 50, 100}, {0, 20, 60}, {}};
+    level_mapping.transform = CodeTransform{"lookup('volume', x)"};
+    mappings["Vehicle.FuelVolume"] = level_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto vss_signals = processor->process_signal_updates({MakeUpdate("Vehicle.FuelVolume", 75.0)});
+    ASSERT_EQ(vss_signals.size(), 1);
+    EXPECT_DOUBLE_EQ(std::get<double>(vss_signals[0].qualified_value.value), 40.0);
+}
+
+// Test that malformed lookup tables fail initialization
+TEST_F(SignalProcessorTest, InvalidLookupTableFailsInitialize) {
+    SignalMapping level_mapping;
+    level_mapping.source.type = "dbc";
+    level_mapping.source.name = "FuelLevelRaw";
+    level_mapping.datatype = ValueType::DOUBLE;
+    level_mapping.lookup_tables["volume"] = LookupTableSpec{{0, 50, 100}, {0, 20}, {}};
+    level_mapping.transform = CodeTransform{"lookup('volume', x)"};
+    mappings["Vehicle.FuelVolume"] = level_mapping;
+
+    EXPECT_FALSE(processor->initialize(mappings));
+}
+
+// Test odometer integration over input timestamps and state restore
+TEST_F(SignalProcessorTest, OdometerAccumulatesAndRestores) {
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    SignalMapping trip_mapping;
+    trip_mapping.depends_on.push_back("Vehicle.Speed");
+    trip_mapping.datatype = ValueType::DOUBLE;
+    trip_mapping.transform = CodeTransform{"odometer(deps['Vehicle.Speed'])"};
+    mappings["Vehicle.TraveledDistance"] = trip_mapping;
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    auto distance_at = [&](SignalProcessorDAG& p, std::chrono::milliseconds offset, double speed) {
+        SignalUpdate update = MakeUpdate("Vehicle.Speed", speed);
+        update.timestamp = t0 + offset;
+        for (const auto& s : p.process_signal_updates({update})) {
+            if (s.path == "Vehicle.TraveledDistance") return std::get<double>(s.qualified_value.value);
+        }
+        return -1.0;
+    };
+
+    ASSERT_TRUE(processor->initialize(mappings));
+    distance_at(*processor, std::chrono::milliseconds(0), 36.0);
+    for (int i = 1; i <= 10; ++i) {
+        distance_at(*processor, std::chrono::milliseconds(100 * i), 36.0);
+    }
+    // 36 km/h for 1s = 10m
+    auto state = processor->get_accumulator_state();
+    EXPECT_NEAR(state["Vehicle.TraveledDistance"] / 3600, 0.01, 1e-12);
+
+    // A new processor continues from the restored total
+    SignalProcessorDAG restarted;
+    ASSERT_TRUE(restarted.initialize(mappings));
+    restarted.restore_accumulator_state(state);
+    distance_at(restarted, std::chrono::milliseconds(5000), 36.0);
+    EXPECT_NEAR(distance_at(restarted, std::chrono::milliseconds(6000), 36.0), 0.02, 1e-12);
+}
+
+// Test native fusion operators on a derived node
+TEST_F(SignalProcessorTest, KalmanFuseDerivedSignal) {
+    SignalMapping wheel_mapping;
+    wheel_mapping.source.type = "dbc";
+    wheel_mapping.source.name = "WheelSpeed";
+    wheel_mapping.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.WheelSpeed"] = wheel_mapping;
+
+    SignalMapping gnss_mapping;
+    gnss_mapping.source.type = "dbc";
+    gnss_mapping.source.name = "GnssSpeed";
+    gnss_mapping.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.GnssSpeed"] = gnss_mapping;
+
+    SignalMapping fused_mapping;
+    fused_mapping.depends_on = {"Vehicle.WheelSpeed", "Vehicle.GnssSpeed"};
+    fused_mapping.datatype = ValueType::DOUBLE;
+    fused_mapping.transform = CodeTransform{
+        "kalman_fuse(nil, 0.01, deps['Vehicle.WheelSpeed'], 1.0, deps['Vehicle.GnssSpeed'], 100.0)"};
+    mappings["Vehicle.Speed"] = fused_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    double fused = 0.0;
+    for (int i = 0; i < 50; ++i) {
+        auto wheel = MakeUpdate("Vehicle.WheelSpeed", 20.0);
+        auto gnss = MakeUpdate("Vehicle.GnssSpeed", 22.0);
+        wheel.timestamp = gnss.timestamp = t0 + std::chrono::milliseconds(100 * i);
+        for (const auto& s : processor->process_signal_updates({wheel, gnss})) {
+            if (s.path == "Vehicle.Speed") fused = std::get<double>(s.qualified_value.value);
+        }
+    }
+    // Weighted towards the precise wheel speed
+    EXPECT_GT(fused, 20.0);
+    EXPECT_LT(fused, 20.1);
+}
+
+// Test that a WAIT_ALL join evaluates once per aligned sample set
+TEST_F(SignalProcessorTest, WaitAllJoinEvaluatesOncePerSet) {
+    SignalMapping voltage_mapping;
+    voltage_mapping.source.type = "dbc";
+    voltage_mapping.source.name = "PackVoltage";
+    voltage_mapping.datatype = ValueType::DOUBLE;
+    mappings["Battery.Voltage"] = voltage_mapping;
+
+    SignalMapping current_mapping;
+    current_mapping.source.type = "dbc";
+    current_mapping.source.name = "PackCurrent";
+    current_mapping.datatype = ValueType::DOUBLE;
+    mappings["Battery.Current"] = current_mapping;
+
+    SignalMapping power_mapping;
+    power_mapping.depends_on = {"Battery.Voltage", "Battery.Current"};
+    power_mapping.datatype = ValueType::DOUBLE;
+    power_mapping.join_policy = JoinPolicy::WAIT_ALL;
+    power_mapping.join_tolerance_ms = 10;
+    power_mapping.transform = CodeTransform{"deps['Battery.Voltage'] * deps['Battery.Current']"};
+    mappings["Battery.Power"] = power_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    auto power_after = [&](const std::string& name, double value, int offset_ms) -> std::optional<double> {
+        SignalUpdate update = MakeUpdate(name, value);
+        update.timestamp = t0 + std::chrono::milliseconds(offset_ms);
+        for (const auto& s : processor->process_signal_updates({update})) {
+            if (s.path == "Battery.Power") return std::get<double>(s.qualified_value.value);
+        }
+        return std::nullopt;
+    };
+
+    EXPECT_EQ(power_after("Battery.Voltage", 400.0, 0), std::nullopt);
+    EXPECT_EQ(power_after("Battery.Current", 10.0, 5), 4000.0);
+    // A partial update does not re-evaluate with a stale partner
+    EXPECT_EQ(power_after("Battery.Voltage", 390.0, 100), std::nullopt);
+    EXPECT_EQ(power_after("Battery.Current", 20.0, 102), 7800.0);
+}
+
+// Test that resample groups emit one row per grid tick
+TEST_F(SignalProcessorTest, ResampleGroupEmitsRowsOnGrid) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    SignalMapping kmh_mapping;
+    kmh_mapping.depends_on = {"Vehicle.Speed"};
+    kmh_mapping.datatype = ValueType::DOUBLE;
+    kmh_mapping.transform = CodeTransform{"deps['Vehicle.Speed'] * 3.6"};
+    mappings["Vehicle.SpeedKmh"] = kmh_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    clock->advance_to(t0);
+
+    ResampleGroup group;
+    group.name = "model_input";
+    group.period_ms = 100;
+    group.columns = {{"Vehicle.Speed", ResampleMethod::MEAN}, {"Vehicle.SpeedKmh", ResampleMethod::HOLD}};
+    EXPECT_FALSE(processor->add_resample_group(ResampleGroup{"bad", 100, 0, {{"Unknown.Signal"}}}));
+    ASSERT_TRUE(processor->add_resample_group(group));
+
+    std::vector<std::vector<double>> rows;
+    processor->set_resample_handler([&rows](const ResampleGroup&, std::chrono::steady_clock::time_point,
+                                            const std::vector<double>& row) {
+        rows.push_back(row);
+    });
+    EXPECT_EQ(processor->next_wakeup(), t0);
+
+    auto send = [&](double speed, int offset_ms) {
+        SignalUpdate update = MakeUpdate("Vehicle.Speed", speed);
+        update.timestamp = t0 + std::chrono::milliseconds(offset_ms);
+        processor->process_signal_updates({update});
+    };
+
+    send(10.0, 0);   // Tick at t0
+    send(20.0, 50);
+    send(30.0, 80);
+    send(40.0, 130);  // Tick at +100
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_DOUBLE_EQ(rows[0][0], 10.0);
+    EXPECT_DOUBLE_EQ(rows[1][0], 25.0);
+    EXPECT_DOUBLE_EQ(rows[1][1], 108.0);
+    EXPECT_EQ(processor->next_wakeup(), t0 + std::chrono::milliseconds(200));
+
+    // Driven by the scheduler without new input
+    clock->advance_to(t0 + std::chrono::milliseconds(300));
+    processor->process_signal_updates({});
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_DOUBLE_EQ(rows[3][0], 40.0);
+    EXPECT_DOUBLE_EQ(rows[3][1], 144.0);
+}
+
+// Test that sketch nodes feed quantiles emitted by a periodic node
+TEST_F(SignalProcessorTest, QuantileSketchPeriodicEmission) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping temp_mapping;
+    temp_mapping.source.type = "dbc";
+    temp_mapping.source.name = "MotorTemp";
+    temp_mapping.datatype = ValueType::DOUBLE;
+    mappings["Motor.Temperature"] = temp_mapping;
+
+    SignalMapping count_mapping;
+    count_mapping.depends_on = {"Motor.Temperature"};
+    count_mapping.datatype = ValueType::UINT32;
+    count_mapping.transform = CodeTransform{"sketch_add('motor_temp', deps['Motor.Temperature'])"};
+    mappings["Motor.Temperature.SampleCount"] = count_mapping;
+
+    SignalMapping p95_mapping;
+    p95_mapping.depends_on = {"Motor.Temperature.SampleCount"};
+    p95_mapping.datatype = ValueType::DOUBLE;
+    p95_mapping.update_trigger = UpdateTrigger::PERIODIC;
+    p95_mapping.interval_ms = 1000;
+    p95_mapping.transform = CodeTransform{"sketch_quantile('motor_temp', 0.95)"};
+    mappings["Motor.Temperature.P95"] = p95_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    std::optional<double> p95;
+    for (int i = 0; i <= 100; ++i) {
+        SignalUpdate update = MakeUpdate("Motor.Temperature", static_cast<double>(i));
+        update.timestamp = t0 + std::chrono::milliseconds(20 * i);
+        for (const auto& s : processor->process_signal_updates({update})) {
+            if (s.path == "Motor.Temperature.P95") p95 = std::get<double>(s.qualified_value.value);
+        }
+    }
+    ASSERT_TRUE(p95.has_value());
+    EXPECT_NEAR(*p95, 95.0, 95.0 * 0.011);
+
+    // Sketches from another run merge into the restored state
+    auto state = processor->get_sketch_state();
+    SignalProcessorDAG other;
+    ASSERT_TRUE(other.initialize(mappings));
+    ASSERT_TRUE(other.restore_sketch_state(state));
+    ASSERT_TRUE(other.restore_sketch_state(state));
+    auto merged = QuantileSketch::deserialize(other.get_sketch_state()["motor_temp"]);
+    ASSERT_TRUE(merged.has_value());
+    EXPECT_EQ(merged->count(), 202u);
+    EXPECT_FALSE(other.restore_sketch_state({{"motor_temp", "garbage"}}));
+
+    // Sketch files keep names with spaces and reject malformed content
+    ASSERT_TRUE(other.restore_sketch_state({{"motor temp rear", state["motor_temp"]}}));
+    std::string path = ::testing::TempDir() + "sketches.bin";
+    ASSERT_TRUE(other.save_sketches(path));
+    SignalProcessorDAG restored;
+    ASSERT_TRUE(restored.initialize(mappings));
+    ASSERT_TRUE(restored.load_sketches(path));
+    auto restored_state = restored.get_sketch_state();
+    EXPECT_EQ(restored_state.size(), 2u);
+    EXPECT_EQ(restored_state.count("motor temp rear"), 1u);
+
+    std::ofstream(path, std::ios::trunc) << "motor_temp garbage\n";
+    EXPECT_FALSE(restored.load_sketches(path));
+    std::remove(path.c_str());
+}
+
+// Test that hist() reads the shared history of a dependency
+TEST_F(SignalProcessorTest, HistoryOfDependency) {
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    speed_mapping.history_size = 3;
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    SignalMapping accel_mapping;
+    accel_mapping.depends_on = {"Vehicle.Speed"};
+    accel_mapping.datatype = ValueType::DOUBLE;
+    accel_mapping.transform = CodeTransform{R"(
+        local v0, v1 = hist('Vehicle.Speed', 0), hist('Vehicle.Speed', 1)
+        if v1 == nil then return nil end
+        return (v0 - v1) / (hist_time('Vehicle.Speed', 0) - hist_time('Vehicle.Speed', 1))
+    )"};
+    mappings["Vehicle.Acceleration"] = accel_mapping;
+
+    SignalMapping oldest_mapping;
+    oldest_mapping.depends_on = {"Vehicle.Speed"};
+    oldest_mapping.datatype = ValueType::DOUBLE;
+    oldest_mapping.transform = CodeTransform{"hist('Vehicle.Speed', 2)"};
+    mappings["Vehicle.SpeedOldest"] = oldest_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    std::map<std::string, double> last;
+    auto send = [&](double speed, int offset_ms) {
+        SignalUpdate update = MakeUpdate("Vehicle.Speed", speed);
+        update.timestamp = t0 + std::chrono::milliseconds(offset_ms);
+        for (const auto& s : processor->process_signal_updates({update})) {
+            if (auto* d = std::get_if<double>(&s.qualified_value.value)) last[s.path] = *d;
+        }
+    };
+
+    send(10.0, 0);
+    EXPECT_EQ(last.count("Vehicle.Acceleration"), 0u);
+    send(12.0, 500);
+    EXPECT_NEAR(last["Vehicle.Acceleration"], 4.0, 1e-6);
+    send(13.0, 1000);
+    send(16.0, 1500);
+    EXPECT_NEAR(last["Vehicle.Acceleration"], 6.0, 1e-6);
+    EXPECT_DOUBLE_EQ(last["Vehicle.SpeedOldest"], 12.0);  // Capacity 3
+}
+
+// Test that joins and histories of an input signal hold its transformed value
+TEST_F(SignalProcessorTest, InputSamplesUseTransformedValue) {
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    speed_mapping.history_size = 2;
+    speed_mapping.transform = CodeTransform{"x * 3.6"};  // m/s to km/h
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    SignalMapping latest_mapping;
+    latest_mapping.depends_on = {"Vehicle.Speed"};
+    latest_mapping.datatype = ValueType::DOUBLE;
+    latest_mapping.transform = CodeTransform{"deps['Vehicle.Speed']"};
+    mappings["Speed.Latest"] = latest_mapping;
+
+    SignalMapping joined_mapping = latest_mapping;
+    joined_mapping.join_policy = JoinPolicy::INTERPOLATE;
+    mappings["Speed.Joined"] = joined_mapping;
+
+    SignalMapping hist_mapping = latest_mapping;
+    hist_mapping.transform = CodeTransform{"hist('Vehicle.Speed', 0)"};
+    mappings["Speed.Hist"] = hist_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    std::map<std::string, double> last;
+    for (int i = 0; i < 2; ++i) {
+        SignalUpdate update = MakeUpdate("Vehicle.Speed", 10.0 * (i + 1));
+        update.timestamp = t0 + std::chrono::milliseconds(100 * i);
+        for (const auto& s : processor->process_signal_updates({update})) {
+            if (auto* d = std::get_if<double>(&s.qualified_value.value)) last[s.path] = *d;
+        }
+    }
+
+    EXPECT_NEAR(last["Vehicle.Speed"], 72.0, 1e-6);
+    EXPECT_NEAR(last["Speed.Latest"], 72.0, 1e-6);
+    EXPECT_NEAR(last["Speed.Joined"], 72.0, 1e-6);
+    EXPECT_NEAR(last["Speed.Hist"], 72.0, 1e-6);
+}
+
+// Test that hysteresis() publishes transitions only, confirmed by a timer
+TEST_F(SignalProcessorTest, HysteresisPublishesTransitions) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping temp_mapping;
+    temp_mapping.source.type = "dbc";
+    temp_mapping.source.name = "CoolantTemp";
+    temp_mapping.datatype = ValueType::DOUBLE;
+    mappings["Engine.Temperature"] = temp_mapping;
+
+    SignalMapping overheat_mapping;
+    overheat_mapping.depends_on.push_back("Engine.Temperature");
+    overheat_mapping.datatype = ValueType::BOOL;
+    overheat_mapping.transform = CodeTransform{"hysteresis(deps['Engine.Temperature'], 110, 100, 500)"};
+    mappings["Engine.Overheat"] = overheat_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    auto send = [&](double temp, int offset_ms) {
+        SignalUpdate update = MakeUpdate("Engine.Temperature", temp);
+        update.timestamp = t0 + std::chrono::milliseconds(offset_ms);
+        std::vector<bool> events;
+        for (const auto& s : processor->process_signal_updates({update})) {
+            if (s.path == "Engine.Overheat") events.push_back(std::get<bool>(s.qualified_value.value));
+        }
+        return events;
+    };
+
+    EXPECT_EQ(send(90.0, 0), std::vector<bool>{false});  // Initial state
+    EXPECT_TRUE(send(95.0, 100).empty());
+    EXPECT_TRUE(send(115.0, 200).empty());  // Debouncing
+    EXPECT_EQ(processor->next_wakeup(), t0 + std::chrono::milliseconds(700));
+
+    // No further input: the debounce expiry publishes the event
+    clock->advance_to(t0 + std::chrono::milliseconds(700));
+    auto vss_signals = processor->process_signal_updates({});
+    ASSERT_EQ(vss_signals.size(), 1u);
+    EXPECT_EQ(std::get<bool>(vss_signals[0].qualified_value.value), true);
+
+    EXPECT_TRUE(send(105.0, 800).empty());  // Inside the band
+    EXPECT_FALSE(processor->next_wakeup().has_value());
+}
+
+// Test that a runaway transform is aborted by its instruction budget
+TEST_F(SignalProcessorTest, InstructionBudgetAbortsRunawayTransform) {
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    SignalMapping stuck_mapping;
+    stuck_mapping.depends_on = {"Vehicle.Speed"};
+    stuck_mapping.datatype = ValueType::DOUBLE;
+    stuck_mapping.max_instructions = 100000;
+    stuck_mapping.transform = CodeTransform{R"(
+        local x = deps['Vehicle.Speed']
+        while x > 0 do x = x + 1 end
+        return x
+    )"};
+    mappings["Vehicle.Stuck"] = stuck_mapping;
+
+    SignalMapping guard_mapping;
+    guard_mapping.depends_on = {"Vehicle.Stuck"};
+    guard_mapping.datatype = ValueType::BOOL;
+    guard_mapping.transform = CodeTransform{"deps['Vehicle.Stuck'] == nil"};
+    mappings["Vehicle.StuckMissing"] = guard_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto vss_signals = processor->process_signal_updates({MakeUpdate("Vehicle.Speed", 10.0)});
+    std::map<std::string, VSSSignal> by_path;
+    for (const auto& s : vss_signals) by_path[s.path] = s;
+
+    ASSERT_TRUE(by_path.count("Vehicle.Stuck"));
+    EXPECT_EQ(by_path["Vehicle.Stuck"].qualified_value.quality, SignalQuality::INVALID);
+    ASSERT_TRUE(by_path.count("Vehicle.StuckMissing"));
+    EXPECT_EQ(std::get<bool>(by_path["Vehicle.StuckMissing"].qualified_value.value), true);
+
+    const auto& metrics = processor->execution_metrics();
+    EXPECT_EQ(metrics.node_budget_exceeded, 1u);
+    EXPECT_EQ(metrics.exceeded_by_signal.at("Vehicle.Stuck"), 1u);
+    EXPECT_GE(metrics.instructions, 100000u);
+
+    // Within budget the transform runs normally
+    auto ok = processor->process_signal_updates({MakeUpdate("Vehicle.Speed", -1.0)});
+    bool found = false;
+    for (const auto& s : ok) {
+        if (s.path == "Vehicle.Stuck") {
+            found = true;
+            EXPECT_TRUE(s.qualified_value.is_valid());
+        }
+    }
+    EXPECT_TRUE(found);
+    EXPECT_EQ(processor->execution_metrics().node_budget_exceeded, 1u);
+}
+
+// Test that a budget set while a coroutine is suspended applies when it resumes
+TEST_F(SignalProcessorTest, InstructionBudgetAppliesToResumedCoroutine) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping input_mapping;
+    input_mapping.source.type = "dbc";
+    input_mapping.source.name = "Input";
+    input_mapping.datatype = ValueType::DOUBLE;
+    mappings["Input"] = input_mapping;
+
+    SignalMapping slow_mapping;
+    slow_mapping.depends_on = {"Input"};
+    slow_mapping.datatype = ValueType::DOUBLE;
+    slow_mapping.transform = CodeTransform{R"(
+wait(10)
+local sum = 0
+for i = 1, 5000000 do sum = sum + i end
+return sum
+)", true};
+    mappings["Slow"] = slow_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto t0 = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    SignalUpdate update = MakeUpdate("Input", 1.0);
+    update.timestamp = t0;
+    processor->process_signal_updates({update});
+    ASSERT_EQ(processor->next_wakeup(), t0 + std::chrono::milliseconds(10));
+
+    // Configured after the coroutine was created without a budget hook
+    ExecutionBudget budget;
+    budget.node_instructions = 100000;
+    processor->set_execution_budget(budget);
+
+    clock->advance_to(t0 + std::chrono::milliseconds(10));
+    bool found = false;
+    for (const auto& s : processor->process_signal_updates({})) {
+        if (s.path == "Slow") {
+            found = true;
+            EXPECT_EQ(s.qualified_value.quality, SignalQuality::INVALID);
+        }
+    }
+    EXPECT_TRUE(found);
+    EXPECT_EQ(processor->execution_metrics().node_budget_exceeded, 1u);
+    EXPECT_EQ(processor->execution_metrics().exceeded_by_signal.at("Slow"), 1u);
+}
+
+// Test that the batch budget bounds the total work of one call
+TEST_F(SignalProcessorTest, BatchBudgetInvalidatesRemainingNodes) {
+    SignalMapping input_mapping;
+    input_mapping.source.type = "dbc";
+    input_mapping.source.name = "Input";
+    input_mapping.datatype = ValueType::DOUBLE;
+    mappings["Input"] = input_mapping;
+
+    for (const char* name : {"Heavy.A", "Heavy.B"}) {
+        SignalMapping heavy;
+        heavy.depends_on = {"Input"};
+        heavy.datatype = ValueType::DOUBLE;
+        heavy.transform = CodeTransform{R"(
+            local sum = 0
+            for i = 1, 50000 do sum = sum + i end
+            return sum
+        )"};
+        mappings[name] = heavy;
+    }
+
+    ASSERT_TRUE(processor->initialize(mappings));
+    ExecutionBudget budget;
+    budget.batch_instructions = 150000;  // Each heavy node needs ~100k
+    processor->set_execution_budget(budget);
+
+    int valid = 0, invalid = 0;
+    for (const auto& s : processor->process_signal_updates({MakeUpdate("Input", 1.0)})) {
+        if (s.path == "Input") continue;
+        (s.qualified_value.is_valid() ? valid : invalid)++;
+    }
+    EXPECT_EQ(valid, 1);
+    EXPECT_EQ(invalid, 1);
+    EXPECT_EQ(processor->execution_metrics().batch_budget_exceeded, 1u);
+}
+
+// Test that critical signals go first and lower classes are deferred past the deadline
+TEST_F(SignalProcessorTest, PriorityClassesAndBatchDeadline) {
+    auto clock = std::make_shared<SimulatedClock>();
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+
+    SignalMapping pedal_mapping;
+    pedal_mapping.source.type = "dbc";
+    pedal_mapping.source.name = "BrakePedal";
+    pedal_mapping.datatype = ValueType::DOUBLE;
+    mappings["Brake.PedalPosition"] = pedal_mapping;
+
+    SignalMapping brake_mapping;
+    brake_mapping.depends_on = {"Brake.PedalPosition"};
+    brake_mapping.datatype = ValueType::BOOL;
+    brake_mapping.priority = Priority::CRITICAL;
+    brake_mapping.transform = CodeTransform{"deps['Brake.PedalPosition'] > 10"};
+    mappings["Brake.IsEngaged"] = brake_mapping;
+
+    SignalMapping cell_mapping;
+    cell_mapping.source.type = "dbc";
+    cell_mapping.source.name = "CellVoltage";
+    cell_mapping.datatype = ValueType::DOUBLE;
+    cell_mapping.priority = Priority::LOW;
+    mappings["Battery.Cell1.Voltage"] = cell_mapping;
+
+    SignalMapping min_mapping;
+    min_mapping.depends_on = {"Battery.Cell1.Voltage"};
+    min_mapping.datatype = ValueType::DOUBLE;
+    min_mapping.priority = Priority::LOW;
+    min_mapping.transform = CodeTransform{"deps['Battery.Cell1.Voltage']"};
+    mappings["Battery.MinCellVoltage"] = min_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    // The pedal input inherits CRITICAL from the brake output and goes first
+    std::vector<std::string> paths;
+    for (const auto& s : processor->process_signal_updates(
+             {MakeUpdate("Battery.Cell1.Voltage", 3.7), MakeUpdate("Brake.PedalPosition", 40.0)})) {
+        paths.push_back(s.path);
+    }
+    ASSERT_GE(paths.size(), 2u);
+    EXPECT_EQ(paths[0], "Brake.PedalPosition");
+    EXPECT_EQ(paths[1], "Brake.IsEngaged");
+    EXPECT_FALSE(processor->next_wakeup().has_value());
+
+    // With the deadline already spent, LOW work waits for the next call
+    processor->set_batch_deadline(std::chrono::steady_clock::duration::zero());
+    paths.clear();
+    for (const auto& s : processor->process_signal_updates(
+             {MakeUpdate("Battery.Cell1.Voltage", 3.6), MakeUpdate("Brake.PedalPosition", 0.0)})) {
+        paths.push_back(s.path);
+    }
+    EXPECT_EQ(paths, (std::vector<std::string>{"Brake.PedalPosition", "Brake.IsEngaged"}));
+    EXPECT_EQ(processor->execution_metrics().deferred_nodes, 2u);
+    ASSERT_TRUE(processor->next_wakeup().has_value());
+    EXPECT_EQ(*processor->next_wakeup(), clock->now());
+
+    processor->set_batch_deadline(std::nullopt);
+    paths.clear();
+    for (const auto& s : processor->process_signal_updates({})) {
+        paths.push_back(s.path);
+    }
+    EXPECT_EQ(paths, (std::vector<std::string>{"Battery.Cell1.Voltage", "Battery.MinCellVoltage"}));
+
+    // The deadline applies at the class boundary even when only a later node
+    // of the class has work (here LowB's periodic update)
+    processor = std::make_unique<SignalProcessorDAG>(clock);
+    mappings.clear();
+
+    SignalMapping crit_mapping;
+    crit_mapping.source.type = "dbc";
+    crit_mapping.source.name = "Crit";
+    crit_mapping.datatype = ValueType::DOUBLE;
+    crit_mapping.priority = Priority::CRITICAL;
+    mappings["Crit"] = crit_mapping;
+
+    SignalMapping low_a_mapping;
+    low_a_mapping.source.type = "dbc";
+    low_a_mapping.source.name = "LowA";
+    low_a_mapping.datatype = ValueType::DOUBLE;
+    low_a_mapping.priority = Priority::LOW;
+    mappings["LowA"] = low_a_mapping;
+
+    SignalMapping low_b_mapping;
+    low_b_mapping.depends_on = {"LowA"};
+    low_b_mapping.datatype = ValueType::DOUBLE;
+    low_b_mapping.priority = Priority::LOW;
+    low_b_mapping.update_trigger = UpdateTrigger::PERIODIC;
+    low_b_mapping.interval_ms = 100;
+    low_b_mapping.transform = CodeTransform{"deps['LowA']"};
+    mappings["LowB"] = low_b_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto at = [&](const std::string& name, int offset_ms) {
+        SignalUpdate update = MakeUpdate(name, 1.0);
+        update.timestamp = clock->now() + std::chrono::milliseconds(offset_ms);
+        return update;
+    };
+    EXPECT_EQ(processor->process_signal_updates({at("LowA", 0), at("Crit", 0)}).size(), 3u);
+
+    processor->set_batch_deadline(std::chrono::steady_clock::duration::zero());
+    paths.clear();
+    for (const auto& s : processor->process_signal_updates({at("Crit", 100)})) {
+        paths.push_back(s.path);
+    }
+    EXPECT_EQ(paths, (std::vector<std::string>{"Crit"}));
+    EXPECT_EQ(processor->execution_metrics().deferred_nodes, 1u);
+    ASSERT_TRUE(processor->next_wakeup().has_value());
+    EXPECT_EQ(*processor->next_wakeup(), clock->now());
+}
+
+// Template instances share one generated transform and see their own index
+TEST_F(SignalProcessorTest, TemplateInstancesShareTransform) {
+    auto tmpl = std::make_shared<MappingTemplate>();
+    tmpl->name = "Cell{i}.Scaled";
+    tmpl->variable = "i";
+    tmpl->transform = CodeTransform{"x * i"};
+
+    for (int i = 1; i <= 3; ++i) {
+        SignalMapping cell;
+        cell.source.type = "dbc";
+        cell.source.name = "Cell" + std::to_string(i);
+        cell.datatype = ValueType::DOUBLE;
+        cell.instance_of = tmpl;
+        cell.template_index = i;
+        mappings["Cell" + std::to_string(i) + ".Scaled"] = cell;
+    }
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    std::map<std::string, double> values;
+    for (const auto& s : processor->process_signal_updates({MakeUpdate("Cell1.Scaled", 2.0),
+                                                            MakeUpdate("Cell2.Scaled", 2.0),
+                                                            MakeUpdate("Cell3.Scaled", 2.0)})) {
+        if (auto* d = std::get_if<double>(&s.qualified_value.value)) values[s.path] = *d;
+    }
+    EXPECT_DOUBLE_EQ(values["Cell1.Scaled"], 2.0);
+    EXPECT_DOUBLE_EQ(values["Cell2.Scaled"], 4.0);
+    EXPECT_DOUBLE_EQ(values["Cell3.Scaled"], 6.0);
+}
+
+// Footprint report; a private mapping copy drops transform source once compiled
+TEST_F(SignalProcessorTest, MemoryFootprintReleasesTransformSource) {
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    speed_mapping.transform = CodeTransform{"x * 3.6 -- " + std::string(4096, 'c')};
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    auto shared = std::make_shared<const MappingSet>(mappings);
+    ASSERT_TRUE(processor->initialize(shared));
+    auto kept = processor->memory_footprint();
+    EXPECT_GE(kept.mappings, 4096u);
+    EXPECT_GT(kept.dag, 0u);
+    EXPECT_GT(kept.lua, 0u);
+    EXPECT_EQ(kept.total(), kept.mappings + kept.dag + kept.lua + kept.runtime);
+
+    SignalProcessorDAG owning;
+    ASSERT_TRUE(owning.initialize(mappings));
+    EXPECT_LT(owning.memory_footprint().mappings + 4096, kept.mappings);
+
+    auto result = owning.process_signal_updates({MakeUpdate("Vehicle.Speed", 10.0)});
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_DOUBLE_EQ(std::get<double>(result[0].qualified_value.value), 36.0);
+}
+
+// Transforms return (value, status); path and type come from the node
+TEST_F(SignalProcessorTest, TransformReturnsValueAndStatus) {
+    SignalMapping speed_mapping;
+    speed_mapping.source.type = "dbc";
+    speed_mapping.source.name = "VehicleSpeed";
+    speed_mapping.datatype = ValueType::DOUBLE;
+    speed_mapping.transform = CodeTransform{"x * 1e-9"};
+    mappings["Vehicle.Speed"] = speed_mapping;
+
+    SignalMapping gear_mapping;
+    gear_mapping.depends_on = {"Vehicle.Speed"};
+    gear_mapping.datatype = ValueType::STRING;
+    ValueMapping gears;
+    gears.mappings = {{"1", "DRIVE"}};
+    gear_mapping.transform = gears;
+    mappings["Vehicle.Gear"] = gear_mapping;
+
+    ASSERT_TRUE(processor->initialize(mappings));
+
+    auto result = processor->process_signal_updates({MakeUpdate("Vehicle.Speed", 2.0)});
+    std::map<std::string, VSSSignal> by_path;
+    for (const auto& signal : result) {
+        by_path[signal.path.str()] = signal;
+    }
+    ASSERT_EQ(by_path.count("Vehicle.Speed"), 1u);
+    EXPECT_EQ(std::get<double>(by_path["Vehicle.Speed"].qualified_value.value), 0.0);  // Noise cleared
+    EXPECT_EQ(by_path["Vehicle.Speed"].qualified_value.quality, SignalQuality::VALID);
+
+    // An unmapped value is published INVALID
+    ASSERT_EQ(by_path.count("Vehicle.Gear"), 1u);
+    EXPECT_EQ(by_path["Vehicle.Gear"].qualified_value.quality, SignalQuality::INVALID);
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(by_path["Vehicle.Gear"].qualified_value.value));
+}
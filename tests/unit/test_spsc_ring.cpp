@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "alloc_tracker.h"
+#include "vssdag/spsc_ring.h"
+
+using namespace vssdag;
+
+// Test capacity rounding, full and empty rings
+TEST(SpscRingTest, FullAndEmpty) {
+    SpscRing<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 4u);
+
+    int value = 0;
+    EXPECT_FALSE(ring.try_pop(value));
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(4));
+    EXPECT_EQ(ring.size_approx(), 4u);
+
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.try_push(4));
+}
+
+// Test FIFO order across many wraparounds
+TEST(SpscRingTest, WrapsAround) {
+    SpscRing<std::string> ring(8);
+    std::string value;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(ring.try_push(std::to_string(i)));
+        ASSERT_TRUE(ring.try_push(std::to_string(i + 1000)));
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, std::to_string(i));
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, std::to_string(i + 1000));
+    }
+}
+
+// Test that popping hands buffers back to the ring instead of stealing them
+TEST(SpscRingTest, PopKeepsSlotBuffers) {
+    SpscRing<std::vector<uint8_t>> ring(4);
+    const std::vector<uint8_t> payload(8, 0x5a);
+    std::vector<uint8_t> item;
+
+    // Warm up: every slot and the consumer's item own a buffer
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(ring.try_push(payload));
+        ASSERT_TRUE(ring.try_pop(item));
+    }
+
+    test::AllocScope scope;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(ring.try_push(payload));
+        ASSERT_TRUE(ring.try_pop(item));
+        EXPECT_EQ(item, payload);
+    }
+    EXPECT_EQ(scope.counts().allocations, 0u);
+}
+
+// Test that a producer and a consumer thread see every item in order
+TEST(SpscRingTest, ProducerConsumerThreads) {
+    SpscRing<uint64_t> ring(64);
+    constexpr uint64_t kCount = 200000;
+
+    std::thread producer([&ring] {
+        for (uint64_t i = 0; i < kCount; ++i) {
+            while (!ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    while (expected < kCount) {
+        if (ring.try_pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
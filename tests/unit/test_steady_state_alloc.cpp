@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory_resource>
+#include "alloc_tracker.h"
+#include "vssdag/signal_processor.h"
+#include "vssdag/mapping_types.h"
+
+using namespace vssdag;
+
+namespace {
+
+// Upstream resource that counts what the processor's Lua pool requests
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+std::unordered_map<std::string, SignalMapping> numeric_mappings() {
+    std::unordered_map<std::string, SignalMapping> mappings;
+
+    SignalMapping speed;
+    speed.source.type = "dbc";
+    speed.source.name = "VehicleSpeed";
+    speed.datatype = ValueType::DOUBLE;
+    speed.transform = CodeTransform{"x * 3.6"};
+    mappings["Vehicle.Speed"] = speed;
+
+    SignalMapping throttle;
+    throttle.source.type = "dbc";
+    throttle.source.name = "ThrottlePosition";
+    throttle.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.Throttle"] = throttle;
+
+    SignalMapping power;
+    power.depends_on = {"Vehicle.Speed", "Vehicle.Throttle"};
+    power.datatype = ValueType::DOUBLE;
+    power.transform = CodeTransform{
+        "local speed = deps['Vehicle.Speed']\n"
+        "local throttle = deps['Vehicle.Throttle']\n"
+        "if speed == nil or throttle == nil then return nil end\n"
+        "return speed * throttle / 100"};
+    mappings["Vehicle.PowerEstimate"] = power;
+    return mappings;
+}
+
+void advance(std::vector<SignalUpdate>& updates, int i) {
+    updates[0].value = 10.0 + i % 50;
+    updates[1].value = static_cast<double>(i % 100);
+    for (auto& update : updates) {
+        update.timestamp = std::chrono::steady_clock::now();
+    }
+}
+
+} // namespace
+
+TEST(SteadyStateAllocTest, ProcessBatchDoesNotAllocate) {
+    vssdag::test::AllocScope setup;
+    SignalProcessorDAG processor;
+    ASSERT_TRUE(processor.initialize(numeric_mappings()));
+    ASSERT_GT(setup.counts().allocations, 0u);  // The counter is live
+
+    std::vector<SignalUpdate> updates(2);
+    updates[0].signal_name = "Vehicle.Speed";
+    updates[1].signal_name = "Vehicle.Throttle";
+    std::vector<VSSSignal> out;
+
+    // Warm up: signal values, scratch buffers and the Lua pool reach their size
+    for (int i = 0; i < 2000; ++i) {
+        advance(updates, i);
+        out.clear();
+        processor.process_signal_updates(updates, out);
+    }
+    ASSERT_EQ(out.size(), 3u);
+
+    vssdag::test::AllocScope scope;
+    for (int i = 0; i < 500; ++i) {
+        advance(updates, i);
+        out.clear();
+        processor.process_signal_updates(updates, out);
+    }
+    auto counts = scope.counts();
+
+    vssdag::test::report_allocs("numeric_batch", counts, 500);
+    EXPECT_EQ(counts.allocations, 0u);
+    EXPECT_EQ(out.size(), 3u);
+}
+
+TEST(SteadyStateAllocTest, LuaMemoryComesFromUpstreamResource) {
+    CountingResource upstream;
+    SignalProcessorDAG processor(default_clock(), &upstream);
+    ASSERT_TRUE(processor.initialize(numeric_mappings()));
+    EXPECT_GT(upstream.allocations, 0u);
+
+    std::vector<SignalUpdate> updates(2);
+    updates[0].signal_name = "Vehicle.Speed";
+    updates[1].signal_name = "Vehicle.Throttle";
+    advance(updates, 30);
+    auto signals = processor.process_signal_updates(updates);
+
+    auto power = std::find_if(signals.begin(), signals.end(),
+        [](const VSSSignal& s) { return s.path == "Vehicle.PowerEstimate"; });
+    ASSERT_NE(power, signals.end());
+    EXPECT_DOUBLE_EQ(std::get<double>(power->qualified_value.value), 40.0 * 3.6 * 30 / 100);
+}
+
+// Window nodes re-arm their boundary wakeup on every evaluation; neither
+// the timer heap nor anything else may grow per batch
+TEST(SteadyStateAllocTest, WindowedBatchesDoNotAllocate) {
+    std::unordered_map<std::string, SignalMapping> mappings;
+    SignalMapping speed;
+    speed.source.type = "dbc";
+    speed.source.name = "VehicleSpeed";
+    speed.datatype = ValueType::DOUBLE;
+    mappings["Vehicle.Speed"] = speed;
+    for (int seconds : {30, 60, 120}) {
+        SignalMapping mean;
+        mean.depends_on = {"Vehicle.Speed"};
+        mean.datatype = ValueType::DOUBLE;
+        mean.transform = CodeTransform{"tumbling_mean(deps['Vehicle.Speed'], " +
+                                       std::to_string(seconds * 1000) + ")"};
+        mappings["Vehicle.Speed.Mean" + std::to_string(seconds)] = mean;
+    }
+
+    auto clock = std::make_shared<SimulatedClock>();
+    SignalProcessorDAG processor(clock);
+    ASSERT_TRUE(processor.initialize(mappings));
+
+    std::vector<SignalUpdate> updates(1);
+    updates[0].signal_name = "Vehicle.Speed";
+    std::vector<VSSSignal> out;
+    auto batch = [&](int i) {
+        clock->advance_by(std::chrono::milliseconds(10));
+        updates[0].value = 10.0 + i % 50;
+        updates[0].timestamp = clock->now();
+        out.clear();
+        processor.process_signal_updates(updates, out);
+    };
+
+    // Warm-up completes the 30 s and 60 s windows once (first outputs); the
+    // measurement crosses the 90 s boundary and stops before 120 s
+    for (int i = 0; i < 6500; ++i) {
+        batch(i);
+    }
+    vssdag::test::AllocScope scope;
+    for (int i = 6500; i < 11500; ++i) {
+        batch(i);
+    }
+    auto counts = scope.counts();
+
+    vssdag::test::report_allocs("windowed_batch", counts, 5000);
+    EXPECT_EQ(counts.allocations, 0u);
+    EXPECT_TRUE(processor.next_wakeup().has_value());
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "vssdag/signal_dag.h"
+#include "vssdag/symbol.h"
+
+using namespace vssdag;
+
+TEST(SymbolTest, InternsOncePerName) {
+    std::string name = "Vehicle.Speed";
+    Symbol a(name);
+    Symbol b("Vehicle.Speed");
+    Symbol c(std::string_view("Vehicle.Speed.Other").substr(0, 13));
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, c);
+    EXPECT_EQ(a.id(), b.id());
+    EXPECT_EQ(a.c_str(), b.c_str());  // Same storage
+    EXPECT_NE(a, Symbol("Vehicle.Gear"));
+
+    EXPECT_TRUE(a == "Vehicle.Speed");
+    EXPECT_TRUE(a == name);
+    EXPECT_EQ(Symbol().id(), 0u);
+    EXPECT_TRUE(Symbol().empty());
+
+    std::unordered_map<Symbol, int> values;
+    values[a] = 1;
+    EXPECT_EQ(values.at(b), 1);
+}
+
+TEST(SymbolTest, FindDoesNotIntern) {
+    size_t before = Symbol::count();
+    EXPECT_FALSE(Symbol::find("SymbolTest.NeverInterned").has_value());
+    EXPECT_EQ(Symbol::count(), before);
+
+    Symbol added("SymbolTest.Added");
+    EXPECT_EQ(Symbol::count(), before + 1);
+    ASSERT_TRUE(Symbol::find("SymbolTest.Added").has_value());
+    EXPECT_EQ(*Symbol::find("SymbolTest.Added"), added);
+    EXPECT_GT(Symbol::memory_bytes(), 0u);
+}
+
+TEST(SymbolTest, ConcurrentInterning) {
+    std::vector<std::vector<Symbol>> results(4);
+    std::vector<std::thread> threads;
+    for (auto& result : results) {
+        threads.emplace_back([&result] {
+            for (int i = 0; i < 1000; ++i) {
+                result.emplace_back("SymbolTest.Concurrent" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& result : results) {
+        EXPECT_EQ(result, results[0]);
+    }
+}
+
+TEST(SymbolTest, DAGLookupBySymbol) {
+    std::unordered_map<std::string, SignalMapping> mappings;
+    mappings["SymbolTest.Input"].source = {"dbc", "In"};
+    mappings["SymbolTest.Derived"].depends_on = {"SymbolTest.Input"};
+
+    SignalDAG dag;
+    ASSERT_TRUE(dag.build(mappings));
+    SignalNode* derived = dag.get_node(Symbol("SymbolTest.Derived"));
+    ASSERT_NE(derived, nullptr);
+    EXPECT_EQ(derived->symbol, "SymbolTest.Derived");
+    EXPECT_EQ(dag.get_node(derived->dependency_symbols[0]), dag.get_node("SymbolTest.Input"));
+    EXPECT_EQ(dag.get_node(Symbol("Vehicle.Speed")), nullptr);
+    EXPECT_EQ(dag.get_node(std::string("SymbolTest.Unknown")), nullptr);
+    EXPECT_FALSE(Symbol::find("SymbolTest.Unknown").has_value());
+}
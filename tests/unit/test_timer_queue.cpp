@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "vssdag/timer_queue.h"
+
+using namespace vssdag;
+
+namespace {
+
+using time_point = TimerQueue::time_point;
+
+time_point at_ms(int64_t ms) {
+    return time_point(std::chrono::milliseconds(ms));
+}
+
+// Nodes referencing one shared mapping, as the DAG's do
+class TimerQueueTest : public ::testing::Test {
+protected:
+    SignalNode* add_node(const std::string& name) {
+        names_.push_back(std::make_unique<std::string>(name));
+        nodes_.push_back(std::make_unique<SignalNode>(*names_.back(), mapping_));
+        return nodes_.back().get();
+    }
+
+    TimerQueue queue;
+
+private:
+    SignalMapping mapping_;
+    std::vector<std::unique_ptr<std::string>> names_;
+    std::vector<std::unique_ptr<SignalNode>> nodes_;
+};
+
+} // namespace
+
+TEST_F(TimerQueueTest, EarliestWakeupWinsAndFiresOnce) {
+    SignalNode* a = add_node("A");
+    SignalNode* b = add_node("B");
+    queue.schedule(a, at_ms(300));
+    queue.schedule(a, at_ms(100));  // Earlier request supersedes
+    queue.schedule(a, at_ms(200));  // Later request is ignored
+    queue.schedule(b, at_ms(150));
+    EXPECT_EQ(queue.next_deadline(), at_ms(100));
+
+    std::vector<SignalNode*> due;
+    queue.pop_due(at_ms(150), due);
+    EXPECT_EQ(due, (std::vector<SignalNode*>{a, b}));
+
+    due.clear();
+    queue.pop_due(at_ms(1000), due);  // The superseded 300 ms entry does not fire
+    EXPECT_TRUE(due.empty());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(TimerQueueTest, CancelDropsWakeup) {
+    SignalNode* a = add_node("A");
+    queue.schedule(a, at_ms(100));
+    queue.cancel(a);
+    EXPECT_FALSE(queue.next_deadline().has_value());
+
+    std::vector<SignalNode*> due;
+    queue.pop_due(at_ms(200), due);
+    EXPECT_TRUE(due.empty());
+}
+
+// Every evaluation cancels its node's wakeup and re-requests it (window
+// boundaries, wait() deadlines); the heap must not grow per batch
+TEST_F(TimerQueueTest, RearmingDoesNotGrowHeap) {
+    std::vector<SignalNode*> nodes = {add_node("Mean30"), add_node("Mean60"), add_node("Mean120")};
+    std::vector<int64_t> windows = {30000, 60000, 120000};
+
+    std::vector<SignalNode*> due;
+    size_t largest = 0;
+    for (int64_t now = 0; now < 5000 * 10; now += 10) {
+        due.clear();
+        queue.pop_due(at_ms(now), due);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            queue.cancel(nodes[i]);
+            queue.schedule(nodes[i], at_ms((now / windows[i] + 1) * windows[i]));
+        }
+        largest = std::max(largest, queue.size());
+    }
+    EXPECT_LE(largest, 2 * nodes.size());
+    EXPECT_EQ(queue.next_deadline(), at_ms(60000));
+}
+
+// Wakeups moving to a new time on every evaluation leave superseded
+// entries behind; compaction keeps them bounded
+TEST_F(TimerQueueTest, MovingWakeupsStayBounded) {
+    std::vector<SignalNode*> nodes = {add_node("A"), add_node("B"), add_node("C")};
+
+    std::vector<SignalNode*> due;
+    size_t largest = 0;
+    for (int64_t now = 0; now < 5000 * 10; now += 10) {
+        due.clear();
+        queue.pop_due(at_ms(now), due);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            queue.cancel(nodes[i]);
+            queue.schedule(nodes[i], at_ms(now + 1000 + static_cast<int64_t>(i)));
+        }
+        largest = std::max(largest, queue.size());
+    }
+    EXPECT_LE(largest, 2 * nodes.size() + 17);
+
+    due.clear();
+    queue.pop_due(at_ms(1000000), due);
+    EXPECT_EQ(due.size(), nodes.size());  // Each node fires once, at its latest time
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <lua.hpp>
+#include <memory>
+#include "vssdag/signal_processor.h"
+#include "vssdag/value_codec.h"
+
+using namespace vssdag;
+
+namespace {
+
+class ValueCodecTest : public ::testing::Test {
+protected:
+    void SetUp() override { L = luaL_newstate(); }
+    void TearDown() override { lua_close(L); }
+
+    // Value of a Lua expression pulled as type
+    Value pull(const char* expression, ValueType type) {
+        std::string chunk = std::string("return ") + expression;
+        EXPECT_EQ(luaL_dostring(L, chunk.c_str()), LUA_OK);
+        Value value = value_codec(type).pull_lua(L, -1);
+        lua_pop(L, 1);
+        EXPECT_EQ(lua_gettop(L), 0);
+        return value;
+    }
+
+    lua_State* L = nullptr;
+};
+
+std::shared_ptr<StructValue> make_location(double lat, double lon) {
+    auto location = std::make_shared<StructValue>("Location");
+    location->set_field("Latitude", lat);
+    location->set_field("Longitude", lon);
+    location->set_field("Satellites", std::vector<uint8_t>{3, 7});
+    return location;
+}
+
+} // namespace
+
+TEST_F(ValueCodecTest, CodecPerType) {
+    EXPECT_EQ(value_codec(ValueType::UINT8).type, ValueType::UINT8);
+    EXPECT_EQ(value_codec(ValueType::STRUCT_ARRAY).type, ValueType::STRUCT_ARRAY);
+    EXPECT_EQ(&value_codec(ValueType::FLOAT), &value_codec(ValueType::FLOAT));
+
+    EXPECT_EQ(value_codec_of(Value{}).type, ValueType::UNSPECIFIED);
+    EXPECT_EQ(value_codec_of(int16_t(3)).type, ValueType::INT16);
+    EXPECT_EQ(value_codec_of(std::vector<float>{}).type, ValueType::FLOAT_ARRAY);
+    EXPECT_EQ(value_codec_of(make_location(1, 2)).type, ValueType::STRUCT);
+}
+
+TEST_F(ValueCodecTest, PullsNumbersAsDeclaredType) {
+    EXPECT_EQ(std::get<uint8_t>(pull("200", ValueType::UINT8)), 200);
+    EXPECT_EQ(std::get<int16_t>(pull("-3", ValueType::INT16)), -3);
+    EXPECT_FLOAT_EQ(std::get<float>(pull("1.5", ValueType::FLOAT)), 1.5f);
+    EXPECT_DOUBLE_EQ(std::get<double>(pull("2", ValueType::DOUBLE)), 2.0);
+    EXPECT_TRUE(std::get<bool>(pull("1", ValueType::BOOL)));
+    EXPECT_FALSE(std::get<bool>(pull("0", ValueType::BOOL)));
+    EXPECT_DOUBLE_EQ(std::get<double>(pull("4.25", ValueType::UNSPECIFIED)), 4.25);
+
+    // Other Lua types keep their own type
+    EXPECT_TRUE(std::get<bool>(pull("true", ValueType::DOUBLE)));
+    EXPECT_EQ(std::get<std::string>(pull("'PARK'", ValueType::UINT8)), "PARK");
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(pull("nil", ValueType::INT32)));
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(pull("{1, 2}", ValueType::INT32)));
+}
+
+TEST_F(ValueCodecTest, PullsTables) {
+    auto doubles = std::get<std::vector<double>>(pull("{1, 2.5, 'x'}", ValueType::DOUBLE_ARRAY));
+    EXPECT_EQ(doubles, (std::vector<double>{1.0, 2.5, 0.0}));
+
+    auto flags = std::get<std::vector<bool>>(pull("{true, false, 1}", ValueType::BOOL_ARRAY));
+    EXPECT_EQ(flags, (std::vector<bool>{true, false, true}));
+
+    auto names = std::get<std::vector<std::string>>(pull("{'a', 'b'}", ValueType::STRING_ARRAY));
+    EXPECT_EQ(names, (std::vector<std::string>{"a", "b"}));
+
+    auto location = std::get<std::shared_ptr<StructValue>>(
+        pull("{Latitude = 52.5, Longitude = 13.4}", ValueType::STRUCT));
+    ASSERT_NE(location->get_field("Latitude"), nullptr);
+    EXPECT_DOUBLE_EQ(std::get<double>(*location->get_field("Latitude")), 52.5);
+}
+
+TEST_F(ValueCodecTest, PushRoundTrips) {
+    std::vector<Value> values = {
+        Value{}, true, int8_t(-5), uint16_t(40000), int64_t(1) << 40, 0.25f, 3.5,
+        std::string("a\0b", 3), std::vector<int32_t>{1, -2}, std::vector<bool>{true, false},
+        std::vector<std::string>{"x", "y"}, std::vector<double>{0.5, 1.5},
+    };
+    for (const auto& value : values) {
+        const ValueCodec& codec = value_codec_of(value);
+        codec.push_lua(L, value);
+        Value back = codec.pull_lua(L, -1);
+        lua_pop(L, 1);
+        EXPECT_TRUE(values_equal(value, back)) << value_to_json(value) << " vs " << value_to_json(back);
+    }
+
+    // Structs become tables keyed by field name
+    value_codec(ValueType::STRUCT).push_lua(L, make_location(1.5, 2.5));
+    lua_getfield(L, -1, "Satellites");
+    lua_rawgeti(L, -1, 2);
+    EXPECT_EQ(lua_tointeger(L, -1), 7);
+    lua_pop(L, 3);
+
+    // A codec handed another alternative pushes that alternative
+    value_codec(ValueType::DOUBLE).push_lua(L, std::string("text"));
+    EXPECT_STREQ(lua_tostring(L, -1), "text");
+    lua_pop(L, 1);
+    EXPECT_EQ(lua_gettop(L), 0);
+}
+
+TEST_F(ValueCodecTest, Json) {
+    EXPECT_EQ(value_to_json(Value{}), "null");
+    EXPECT_EQ(value_to_json(int8_t(-7)), "-7");
+    EXPECT_EQ(value_to_json(uint8_t(200)), "200");
+    EXPECT_EQ(value_to_json(2.50), "2.5");
+    EXPECT_EQ(value_to_json(1e-9), "0");
+    EXPECT_EQ(value_to_json(std::string("say \"hi\"\n")), "\"say \\\"hi\\\"\\n\"");
+    EXPECT_EQ(value_to_json(std::vector<int16_t>{1, -1}), "[1,-1]");
+    EXPECT_EQ(value_to_json(std::vector<double>{1.5}), "[1.500000]");
+    EXPECT_EQ(value_to_json(make_location(1.5, 2)),
+              "{\"Latitude\":1.5,\"Longitude\":2,\"Satellites\":[3,7]}");
+}
+
+TEST_F(ValueCodecTest, BinaryRoundTrips) {
+    std::vector<Value> values = {
+        Value{}, false, uint64_t(1) << 63, -1.25f, std::string("gear"),
+        std::vector<uint8_t>{1, 2, 3}, std::vector<bool>{false, true},
+        make_location(48.1, 11.6),
+        std::vector<std::shared_ptr<StructValue>>{make_location(1, 2), nullptr},
+    };
+    BinaryWriter out;
+    for (const auto& value : values) {
+        write_value(out, value);
+    }
+
+    BinaryReader in(out.data().data(), out.data().size());
+    for (const auto& value : values) {
+        Value back = read_value(in);
+        EXPECT_TRUE(values_equal(value, back)) << value_to_json(value);
+    }
+    EXPECT_TRUE(in.ok());
+    EXPECT_EQ(in.remaining(), 0u);
+
+    // Truncated and unknown tags fail instead of reading garbage
+    BinaryReader truncated(out.data().data(), out.data().size() - 1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        read_value(truncated);
+    }
+    EXPECT_FALSE(truncated.ok());
+
+    const char unknown[] = {static_cast<char>(0xff), 0, 0};
+    BinaryReader bad(unknown, sizeof(unknown));
+    read_value(bad);
+    EXPECT_FALSE(bad.ok());
+}
+
+TEST_F(ValueCodecTest, BinaryReaderRejectsShortArrays) {
+    BinaryWriter out;
+    out.put(std::vector<double>{1.0, 2.0, 3.0});
+
+    BinaryReader whole(out.data().data(), out.data().size());
+    EXPECT_EQ(whole.get_doubles(), (std::vector<double>{1.0, 2.0, 3.0}));
+    EXPECT_TRUE(whole.ok());
+
+    // A count larger than the data left fails instead of returning fewer values
+    BinaryReader truncated(out.data().data(), out.data().size() - sizeof(double));
+    EXPECT_TRUE(truncated.get_doubles().empty());
+    EXPECT_FALSE(truncated.ok());
+}
+
+TEST_F(ValueCodecTest, Equality) {
+    EXPECT_TRUE(values_equal(Value{}, Value{}));
+    EXPECT_TRUE(values_equal(int32_t(3), int32_t(3)));
+    EXPECT_FALSE(values_equal(int32_t(3), int64_t(3)));  // Alternatives differ
+    EXPECT_FALSE(values_equal(1.0, 1.5));
+    EXPECT_TRUE(values_equal(make_location(1, 2), make_location(1, 2)));  // By content
+    EXPECT_FALSE(values_equal(make_location(1, 2), make_location(1, 3)));
+    EXPECT_TRUE(value_codec(ValueType::STRING).equal(2.0, 2.0));
+}
+
+TEST(ValueCodecProcessorTest, NodeCodecSetsOutputType) {
+    std::unordered_map<std::string, SignalMapping> mappings;
+    SignalMapping gear;
+    gear.source.type = "dbc";
+    gear.source.name = "Gear";
+    gear.datatype = ValueType::UINT8;
+    mappings["Vehicle.Gear"] = gear;
+
+    SignalMapping flags;
+    flags.depends_on = {"Vehicle.Gear"};
+    flags.datatype = ValueType::BOOL_ARRAY;
+    flags.transform = CodeTransform{"local g = deps['Vehicle.Gear']\nreturn {g > 2, g > 5}"};
+    mappings["Vehicle.GearFlags"] = flags;
+
+    SignalProcessorDAG processor;
+    ASSERT_TRUE(processor.initialize(mappings));
+    SignalUpdate update;
+    update.signal_name = "Vehicle.Gear";
+    update.value = 4.0;
+    update.timestamp = std::chrono::steady_clock::now();
+    auto signals = processor.process_signal_updates({update});
+
+    bool saw_gear = false, saw_flags = false;
+    for (const auto& signal : signals) {
+        if (signal.path == "Vehicle.Gear") {
+            saw_gear = true;
+            EXPECT_EQ(std::get<uint8_t>(signal.qualified_value.value), 4);
+        } else if (signal.path == "Vehicle.GearFlags") {
+            saw_flags = true;
+            EXPECT_EQ(std::get<std::vector<bool>>(signal.qualified_value.value),
+                      (std::vector<bool>{true, false}));
+        }
+    }
+    EXPECT_TRUE(saw_gear);
+    EXPECT_TRUE(saw_flags);
+}
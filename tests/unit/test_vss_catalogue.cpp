@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "vssdag/vss_catalogue.h"
+#include "vssdag/vss_struct_mapper.h"
+
+using namespace vssdag;
+
+namespace {
+
+const char* kSpec = R"(
+Vehicle:
+  type: branch
+  description: High-level vehicle data
+Vehicle.Speed:
+  type: sensor
+  datatype: float
+  unit: km/h
+Vehicle.Types.Location:
+  type: struct
+  description: Position
+Vehicle.Types.Location.Latitude:
+  type: property
+  datatype: double
+  min: -90
+  max: 90
+Vehicle.Types.Location.Valid:
+  type: property
+  datatype: boolean
+  default: true
+Vehicle.Types.Location.Source:
+  type: struct
+  description: Nested struct, its properties do not belong to Location
+Vehicle.Types.Location.Source.Name:
+  type: property
+  datatype: string
+  default: gps
+Vehicle.Types.Empty:
+  type: struct
+)";
+
+std::string temp_path(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+} // namespace
+
+TEST(VSSCatalogueTest, IndexesFlattenedSpec) {
+    VSSCatalogue catalogue;
+    ASSERT_TRUE(catalogue.parse_yaml(kSpec));
+
+    // "Vehicle.Types" is only implied by its children
+    const VSSNode* types = catalogue.find("Vehicle.Types");
+    ASSERT_NE(types, nullptr);
+    EXPECT_TRUE(types->implicit);
+    EXPECT_EQ(types->type, VSSNodeType::BRANCH);
+    EXPECT_EQ(types->children.size(), 2u);
+    EXPECT_EQ(catalogue.nodes()[types->parent].path, "Vehicle");
+
+    const VSSNode* speed = catalogue.find("Vehicle.Speed");
+    ASSERT_NE(speed, nullptr);
+    EXPECT_EQ(speed->type, VSSNodeType::SENSOR);
+    EXPECT_EQ(speed->unit, "km/h");
+    EXPECT_EQ(catalogue.find("Vehicle.Spe"), nullptr);
+
+    auto [first, last] = catalogue.descendants("Vehicle.Types.Location");
+    EXPECT_EQ(last - first, 4u);
+    for (size_t i = first; i < last; ++i) {
+        EXPECT_EQ(catalogue.nodes()[i].path.rfind("Vehicle.Types.Location.", 0), 0u);
+    }
+
+    auto structs = catalogue.struct_types();
+    ASSERT_EQ(structs.size(), 2u);  // Empty is skipped
+    const StructType& location = structs[0];
+    EXPECT_EQ(location.type_path, "Vehicle.Types.Location");
+    ASSERT_EQ(location.properties.size(), 2u);
+    ASSERT_NE(location.get_property("Latitude"), nullptr);
+    EXPECT_EQ(location.get_property("Latitude")->min, -90.0);
+    EXPECT_EQ(location.get_property("Name"), nullptr);
+    EXPECT_EQ(std::get<bool>(*location.get_property("Valid")->default_value), true);
+    EXPECT_EQ(structs[1].type_path, "Vehicle.Types.Location.Source");
+}
+
+TEST(VSSCatalogueTest, ParsesNestedSpec) {
+    VSSCatalogue catalogue;
+    ASSERT_TRUE(catalogue.parse_yaml(R"(
+Vehicle:
+  type: branch
+  children:
+    Position:
+      type: struct
+      children:
+        X: {type: property, datatype: float}
+        Y: {type: property, datatype: float}
+    Odometer: {type: sensor, datatype: float}
+)"));
+    EXPECT_EQ(catalogue.nodes().size(), 5u);
+    ASSERT_NE(catalogue.find("Vehicle.Position.Y"), nullptr);
+    auto structs = catalogue.struct_types();
+    ASSERT_EQ(structs.size(), 1u);
+    EXPECT_EQ(structs[0].properties.size(), 2u);
+}
+
+TEST(VSSCatalogueTest, RejectsInvalidSpec) {
+    VSSCatalogue catalogue;
+    EXPECT_FALSE(catalogue.parse_yaml("A: {type: signal}"));
+    EXPECT_FALSE(catalogue.parse_yaml(R"(
+A: {type: branch, children: {B: {type: sensor}}}
+A.B: {type: sensor}
+)"));
+    EXPECT_FALSE(catalogue.parse_yaml("- not a map"));
+    EXPECT_TRUE(catalogue.nodes().empty());  // Left untouched on failure
+}
+
+TEST(VSSCatalogueTest, BinaryRoundTrip) {
+    VSSCatalogue catalogue;
+    ASSERT_TRUE(catalogue.parse_yaml(kSpec));
+    std::string path = temp_path("types.vsscat");
+    ASSERT_TRUE(catalogue.save(path));
+    EXPECT_TRUE(VSSCatalogue::is_catalogue_file(path));
+
+    VSSCatalogue loaded;
+    ASSERT_TRUE(loaded.load(path));
+    ASSERT_EQ(loaded.nodes().size(), catalogue.nodes().size());
+    for (size_t i = 0; i < loaded.nodes().size(); ++i) {
+        EXPECT_EQ(loaded.nodes()[i].path, catalogue.nodes()[i].path);
+        EXPECT_EQ(loaded.nodes()[i].children, catalogue.nodes()[i].children);
+    }
+    const VSSNode* name = loaded.find("Vehicle.Types.Location.Source.Name");
+    ASSERT_NE(name, nullptr);
+    EXPECT_EQ(std::get<std::string>(*name->default_value), "gps");
+    EXPECT_TRUE(loaded.find("Vehicle.Types")->implicit);
+
+    // The struct mapper accepts the binary form as a spec file
+    VSSStructMapper mapper;
+    ASSERT_TRUE(mapper.load_struct_types(path));
+    ASSERT_NE(mapper.get_struct_type("Vehicle.Types.Location"), nullptr);
+
+    // Truncated catalogues are rejected
+    std::ifstream in(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(), data.size() - 3);
+    VSSCatalogue truncated;
+    EXPECT_FALSE(truncated.load(path));
+    std::remove(path.c_str());
+}
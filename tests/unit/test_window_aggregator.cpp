@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "vssdag/window_aggregator.h"
+
+using namespace vssdag;
+using namespace std::chrono_literals;
+
+class WindowAggregatorTest : public ::testing::Test {
+protected:
+    std::chrono::steady_clock::time_point t0{std::chrono::seconds(1000)};
+};
+
+// Test ring buffer wrap-around and growth
+TEST_F(WindowAggregatorTest, RingBufferWrapsAndGrows) {
+    RingBuffer<int> ring;
+    for (int i = 0; i < 6; ++i) ring.push_back(i);
+    for (int i = 0; i < 4; ++i) ring.pop_front();
+    for (int i = 6; i < 20; ++i) ring.push_back(i);  // Wraps, then grows
+
+    EXPECT_EQ(ring.size(), 16);
+    EXPECT_EQ(ring.front(), 4);
+    EXPECT_EQ(ring.back(), 19);
+    ring.pop_back();
+    EXPECT_EQ(ring.back(), 18);
+}
+
+// Test count-based sliding window min/max/mean
+TEST_F(WindowAggregatorTest, SlidingWindowByCount) {
+    SlidingWindow window(size_t{3});
+    EXPECT_FALSE(window.stats().has_value());
+
+    const double values[] = {5, 1, 4, 7, 2};
+    for (size_t i = 0; i < 5; ++i) {
+        window.push(t0 + i * 10ms, values[i]);
+    }
+
+    // Window holds {4, 7, 2}
+    auto stats = window.stats();
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->count, 3);
+    EXPECT_DOUBLE_EQ(stats->min, 2);
+    EXPECT_DOUBLE_EQ(stats->max, 7);
+    EXPECT_DOUBLE_EQ(stats->mean(), 13.0 / 3);
+    EXPECT_DOUBLE_EQ(stats->last, 2);
+}
+
+// Test time-based sliding window expiry
+TEST_F(WindowAggregatorTest, SlidingWindowByTime) {
+    SlidingWindow window(1000ms);
+    window.push(t0, 10);
+    window.push(t0 + 400ms, 1);
+    window.push(t0 + 800ms, 5);
+
+    EXPECT_DOUBLE_EQ(window.stats()->max, 10);
+
+    // The sample at t0 leaves the window
+    window.expire(t0 + 1000ms);
+    EXPECT_EQ(window.stats()->count, 2);
+    EXPECT_DOUBLE_EQ(window.stats()->max, 5);
+    EXPECT_DOUBLE_EQ(window.stats()->min, 1);
+
+    window.expire(t0 + 5000ms);
+    EXPECT_FALSE(window.stats().has_value());
+}
+
+// Test time-based tumbling windows close on aligned boundaries
+TEST_F(WindowAggregatorTest, TumblingWindowByTime) {
+    TumblingWindow window(1000ms);
+    EXPECT_FALSE(window.next_boundary().has_value());
+
+    EXPECT_FALSE(window.push(t0 + 100ms, 3));
+    EXPECT_FALSE(window.push(t0 + 600ms, 9));
+    EXPECT_EQ(window.next_boundary(), t0 + 1000ms);
+    EXPECT_FALSE(window.completed().has_value());
+
+    EXPECT_TRUE(window.advance(t0 + 1000ms));
+    ASSERT_TRUE(window.completed().has_value());
+    EXPECT_DOUBLE_EQ(window.completed()->mean(), 6);
+    EXPECT_DOUBLE_EQ(window.completed()->max, 9);
+
+    // An empty window closes as no data, then the window stops ticking
+    EXPECT_TRUE(window.advance(t0 + 2000ms));
+    EXPECT_FALSE(window.completed().has_value());
+    EXPECT_FALSE(window.next_boundary().has_value());
+}
+
+// Test count-based tumbling windows
+TEST_F(WindowAggregatorTest, TumblingWindowByCount) {
+    TumblingWindow window(size_t{2});
+    EXPECT_FALSE(window.push(t0, 1));
+    EXPECT_TRUE(window.push(t0 + 1ms, 3));
+    EXPECT_DOUBLE_EQ(window.completed()->mean(), 2);
+    EXPECT_FALSE(window.push(t0 + 2ms, 8));
+    EXPECT_DOUBLE_EQ(window.completed()->mean(), 2);
+}
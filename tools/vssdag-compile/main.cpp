@@ -0,0 +1,85 @@
+#include <glog/logging.h>
+#include <iostream>
+#include <unordered_set>
+#include "vssdag/can/dbc_parser.h"
+#include "vssdag/mapping_loader.h"
+#include "vssdag/signal_processor.h"
+
+namespace {
+
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " <mapping_yaml_file> <dbc_file> <output_file>\n";
+    std::cout << "Example: " << program_name << " mappings.yaml vehicle.dbc mappings.vssdagc\n";
+}
+
+// Resolve DBC sources to the CAN messages they are decoded from and
+// collect their enum tables
+bool plan_sources(const std::string& dbc_file, const vssdag::MappingConfig& config,
+                  vssdag::CompiledPlan& plan) {
+    vssdag::DBCParser parser(dbc_file);
+    if (!parser.parse()) {
+        LOG(ERROR) << "Failed to parse DBC file: " << dbc_file;
+        return false;
+    }
+    bool ok = true;
+    std::unordered_set<std::string> planned;
+    for (const auto& [name, mapping] : config.mappings) {
+        if (mapping.source.type != "dbc") {
+            continue;
+        }
+        auto message_id = parser.get_message_id_for_signal(mapping.source.name);
+        if (!message_id) {
+            LOG(ERROR) << "Signal " << name << " uses DBC signal " << mapping.source.name
+                       << ", which is not in " << dbc_file;
+            ok = false;
+            continue;
+        }
+        if (planned.insert(mapping.source.name).second) {
+            plan.decode_plan[*message_id].push_back(mapping.source.name);
+        }
+        auto enums = parser.get_signal_enums(mapping.source.name);
+        if (!enums.empty()) {
+            plan.enum_tables[name] = std::move(enums);
+        }
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    using namespace vssdag;
+    google::InitGoogleLogging(argv[0]);
+    FLAGS_logtostderr = true;
+
+    if (argc != 4) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const std::string yaml_file = argv[1];
+    const std::string dbc_file = argv[2];
+    const std::string output_file = argv[3];
+
+    MappingConfig config;
+    if (!load_mapping_file(yaml_file, config)) {
+        return 1;
+    }
+
+    // Building the processor checks the DAG and compiles every transform
+    CompiledPlan plan;
+    SignalProcessorDAG processor;
+    if (!processor.compile_plan(config.mappings, plan)) {
+        LOG(ERROR) << "Mappings do not form a valid DAG or a transform does not compile";
+        return 1;
+    }
+    if (!plan_sources(dbc_file, config, plan)) {
+        return 1;
+    }
+    config.plan = std::move(plan);
+
+    if (!save_compiled_mappings(config, output_file)) {
+        return 1;
+    }
+    LOG(INFO) << "Compiled " << config.mappings.size() << " mappings to " << output_file;
+    return 0;
+}